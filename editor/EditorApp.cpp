@@ -3647,7 +3647,12 @@ void EditorApp::startRender()
                 m_previewDirty.store(true);
             };
 
-            RenderResult result = Renderer::renderFrame(scene, progress, preview);
+            if (!m_renderContext)
+            {
+                m_renderContext = std::make_shared<RenderContext>();
+            }
+            RenderResult result =
+                Renderer::renderFrame(scene, progress, preview, nullptr, m_renderContext.get());
 
             // If superseded while running, discard this result (the next render —
             // or the dismissed live viewport — owns the screen now).
@@ -23,6 +23,7 @@
 struct GLFWwindow;
 class AutomationServer;
 struct LoadedScene;  // renderer-side scene (SceneLoader.h), used for accurate picking
+struct RenderContext;  // renderer-side allocations kept across viewport renders (Renderer.h)
 
 // Top-level editor application. Owns the GLFW window + GL context, the ImGui
 // context, the raster viewport (offscreen FBO + mesh + orbit camera), and the
@@ -627,6 +628,10 @@ private:
 
     // Phase 3: render-to-image state.
     std::thread m_renderThread;
+    // The viewport renders' photon queue, bounce store and splat buffer, kept from
+    // one render to the next (Renderer.h). Only the render thread touches it, and
+    // one render thread runs at a time (the last is joined before the next starts).
+    std::shared_ptr<RenderContext> m_renderContext;
     std::atomic<RenderState> m_renderState{RenderState::Idle};
     std::atomic<bool> m_renderTextureDirty{false};
     std::string m_renderError;
@@ -6,10 +6,21 @@
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <filesystem>
 #include <limits>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
+// Spill mode maps its scratch file with POSIX mkstemp/mmap/madvise. Elsewhere
+// (the Windows build) the store is in-memory only, and the spill constructor
+// throws rather than silently ignoring $bounceStoreResidentMiB.
+#if defined(__unix__) || defined(__APPLE__)
+#  define RAY_TRACER_HAS_BOUNCE_SPILL 1
+#else
+#  define RAY_TRACER_HAS_BOUNCE_SPILL 0
+#endif
+
 // Phase 2a probe-guided gather: the RAW BOUNCE STORE.
 //
 // During the photon pass, every non-delta bounce that survives the probe
@@ -26,11 +37,16 @@
 // (extension depth 0) and reflected/refracted diffuse (extension depth > 0) at
 // identical fidelity, retiring the separate splat + density-grid mechanisms.
 //
-// Append: a single preallocated buffer plus one atomic write cursor. append()
-// does a relaxed fetch_add to claim a slot; within capacity it writes the record
-// lock-free, past capacity it drops and bumps an overflow counter. The buffer is
-// never reallocated, so reader access (the grid build + the gather) is valid once
-// the photon pass drains.
+// Append: a SEGMENTED buffer plus one atomic write cursor. append() does a
+// relaxed fetch_add to claim a slot; within capacity it writes the record
+// lock-free, past capacity it drops and bumps an overflow counter. Storage is a
+// fixed table of lazily-committed segments (kSegmentRecords records each): the
+// first writer to land in an uncommitted segment allocates it and publishes it
+// with a CAS, a loser frees its copy and uses the winner's. So resident memory
+// tracks the deposits actually made, and `capacity` is a MEMORY CEILING (at most
+// capacity * sizeof(RawBounce) bytes), not an up-front reservation. Segments are
+// never moved or reallocated, so reader access (the grid build + the gather) is
+// valid once the photon pass drains.
 // Compact deposit record (52 B). `position`/`incoming`/`normal` are stored as 3
 // floats each rather than `Vector` (32 B, AVX-padded) because the store holds
 // MILLIONS of these and the gather only needs single-precision positions for the
@@ -115,10 +131,41 @@ struct RawBounce
 class BounceStore
 {
 public:
-    // Construct with a fixed slot capacity. The whole buffer is allocated up
-    // front (default-constructed; records are overwritten on append).
+    // Records per lazily-committed segment (64 Ki records, ~3.3 MiB). A power of
+    // two so slot -> (segment, offset) is a shift and a mask.
+    static constexpr std::size_t kSegmentShift = 16;
+    static constexpr std::size_t kSegmentRecords = std::size_t{1} << kSegmentShift;
+
+    // Construct with a slot capacity (the ceiling). Only the segment TABLE is
+    // allocated here; record storage is committed segment-by-segment on append.
     explicit BounceStore(std::size_t capacity);
 
+    // OUT-OF-CORE (spill) mode. At most `residentBytes` of records live in RAM
+    // (rounded down to whole segments, at least one); every segment past that
+    // budget is committed in an unlinked, memory-mapped scratch file created in
+    // `spillDirectory`. The photon pass writes spilled segments straight through
+    // the mapping, and when one SEALS (its last slot is written) its pages are
+    // released from the process so the kernel can write them back and evict them.
+    // The index build and the gather then read them back through the page cache.
+    // `capacity` is still the record ceiling; with a spill file behind it, it can
+    // be set far above RAM. Throws std::runtime_error if the scratch file cannot
+    // be created or mapped.
+    BounceStore(std::size_t capacity, std::size_t residentBytes,
+                const std::filesystem::path& spillDirectory);
+    ~BounceStore();
+
+    BounceStore(const BounceStore&) = delete;
+    BounceStore& operator=(const BounceStore&) = delete;
+
+    // Empty the store for another photon pass, keeping its committed resident
+    // segments: the next pass writes into pages already faulted in instead of
+    // committing fresh ones. The index and the counters start over. memoryBytes()
+    // still counts the kept segments. A spill store cannot be reset — its build
+    // swapped the scratch file out from under the segment table — and throws
+    // std::runtime_error; open a new one instead. Only call it while nothing else
+    // reads or appends to the store.
+    void reset();
+
     // Lock-free append. Claims the next slot via an atomic fetch-add. Returns
     // true if stored, false if the budget was exhausted (record discarded,
     // overflow counter bumped). Safe to call concurrently from worker threads.
@@ -147,22 +194,102 @@ public:
         return attempts > m_capacity ? attempts - m_capacity : 0;
     }
 
+    // Bytes of RESIDENT record storage actually committed (heap segments touched
+    // by an append), plus the segment table. Tracks the deposit count, not the
+    // capacity. Spilled segments are reported by spilledBytes() instead.
     std::size_t memoryBytes() const noexcept;
 
-    const RawBounce& operator[](std::size_t index) const noexcept { return m_records[index]; }
+    // Number of resident segments committed so far (diagnostics / tests).
+    std::size_t committedSegments() const noexcept { return m_committedSegments.load(); }
+
+    // Spill mode: whether a scratch file backs the tail of the store, how many
+    // of its segments have been written to, and their size in bytes.
+    bool spillEnabled() const noexcept { return m_spillBase != nullptr; }
+    std::size_t spilledSegments() const noexcept { return m_spilledSegments.load(); }
+    std::size_t spilledBytes() const noexcept;
+
+    // Read only after the photon pass drains (index < size()).
+    const RawBounce& operator[](std::size_t index) const noexcept
+    {
+        return m_segments[index >> kSegmentShift].load(std::memory_order_relaxed)
+            [index & (kSegmentRecords - 1)];
+    }
 
     // ===== Spatial index (built post-pass, single-threaded) =====
     //
     // Build a uniform grid over the populated prefix [0, size()) using cubic
     // cells of edge `cellSize`. Must be called after the photon pass drains and
     // before any gather query.
-    void buildIndex(double cellSize);
+    //
+    // The build REORDERS the records into cell order (cells in z/y/x order), so
+    // each cell is one contiguous run of slots and adjacent-x cells are adjacent
+    // runs. A radius search then reads a few sequential runs instead of
+    // scattering across the whole store — which is what keeps gather I/O mostly
+    // sequential when the store is spilled, and cache-friendly when it is not.
+    // A resident store is permuted in place (a bucket permutation, no per-record
+    // scratch). A spilled store is instead read once in slot order and written
+    // once as a bucketed copy into a fresh scratch file that replaces it, so the
+    // build never rewrites released pages of the old file. Indices handed out
+    // before the build are not stable across it.
+    //
+    // With `timeSlices` > 1 each cell's run is further ordered by DEPOSIT TIME:
+    // timeless deposits first, then `timeSlices` equal slices of the stored
+    // deposits' time span. A time-windowed radiusSearch then skips the slices
+    // outside its window and takes the slices inside it without a per-record
+    // time test. The slice ends cost 4 B per (cell, slice). 1 (the default) or a
+    // store whose deposits all share one time = one run per cell, as before.
+    void buildIndex(double cellSize, std::size_t timeSlices = 1);
 
     // Indices into the store of all bounces within radius r of p. Exactly the
     // records with |record.position - p| <= r. Requires buildIndex() first.
     std::vector<std::size_t> radiusSearch(const Vector& p, double r) const;
 
+    // The same search restricted to the gather's temporal window: exactly the
+    // records within r of p whose time is kTimelessDeposit or within
+    // `timeHalfWindow` of `time` (|record.time - time| <= timeHalfWindow).
+    std::vector<std::size_t> radiusSearch(const Vector& p,
+                                          double r,
+                                          float time,
+                                          float timeHalfWindow) const;
+
     double cellSize() const noexcept { return m_cellSize; }
+    // Time bins per cell of the current index (1 + slices when time-sliced).
+    std::size_t timeBins() const noexcept { return m_timeBins; }
+
+    // ===== Deposit merging (optional, post-index) =====
+    //
+    // When deposits are merged, each index bucket (cell, time bin) is split into
+    // sub-cells of edge `cellSize`. Within a sub-cell, a deposit joins the first
+    // cluster whose SEED (first deposit) it matches: its normal and its incoming
+    // direction must lie within the given cosines of the seed's, and its time within
+    // `timeTolerance` of the seed's. Timeless deposits only join timeless clusters.
+    // A cluster becomes ONE deposit that carries the summed power. Its position,
+    // directions and time are the power-weighted means of its members' values.
+    struct MergeTolerance
+    {
+        double cellSize = 0.0;
+        double normalCos = 0.95;
+        double directionCos = 0.9;
+        float timeTolerance = 0.0f;
+    };
+
+    struct MergeResult
+    {
+        std::size_t before = 0;  // deposits before the merge
+        std::size_t after = 0;   // representatives written
+        double ratio() const noexcept
+        {
+            return after > 0 ? static_cast<double>(before) / static_cast<double>(after) : 1.0;
+        }
+    };
+
+    // Merge the stored deposits in place. The index stays valid: each bucket is
+    // merged within itself and the representatives are compacted bucket by bucket.
+    // Resident segments left wholly unused are freed. Total power is conserved. The
+    // bias is a shift of each member's position by at most the sub-cell diagonal,
+    // and of its directions by the cosine tolerances. Requires buildIndex() first,
+    // and no append() afterwards. A cellSize <= 0 merges nothing.
+    MergeResult mergeDeposits(const MergeTolerance& tolerance);
 
 private:
     struct CellKey
@@ -175,6 +302,29 @@ private:
         {
             return x == other.x && y == other.y && z == other.z;
         }
+
+        // z-major order: cells along a row of x are consecutive.
+        bool operator<(const CellKey& other) const noexcept
+        {
+            if (z != other.z)
+            {
+                return z < other.z;
+            }
+            if (y != other.y)
+            {
+                return y < other.y;
+            }
+            return x < other.x;
+        }
+    };
+
+    // A cell's contiguous run of slots after the cell-order reorder. Its time
+    // bins are buckets [bucket, bucket + m_timeBins) of the bucket arrays.
+    struct CellRange
+    {
+        std::size_t begin = 0;
+        std::size_t count = 0;
+        std::size_t bucket = 0;
     };
 
     struct CellKeyHash
@@ -189,12 +339,54 @@ private:
     };
 
     CellKey cellOf(const Vector& p) const noexcept;
+    // Time bin of a deposit: 0 for a timeless one, else 1 + its time slice (always
+    // 0 when the index is not time-sliced).
+    std::size_t timeBinOf(float time) const noexcept;
+    // Bucket (cell, time bin) a record belongs to in the current index.
+    std::size_t bucketOf(const RawBounce& record) const;
+
+    // Records in segment `segment` (the last one is trimmed to the capacity).
+    std::size_t segmentLength(std::size_t segment) const noexcept;
+    // Return segment `segment`, committing it if this is the first write into it.
+    RawBounce* commitSegment(std::size_t segment) noexcept;
+    RawBounce& mutableAt(std::size_t index) noexcept
+    {
+        return m_segments[index >> kSegmentShift].load(std::memory_order_relaxed)
+            [index & (kSegmentRecords - 1)];
+    }
+    // Spill mode: count one write into spilled segment `segment`; the write that
+    // fills it releases its pages from the process.
+    void noteSpilledWrite(std::size_t segment) noexcept;
+    // Spill mode half of buildIndex: copy the populated prefix into a fresh
+    // scratch file in bucket order (`cursor` holds each bucket's next slot) and
+    // swap it in for the resident segments and the old file.
+    void reorderSpilled(std::size_t count, std::vector<std::size_t>& cursor);
 
-    std::vector<RawBounce> m_records;
+    std::unique_ptr<std::atomic<RawBounce*>[]> m_segments;
+    std::size_t m_segmentCount;
+    std::atomic<std::size_t> m_committedSegments{0};
     std::atomic<std::size_t> m_writeCursor{0};
     std::size_t m_capacity;
+    std::size_t m_mergedAway = 0;  // stored deposits folded into others by a merge
+
+    // Spill mode: segments [m_residentSegments, m_segmentCount) live in the
+    // mapping at m_spillBase; m_spillFill counts writes per spilled segment.
+    std::size_t m_residentSegments;
+    std::filesystem::path m_spillDirectory;
+    RawBounce* m_spillBase = nullptr;
+    std::size_t m_spillMappedBytes = 0;
+    std::unique_ptr<std::atomic<std::size_t>[]> m_spillFill;
+    std::atomic<std::size_t> m_spilledSegments{0};
 
     double m_cellSize = 1.0;
     double m_invCellSize = 1.0;
-    std::unordered_map<CellKey, std::vector<std::size_t>, CellKeyHash> m_cells;
+    std::unordered_map<CellKey, CellRange, CellKeyHash> m_cells;
+
+    // Time slicing: the stored deposits' finite time span, its slice count, and
+    // each bucket's end offset within its cell's run (empty when m_timeBins == 1).
+    std::size_t m_timeBins = 1;
+    float m_timeMin = 0.0f;
+    double m_sliceScale = 0.0;  // slices per unit time
+    double m_sliceWidth = 0.0;  // time per slice
+    std::vector<std::uint32_t> m_bucketEnd;
 };
@@ -32,12 +32,12 @@ public:
     void addColor(PixelCoords coords, const Color& color);
     Color fetchColor(PixelCoords coords) const;
 
+    size_t width() const noexcept { return m_width; }
+    size_t height() const noexcept { return m_height; }
+
 private:
     const size_t m_width;
-    // Retained as part of the buffer's logical dimensions; bounds checks use
-    // m_count (= width*height*3). Marked maybe_unused to keep the dimension
-    // documented without tripping -Wunused-private-field.
-    [[maybe_unused]] const size_t m_height;
+    const size_t m_height;
     const size_t m_count;
     std::unique_ptr<std::atomic<float>[]> m_buffer;
 };
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Buffer.h"
+#include "RenderSettings.h"
+
+#include <filesystem>
+
+// Float output of a pre-tonemap radiance Buffer as an OpenEXR scanline image.
+//
+// The PNG is the buffer after tonemapBufferToImage — exposed, gamma-encoded and
+// clipped to 16 bits — so changing the exposure or compositing a frame meant
+// rendering it again. The EXR keeps the buffer's linear radiance (the same values
+// the tests assert on), so the exposure can change in post instead.
+//
+// The writer reads the Buffer directly, one scanline block at a time, in the
+// PNG's orientation (tonemapBufferToImage flips both axes), and streams each block
+// to the file as it is converted: no Image and no whole-frame copy. RGB channels,
+// 32-bit float or 16-bit half, uncompressed or zlib-compressed (one or sixteen
+// scanlines per block, the EXR ZIPS / ZIP schemes). The camera's saturation
+// luminance goes in a `saturationLuminance` header attribute, so a viewer can
+// apply the render's own exposure (pixel = L / L_max).
+class ExrWriter
+{
+public:
+    struct Options
+    {
+        bool halfFloat = false;  // 16-bit half channels; radiance past 65504 clamps to it
+        ExrCompression compression = ExrCompression::Zip;
+        double saturationLuminance = 0.0;  // the camera's L_max; 0 = not recorded
+    };
+
+    // Throws std::runtime_error if the file cannot be written.
+    static void writeBuffer(const std::filesystem::path& path, const Buffer& buffer,
+                            const Options& options);
+
+    // IEEE 754 binary16 of `value`, rounded to nearest even; NaN stays NaN and
+    // infinities stay infinite.
+    static std::uint16_t toHalf(float value) noexcept;
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+// FRAME PIPELINE: an animation's frames, overlapped ($pipelineDepth).
+//
+// A frame renders in two stages (Renderer::beginFrame / finishFrame). The first —
+// probe pass, photon pass, bounce-index build — is where the workers run. The
+// second — each camera's gather, the tonemap — plus the PNG encode and write is a
+// tail that, per frame, spends long stretches on one core. Sequentially the next
+// frame's photon pass waits for all of it.
+//
+// The pipeline runs the first stage on the calling thread and hands each frame's
+// tail to one background thread, which runs the tails in frame order. So frame
+// N + 1's probe and photon passes run while frame N gathers, tonemaps and writes.
+// Two limits hold the overlap in check:
+//   - depth: frames in flight at once (begun, output not yet finished). 1 runs
+//     the frames strictly one after another, on the calling thread.
+//   - memoryBudget: the bytes those frames hold. A frame is begun only if the
+//     frames in flight plus one more like the last begun one fit; with nothing
+//     in flight a frame always begins, so an over-budget frame still renders
+//     (alone).
+// Errors surface in frame order: the first frame whose stage threw ends the run,
+// after every earlier frame's tail completed, and run() rethrows its exception.
+class FramePipeline
+{
+public:
+    // One frame's work after its first stage, run on the tail thread: `gather`
+    // then `output`. `bytes` is what the frame holds until `output` returns.
+    struct Tail
+    {
+        std::function<void()> gather;
+        std::function<void()> output;
+        std::size_t bytes = 0;
+    };
+
+    struct Limits
+    {
+        std::size_t depth = 1;         // frames in flight at once (<= 1: sequential)
+        std::size_t memoryBudget = 0;  // bytes over the frames in flight (0: unbounded)
+    };
+
+    // High-water marks over a run, for the CLI summary.
+    struct Stats
+    {
+        std::size_t peakFrames = 0;  // frames in flight
+        std::size_t peakBytes = 0;   // their Tail::bytes
+    };
+
+    // The first stage of frame `frame`, run on the calling thread; returns its tail.
+    using Begin = std::function<Tail(std::size_t frame)>;
+
+    // Render frames [first, last]: begin each in order, admitting a frame when the
+    // limits allow, and run the tails in order behind them. Returns once every
+    // tail has finished. Throws the first (earliest frame's) exception a stage
+    // raised; no frame after it is begun or output.
+    static Stats run(std::size_t first, std::size_t last, const Limits& limits, const Begin& begin);
+};
@@ -17,6 +17,10 @@ public:
     Pixel& getPixel(size_t x, size_t y) noexcept;
     void clear();
 
+    // The pixels, row major from the top-left: width * height Pixels, each three
+    // packed png_uint_16 (R, G, B) — the layout PngWriteSession::writeRgb16 reads.
+    const Pixel* data() const noexcept;
+
 private:
     size_t m_width;
     size_t m_height;
@@ -25,8 +25,15 @@ class LightQueue
 public:
     // Register a light with its total emission count (N) and its total luminous
     // flux Phi (lumens). The per-photon carried weight stored is Phi / N (the 1/N
-    // is baked here so the gather is a pure additive sum).
-    void registerLight(const std::string& name, size_t count, double luminousFlux);
+    // is baked here so the gather is a pure additive sum). A photon SHARD emits
+    // only `count` of the frame's `normalizationCount` photons, each still at the
+    // full frame's Phi / normalizationCount, so the shards' buffers sum to the
+    // whole frame; 0 = `count` is the whole frame.
+    void registerLight(const std::string& name, size_t count, double luminousFlux,
+                       size_t normalizationCount = 0);
+
+    // Forget every registered light, so the queue can seed another frame.
+    void reset();
 
     size_t remainingPhotons() const;
     size_t fetchPhotons(const std::string& name, size_t count);
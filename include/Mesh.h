@@ -28,6 +28,11 @@ public:
         return m_name;
     }
 
+    Bounds bounds() const noexcept
+    {
+        return m_tree.bounds();
+    }
+
     std::optional<Hit> castRay(const Ray& ray, std::vector<Hit>& castBuffer) const
     {
         return m_tree.castRay(ray, castBuffer);
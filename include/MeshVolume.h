@@ -18,6 +18,8 @@ public:
     void mesh(std::shared_ptr<Mesh> mesh);
     std::shared_ptr<Mesh> mesh() const;
 
+    std::optional<Bounds> localBounds() const override;
+
 protected:
     std::optional<Hit> castTransformedRay(const Ray& ray, std::vector<Hit>& castBuffer) const override;
 
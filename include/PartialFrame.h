@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Buffer.h"
+#include "Renderer.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+// PARTIAL FRAME: one photon shard's share of a frame (`ray-tracer <scene> --shard i/N`).
+//
+// Buffers are additive (DESIGN.md §7): shard i of N emits its own range of each
+// light's photons at the whole frame's per-photon flux, so the N shards' pre-tonemap
+// buffers SUM to one render of every photon. A partial frame is what a shard keeps
+// of its render for that sum — each camera's float buffer, the exposure it is
+// tonemapped with, and which shard of which frame it is — written to a raw
+// `.rtpart` file. `ray-tracer merge` reads a frame's partials, sums them and
+// tonemaps the result.
+//
+// File layout (native byte order, checked by the marker): the 8-byte magic
+// "RTPART1\n", a uint32 0x01020304 marker, then uint64 frame, shardIndex,
+// shardCount, photonsPerLight, photonsEmitted and camera count; per camera, a
+// uint64 name length and the name bytes, uint64 width and height, a double
+// saturationLuminance, and width * height RGB float32 triples in row order.
+struct PartialFrame
+{
+    struct View
+    {
+        std::string name;  // the camera's output name (may be empty)
+        std::size_t width = 0;
+        std::size_t height = 0;
+        double saturationLuminance = 0.0;  // the camera's L_max (tonemapBufferToImage)
+        std::vector<float> radiance;       // width * height RGB, pre-tonemap
+    };
+
+    std::size_t frame = 0;
+    std::size_t shardIndex = 0;
+    std::size_t shardCount = 1;
+    std::size_t photonsPerLight = 0;  // the WHOLE frame's, which every shard shares
+    std::size_t photonsEmitted = 0;   // photons this shard's lights emitted
+    std::vector<View> views;          // scene camera order; the primary first
+
+    // One shard's render of `frame`: every camera's buffer.
+    static PartialFrame fromRender(const RenderResult& render, const RenderSettings& settings,
+                                   std::size_t frame);
+
+    // Throws std::runtime_error if the file cannot be written, or read back as a
+    // partial frame.
+    void write(const std::filesystem::path& path) const;
+    static PartialFrame read(const std::filesystem::path& path);
+
+    // Sum one frame's shards into a whole frame (shard 0 of 1). Throws
+    // std::runtime_error unless they are the same frame and cameras, agree on the
+    // shard count and photon budget, and hold every shard exactly once.
+    static PartialFrame merge(const std::vector<PartialFrame>& shards);
+
+    // View `view`'s radiance as a Buffer, and tonemapped at its exposure.
+    std::shared_ptr<Buffer> buffer(std::size_t view) const;
+    std::shared_ptr<Image> image(std::size_t view) const;
+};
@@ -35,6 +35,14 @@
 //
 // Both validate dimensions / channel layout / writable path up front and reject
 // bad input before any libpng handle is created.
+//
+// writeRgb16 compresses in parallel, pigz-style: the image is cut into strips of
+// rows, each strip is filtered (libpng's per-row heuristic: the filter with the
+// least sum of absolute differences) and deflated on its own thread into a raw
+// stream that ends on a byte boundary, and the streams are joined under one zlib
+// header and one combined Adler-32 into IDAT chunks. Strips restart the deflate
+// window, which costs a fraction of a percent in size. The strip height depends
+// only on the image width, so a file's bytes do not depend on the machine.
 class PngWriteSession
 {
 public:
@@ -67,6 +75,11 @@ public:
                     const std::vector<png_uint_16>& pixels,
                     const std::string& title = {}) noexcept;
 
+    // As above, reading width*height*3 values from `pixels` in place (an Image's
+    // own storage, with no packed copy).
+    bool writeRgb16(uint32_t width, uint32_t height, const png_uint_16* pixels,
+                    const std::string& title = {}) noexcept;
+
     // Encode `width`*`height` pixels packed as 8-bit RGBA (4 bytes per pixel,
     // row major, top-left origin) and finish the stream. `pixels` must hold at
     // least width*height*4 bytes. Returns false (without UB) on invalid input
@@ -89,7 +102,7 @@ private:
     // live across the jump. Keeping the row/title scratch in the object means
     // the session destructor frees them on the libpng-error path too, so a
     // longjmp during a write leaks nothing.
-    std::vector<png_byte> m_rowScratch;
     std::vector<png_bytep> m_rowPointers;
     std::vector<char> m_titleScratch;
+    std::vector<std::vector<png_byte>> m_strips;  // writeRgb16's compressed IDAT data
 };
@@ -7,14 +7,14 @@
 
 // Thin convenience wrapper over PngWriteSession for the headless renderer's
 // 16-bit RGB Image output. All the libpng lifetime/error handling lives in
-// PngWriteSession; this just packs an Image into the RGB16 layout and routes it
-// through that single safe surface.
+// PngWriteSession; this just hands an Image's RGB16 pixels to that single safe
+// surface.
 class PngWriter
 {
 public:
     // Write `image` to `path` as a 16-bit RGB PNG with an optional tEXt title.
-    // Returns true on success. Equivalent on-disk bytes to the previous
-    // hand-rolled writer.
+    // Returns true on success. The same pixels as the previous hand-rolled
+    // writer; the compressed bytes differ (strips deflated in parallel).
     static bool writeImage(const std::filesystem::path& path, Image& image,
                            const std::string& title);
 };
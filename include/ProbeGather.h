@@ -2,6 +2,7 @@
 
 #include "AnimationQuery.h"
 #include "BounceStore.h"
+#include "Bounds.h"
 #include "Buffer.h"
 #include "Camera.h"
 #include "Color.h"
@@ -16,10 +17,14 @@
 #include "Vector.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <vector>
 
+class StreamingGather;
+
 // Phase 2a: PROBE-GUIDED UNIFIED GATHER.
 //
 // Replaces BOTH camera-side mechanisms — the direct-diffuse SPLAT and the
@@ -72,7 +77,9 @@ namespace ProbeGather
 // sample reached (directly at extension depth 0, or through a delta chain), plus
 // everything the PURE-COLLECTION gather needs to turn it into pixel radiance with
 // no further ray casting. Its `position` is ALSO the probe point for the keep-test
-// (every gather point is a probe by construction). ~72 B.
+// (every gather point is a probe by construction). This is the UNPACKED form the
+// tracer fills and the gather reads one at a time; records are HELD in a
+// GatherPointStore (below), packed to ~54 B.
 struct GatherPoint
 {
     PixelCoords pixel{0, 0};       // the camera pixel this sample contributes to
@@ -98,6 +105,80 @@ struct GatherPoint
                                       //   DOF/shutter/Fresnel average)
 };
 
+// A camera's gather records in a compact STRUCTURE-OF-ARRAYS layout. The records
+// live from the probe pass to the end of that camera's gather — across the whole
+// photon pass — so at 4K x 16 samples x several cameras the unpacked ~170 B
+// GatherPoint would cost gigabytes. Each column holds one field for every record:
+//   position            3 x float    (world units; the probe point)
+//   normal, viewDir     2 x uint32   (octahedral-encoded unit vectors, 16 bits/axis)
+//   pixel               uint32       (y * imageWidth + x)
+//   material            uint16       (kEmitterMaterial stored as 0xFFFF)
+//   specularThroughput  Color
+//   unfoldedPathLength, footprintRadius, sampleTime, sampleWeight   4 x float
+// push_back packs a GatherPoint, operator[] unpacks one. The position columns are
+// also what the ProbeIndex keep-test indexes IN PLACE (positions()), so the probe
+// points are never copied out.
+class GatherPointStore
+{
+public:
+    // `imageWidth` is the camera's pixel row length (packs the pixel index).
+    explicit GatherPointStore(std::size_t imageWidth = 0) : m_width(imageWidth) {}
+
+    // Throws std::runtime_error if the pixel index or material index does not fit
+    // its packed width.
+    void push_back(const GatherPoint& point);
+    // Append every record of `other` (same image width) in order.
+    void append(const GatherPointStore& other);
+    // Append records [begin, end) of `other`, moving each sample time from the frame
+    // at `fromFrameTime` to the frame at `toFrameTime` (same offset into the shutter).
+    void appendRange(const GatherPointStore& other, std::size_t begin, std::size_t end,
+                     float fromFrameTime, float toFrameTime);
+    void reserve(std::size_t count);
+
+    std::size_t size() const noexcept { return m_x.size(); }
+    bool empty() const noexcept { return m_x.empty(); }
+    std::size_t imageWidth() const noexcept { return m_width; }
+
+    GatherPoint operator[](std::size_t index) const;
+    Vector position(std::size_t index) const noexcept
+    {
+        return Vector{m_x[index], m_y[index], m_z[index]};
+    }
+    PixelCoords pixel(std::size_t index) const noexcept
+    {
+        return PixelCoords{m_pixel[index] % m_width, m_pixel[index] / m_width};
+    }
+    void setSampleWeight(std::size_t index, float weight) noexcept { m_weight[index] = weight; }
+
+    // The position columns, for a ProbeIndex to read in place.
+    ProbePositions positions() const noexcept
+    {
+        return ProbePositions{m_x.data(), m_y.data(), m_z.data(), m_x.size()};
+    }
+    // Records [begin, end) only.
+    ProbePositions positions(std::size_t begin, std::size_t end) const noexcept
+    {
+        return ProbePositions{m_x.data() + begin, m_y.data() + begin, m_z.data() + begin, end - begin};
+    }
+    // Bytes held by the columns (capacity, not just size).
+    std::size_t memoryBytes() const noexcept;
+
+private:
+    std::size_t m_width;
+    std::vector<float> m_x;
+    std::vector<float> m_y;
+    std::vector<float> m_z;
+    std::vector<std::uint32_t> m_normal;
+    std::vector<std::uint32_t> m_viewDir;
+    std::vector<std::uint32_t> m_pixel;
+    std::vector<std::uint16_t> m_material;
+    std::vector<Color> m_throughput;
+    std::vector<float> m_pathLength;
+    std::vector<float> m_footprint;
+    std::vector<float> m_time;
+    std::vector<float> m_weight;
+};
+
 struct ProbeResult
 {
     // One record per surviving per-pixel camera sample (direct or specularly
@@ -105,10 +186,60 @@ struct ProbeResult
     // full records. Records for ONE camera only — the Renderer keeps per-camera
     // record sets and unions only the POSITIONS for the shared keep-test index, so a
     // camera's gather never reads another camera's records.
-    std::vector<GatherPoint> points;
+    GatherPointStore points;
     size_t cameraRays = 0;       // primary rays cast
+    size_t firstSegmentCasts = 0;  // scene intersections along a primary ray's first segment
     size_t deltaExtensions = 0;  // samples that passed through at least one delta surface
     size_t misses = 0;           // samples that escaped without reaching a non-delta surface
+    size_t reusedDifferentials = 0;  // mirror differentials read from the left neighbour's chain
+    size_t differentialTraces = 0;   // mirror differentials that re-traced the neighbour's chain
+    size_t adaptiveStops = 0;        // multi-sample pixels that stopped after their pilot samples
+    size_t reusedTiles = 0;          // screen tiles whose records were carried over (ProbeReuse)
+    size_t retracedTiles = 0;        // screen tiles traced this frame
+};
+
+// Frame-to-frame probe-pass reuse for ONE camera (collectGatherPoints' `reuse`).
+// In an animation whose camera holds still, most of the frame sees only static
+// geometry, and its records — positions, throughputs, footprints — come out the
+// same every frame; only their sample times move with the frame. So the pass keeps,
+// per 16x16 screen tile, boxes around every camera-side segment the tile traced
+// (primary rays, delta chains, neighbour-chain differentials; each segment cut into
+// kReachPieces pieces so the boxes hug the tile's wedge of rays) and carries a
+// tile's records into the next frame unless an ANIMATED volume's swept bounds (over
+// the tile's trace window, or over the new frame's window) reach one of them. A tile
+// with a ray that escaped the scene has an unbounded segment and is re-traced
+// whenever anything is animated. Everything is re-traced when the camera itself
+// is animated or any sampling setting changed.
+//
+// The caller owns the records: `points` must hold the store the previous call
+// returned (it is read, not modified), and is replaced by the caller once nothing
+// reads the old records any more. It is shared so a frame still gathering from
+// those records (a pipelined animation, Renderer::beginFrame) keeps them alive
+// while the next frame's call reads them. `tileBegin` and `retracedTiles` describe
+// the store the LAST call returned, so a caller holding a per-tile ProbeIndex over
+// it patches just the re-traced tiles (ProbeIndex::patch).
+struct ProbeReuse
+{
+    std::shared_ptr<const GatherPointStore> points;  // the previous frame's records (caller-maintained)
+
+    // Filled by collectGatherPoints.
+    bool primed = false;
+    std::size_t width = 0;          // the sampling the cached tiles were traced with;
+    std::size_t height = 0;         //   any difference re-traces every tile
+    std::size_t subSample = 0;
+    float shutterSpan = 0.0f;
+    int cameraSamples = 0;
+    long long seed = 0;
+    bool adaptiveSamples = false;
+    float frameTime = 0.0f;                   // frame the returned records are stamped for
+    std::vector<std::size_t> tileBegin;       // tile t = records [tileBegin[t], tileBegin[t + 1])
+    std::vector<std::optional<Bounds>> tileReach;  // tile t's boxes at [t * kReachPieces, +kReachPieces)
+    std::vector<std::uint8_t> tileFlags;      // kTileEscaped | kTileTouchedAnimated
+    std::vector<std::size_t> retracedTiles;   // tiles the last call traced (ascending)
+
+    static constexpr std::size_t kReachPieces = 8;
+    static constexpr std::uint8_t kTileEscaped = 1;          // a ray left the scene
+    static constexpr std::uint8_t kTileTouchedAnimated = 2;  // reach met an animated volume
 };
 
 // THE SINGLE CAMERA-SIDE SPECULAR TRACER. For every pixel (strided by `subSample`)
@@ -142,8 +273,23 @@ struct ProbeResult
 // its pose at each sample time.
 // `seed`: when non-negative, the probe pass's RNG (DOF/shutter/Fresnel sampling) is
 // SEEDED to this value for reproducibility; -1 (default) seeds from random_device
-// (the production path). Used by the single-thread deterministic test mode so the
-// camera-side sampling is a fixed draw sequence.
+// (the production path). Used by the deterministic test mode so the camera-side
+// sampling is a fixed draw sequence.
+//
+// `workerCount` threads trace the frame as 16x16-pixel tiles, each with its own
+// record vector and its own RNG stream (seeded from `seed` and the tile index),
+// merged in tile order — so the records are identical for any worker count.
+//
+// `adaptiveSamples`: a multi-sample (DOF / shutter) pixel takes 8 pilot samples and
+// the rest of its budget only when they disagree ($adaptiveCameraSamples). Shutter
+// samples never stop early when the camera or any object is animated.
+//
+// `reuse`: when non-null, carries records over from the previous frame for the
+// tiles that cannot have changed and traces only the rest (see ProbeReuse).
+//
+// `reuseFirstHit`: a delta first hit's extension samples start from the first hit
+// already cast, instead of each re-intersecting the camera segment. The records are
+// identical either way; false exists to A/B that claim (firstSegmentCasts).
 ProbeResult collectGatherPoints(const std::vector<std::shared_ptr<Object>>& objects,
                                 const Camera& camera,
                                 const MaterialLibrary& materials,
@@ -152,7 +298,11 @@ ProbeResult collectGatherPoints(const std::vector<std::shared_ptr<Object>>& obje
                                 float shutterTime = 0.0f,
                                 int cameraSamples = 1,
                                 size_t subSample = 1,
-                                long long seed = -1);
+                                long long seed = -1,
+                                size_t workerCount = 1,
+                                bool adaptiveSamples = false,
+                                ProbeReuse* reuse = nullptr,
+                                bool reuseFirstHit = true);
 
 // ===== Emitter deposits (fixture visibility, unified) =====
 
@@ -180,6 +330,13 @@ EmitterDepositResult depositEmitters(const std::vector<std::shared_ptr<Object>>&
                                      double depositSpacing,
                                      BounceStore& store);
 
+// The same deposits folded into a streaming gather's per-record sums instead of a
+// store (`kept` counts the deposits some record took). Call after the photon pass.
+EmitterDepositResult depositEmitters(const std::vector<std::shared_ptr<Object>>& objects,
+                                     const ProbeIndex& probeIndex,
+                                     double depositSpacing,
+                                     StreamingGather& gather);
+
 // ===== Unified gather =====
 
 struct Result
@@ -216,14 +373,107 @@ struct Result
 // passes). A moving surface's lighting is thus gathered from the photons that lit
 // its time-correct pose. `shutterTime` sizes the temporal half-window (0 => only
 // same-instant deposits, which on a static scene is every deposit).
+//
+// ORDER: work is handed out as 16x16-pixel screen TILES through a shared cursor
+// (dynamic scheduling); the thread that takes a tile owns its pixels and sums them
+// in a plain-float tile accumulator, touching the shared (atomic) Buffer once per
+// pixel when the tile is done. With `spatialOrder`, records are processed in Morton
+// order of their position (not the probe pass's pixel order) WITHIN each tile
+// only: records that reach the same surface region through different pixels or
+// specular chains of one tile gather back to back and share BounceStore cells in
+// cache, but a surface seen from two distant tiles (e.g. directly and in a mirror)
+// is gathered twice, by whichever threads own those tiles. That is the price of
+// tile ownership, which keeps the accumulators tile-sized and contention-free.
+// The per-pixel result is the same sum either way; only the summation order differs.
 Result run(const std::shared_ptr<Camera>& camera,
-           const std::vector<GatherPoint>& points,
+           const GatherPointStore& points,
            const BounceStore& store,
            const MaterialLibrary& materials,
            size_t workerCount,
            double minGatherRadius,
            Buffer& buffer,
-           float shutterTime = 0.0f);
+           float shutterTime = 0.0f,
+           bool spatialOrder = true);
+
+// One camera's part in a combined gather (runCameras): its records and the buffer
+// sized to its resolution that they are gathered into.
+struct CameraGather
+{
+    std::shared_ptr<Camera> camera;
+    const GatherPointStore* points = nullptr;
+    Buffer* buffer = nullptr;
+};
+
+// run() over several cameras at once, sharing the one BounceStore. Every camera's
+// screen tiles go into ONE work queue that `workerCount` threads drain, so a frame
+// of many small cameras keeps all the threads busy instead of starting a short-
+// lived thread set per camera that a few hundred records cannot fill. Returns one
+// Result per camera, in order. Each camera's image is what run() gives it: the
+// same tiles with the same records in the same order (with one worker the tiles
+// run camera by camera, so the sums are bit for bit the sequential ones).
+std::vector<Result> runCameras(const std::vector<CameraGather>& cameras,
+                               const BounceStore& store,
+                               const MaterialLibrary& materials,
+                               size_t workerCount,
+                               double minGatherRadius,
+                               float shutterTime = 0.0f,
+                               bool spatialOrder = true);
+
+// ===== Progressive gather (SPPM) =====
+//
+// Stochastic progressive photon mapping over the same GatherPoint records. Instead
+// of holding every photon pass's deposits until one gather at the end, the renderer
+// runs the photon pass several times, folds each pass's BounceStore into per-record
+// statistics, and throws the store away before the next pass. Memory is then
+// bounded by the records (20 B each here, on top of the records themselves) plus
+// ONE pass's deposits, however many passes are run.
+//
+// Per record i, after a pass that found M deposits summing to Φ = Σ f(wi, wo) Φ_p
+// within its current radius R:
+//   N' = N + alpha * M
+//   R' = R * sqrt(N' / (N + M))            (never below the gather's radius floor)
+//   τ' = (τ + Φ) * (R' / R)^2
+// and after K passes its radiance is (4/pi) * τ / (pi R^2 K) — the one-shot gather's
+// estimate with the flux averaged over K independent passes. With K = 1 that is the
+// one-shot gather exactly; as K grows the radius shrinks and the blur of the density
+// estimate goes to zero while the noise still averages out (alpha in (0, 1) trades
+// the two; 2/3 to 0.7 is the usual choice).
+struct ProgressiveState
+{
+    std::vector<float> radius;  // current gather radius R per record (world units)
+    std::vector<float> count;   // accumulated, alpha-thinned deposit count N per record
+    std::vector<Color> flux;    // accumulated Σ f·Φ per record, rescaled to R
+    std::size_t passes = 0;     // photon passes folded in so far
+
+    std::size_t memoryBytes() const noexcept;
+};
+
+// Start the statistics for `points`: every radius at the record's floored footprint
+// radius (the one-shot gather's disc), no flux, no passes.
+ProgressiveState beginProgressive(const GatherPointStore& points, double minGatherRadius);
+
+// Fold one photon pass into `state`: gather each record's deposits from `store`
+// (with the one-shot gather's normal, tangent-band and temporal filters) within its
+// current radius and apply the update above. `store` must have had buildIndex()
+// called; it is not needed afterwards. Records are independent, so `workerCount`
+// threads split them in any order with the same result. Returns the number of
+// deposits summed over all records.
+std::size_t accumulateProgressive(const GatherPointStore& points,
+                                  const BounceStore& store,
+                                  const MaterialLibrary& materials,
+                                  size_t workerCount,
+                                  double minGatherRadius,
+                                  float shutterTime,
+                                  double alpha,
+                                  ProgressiveState& state);
+
+// Write the progressive estimate of every record into its pixel of `buffer`,
+// weighted by its specular throughput and sample weight (the same accumulation
+// run() does). `state.passes` must be at least 1.
+Result resolveProgressive(const std::shared_ptr<Camera>& camera,
+                          const GatherPointStore& points,
+                          const ProgressiveState& state,
+                          Buffer& buffer);
 
 // ===== Test-visible gather internals =====
 //
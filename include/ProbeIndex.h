@@ -30,9 +30,33 @@
 // scans the cell neighborhood that could contain a probe within r and does an
 // exact squared-distance test against the probe points in those cells.
 //
-// The index is built once (single-threaded) after the probe pass and is
+// The KEEP-TEST (anyWithinKeepRadius, run on every non-delta bounce of every
+// photon) does not walk that neighborhood. It reads a precomputed, conservative
+// OCCUPANCY table instead: cells of edge ~keepRadius, present only if a probe lies
+// in the cell or one of its 26 neighbors (the keep radius dilated to cell
+// granularity), each carrying a 4x4x4 bitmask of sub-voxels that are ENTIRELY
+// within keepRadius of some probe. One open-addressed probe answers "definitely
+// culled" (no entry), one bit test answers "definitely kept"; only points in the
+// thin boundary shell fall through to the exact anyWithin() scan.
+//
+// The probe positions are NOT copied: the index reads them in place from the probe
+// pass's compact record stores (ProbeGather::GatherPointStore keeps them as float
+// x/y/z columns) through ProbePositions views, one per camera, which must outlive
+// the index. The per-cell lists hold packed (source, record) references.
+//
+// The index is built (single-threaded) after the probe pass — or patched, when a
+// later frame re-traced only part of the frame (patch()) — and is
 // READ-ONLY during the photon pass; many worker threads call anyWithin()
 // concurrently, which is safe because there are no concurrent writers.
+// A non-owning view of `count` probe positions stored as three float columns.
+struct ProbePositions
+{
+    const float* x = nullptr;
+    const float* y = nullptr;
+    const float* z = nullptr;
+    std::size_t count = 0;
+};
+
 class ProbeIndex
 {
 public:
@@ -44,17 +68,50 @@ public:
     // query touch a 3x3x3 cell neighborhood.
     ProbeIndex(const std::vector<Vector>& probes, double cellSize, double keepRadius);
 
+    // Same, over the positions of `sources` read in place (no copy). Every source
+    // must stay alive and unmodified for the lifetime of the index.
+    ProbeIndex(std::vector<ProbePositions> sources, double cellSize, double keepRadius);
+
+    // Not copyable: m_sources may point into this object's own m_owned* columns.
+    ProbeIndex(const ProbeIndex&) = delete;
+    ProbeIndex& operator=(const ProbeIndex&) = delete;
+
+    // Incremental update for a caller that re-traced only some sources (the probe
+    // pass's frame-to-frame reuse): `sources` replaces the views, same count and
+    // order. Sources listed in `changed` hold NEW probes — their old cell entries
+    // are dropped and the new ones inserted; every other source must view the SAME
+    // positions as before, possibly at a new address, and its entries are kept as
+    // they are. The keep-test occupancy table is then re-stenciled. The OLD sources
+    // must still be alive during the call (their positions locate the entries to
+    // drop). Throws std::runtime_error if the source count changed.
+    void patch(std::vector<ProbePositions> sources, const std::vector<std::size_t>& changed);
+
     // True if any probe lies within Euclidean distance `r` of `p`.
     bool anyWithin(const Vector& p, double r) const;
 
+    // A probe found by collectWithin(): its source and its position in that source.
+    struct ProbeRef
+    {
+        std::size_t source = 0;
+        std::size_t index = 0;
+    };
+
+    // Replace `out` with every probe within Euclidean distance `r` of `p` (the
+    // same cells anyWithin() scans, in no particular order). `out` is the
+    // caller's scratch vector, so a worker reuses its capacity across queries.
+    void collectWithin(const Vector& p, double r, std::vector<ProbeRef>& out) const;
+
     // True if any probe lies within the configured keepRadius of `p` (the
-    // keep-test used during the photon pass).
-    bool anyWithinKeepRadius(const Vector& p) const { return anyWithin(p, m_keepRadius); }
+    // keep-test used during the photon pass). Same answer as
+    // anyWithin(p, keepRadius()), via the occupancy fast path.
+    bool anyWithinKeepRadius(const Vector& p) const;
 
     double cellSize() const noexcept { return m_cellSize; }
     double keepRadius() const noexcept { return m_keepRadius; }
-    std::size_t probeCount() const noexcept { return m_probes.size(); }
+    std::size_t probeCount() const noexcept { return m_probeCount; }
     std::size_t cellCount() const noexcept { return m_cells.size(); }
+    // Cells present in the dilated keep-test occupancy table.
+    std::size_t occupancyCellCount() const noexcept { return m_occupancyCount; }
 
 private:
     struct CellKey
@@ -82,10 +139,51 @@ private:
 
     CellKey cellOf(const Vector& p) const noexcept;
 
+    // A probe reference: source index in the high 32 bits, position within the
+    // source in the low 32.
+    static constexpr int kSourceShift = 32;
+    Vector probeAt(std::uint64_t ref) const noexcept
+    {
+        const ProbePositions& source = m_sources[ref >> kSourceShift];
+        const std::size_t i = ref & 0xFFFFFFFFull;
+        return Vector{source.x[i], source.y[i], source.z[i]};
+    }
+
+    void build();
+
+    // Keep-test occupancy table slot: a dilated cell and the mask of its 4x4x4
+    // sub-voxels that lie wholly inside the keep radius of some probe.
+    struct OccupancySlot
+    {
+        CellKey key{0, 0, 0};
+        std::uint64_t keptMask = 0;
+        bool used = false;
+    };
+
+    static constexpr int kSubVoxels = 4;  // per axis, per occupancy cell
+
+    void buildOccupancy();
+    OccupancySlot& occupancyInsert(const CellKey& key);
+    const OccupancySlot* occupancyFind(const CellKey& key) const noexcept;
+
     double m_cellSize;
     double m_invCellSize;
     double m_keepRadius;
-    std::vector<Vector> m_probes;
-    // Cell -> indices into m_probes that fall in that cell.
-    std::unordered_map<CellKey, std::vector<std::size_t>, CellKeyHash> m_cells;
+    std::vector<ProbePositions> m_sources;
+    std::size_t m_probeCount = 0;
+    // Backing columns for the std::vector<Vector> constructor (unused otherwise).
+    std::vector<float> m_ownedX;
+    std::vector<float> m_ownedY;
+    std::vector<float> m_ownedZ;
+    // Cell -> references (see probeAt) to the probes that fall in that cell.
+    std::unordered_map<CellKey, std::vector<std::uint64_t>, CellKeyHash> m_cells;
+
+    // Keep-test occupancy: open-addressed (linear probing, power-of-two size)
+    // table over cells of edge m_occupancyCell.
+    double m_occupancyCell = 1.0;
+    double m_invOccupancyCell = 1.0;
+    std::vector<OccupancySlot> m_occupancy;
+    std::size_t m_occupancyMask = 0;
+    int m_occupancyShift = 64;
+    std::size_t m_occupancyCount = 0;
 };
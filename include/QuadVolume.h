@@ -33,6 +33,8 @@ public:
     void edgeV(const Vector& edgeV);
     Vector edgeV() const;
 
+    std::optional<Bounds> localBounds() const override;
+
 protected:
     std::optional<Hit> castTransformedRay(const Ray& ray, std::vector<Hit>& castBuffer) const override;
 
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "ProbeGather.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+// RENDER CHECKPOINT: a progressive frame's state between two photon passes
+// ($checkpointPasses, `ray-tracer <scene> --resume`).
+//
+// Between passes a progressive render holds nothing but each camera's per-record
+// statistics (ProbeGather::ProgressiveState) and a few counters: the BounceStore
+// of the last pass has been folded in and released, and every worker seed is a
+// function of the base seed and the pass index, so "which photons each light has
+// emitted" and "where each RNG stream is" are both just `passesDone`. A checkpoint
+// is that state; a resumed frame re-traces its probe records (identical under a
+// seed), loads the statistics and runs the remaining passes, and ends on the
+// image the uninterrupted frame would have.
+//
+// The first fields say which render the checkpoint belongs to; sameRender()
+// compares them so a resume never continues another scene's or frame's passes.
+//
+// File layout (native byte order, checked by the marker): the 8-byte magic
+// "RTCKPT1\n", a uint32 0x01020304 marker, double frameTime, uint64
+// photonsPerLight, progressivePasses, double progressiveAlpha, uint32 seed, then
+// uint64 passesDone, photonsEmitted, droppedDeposits, attemptedDeposits and
+// camera count; per camera, uint64 record count and deposits, then the radius,
+// count and flux (RGB) float32 columns.
+struct RenderCheckpoint
+{
+    struct View
+    {
+        std::size_t records = 0;   // gather records of this camera's probe pass
+        std::size_t deposits = 0;  // deposits folded in so far
+        ProbeGather::ProgressiveState state;
+    };
+
+    // The render this belongs to.
+    double frameTime = 0.0;
+    std::size_t photonsPerLight = 0;
+    std::size_t progressivePasses = 0;
+    double progressiveAlpha = 0.0;
+    std::uint32_t seed = 0;
+
+    // How far it got.
+    std::size_t passesDone = 0;
+    std::size_t photonsEmitted = 0;
+    std::uint64_t droppedDeposits = 0;
+    std::uint64_t attemptedDeposits = 0;
+    std::vector<View> views;  // the probe cameras, in scene order
+
+    // Same frame, settings and camera records (View::records) as `other`.
+    bool sameRender(const RenderCheckpoint& other) const;
+
+    // write() goes through a temporary file renamed over `path`, so a process
+    // killed mid-write leaves the previous checkpoint intact. Both throw
+    // std::runtime_error on an I/O failure or a file that is not a checkpoint.
+    void write(const std::filesystem::path& path) const;
+    static RenderCheckpoint read(const std::filesystem::path& path);
+};
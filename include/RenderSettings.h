@@ -2,6 +2,15 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <filesystem>
+
+// Compression of the float (EXR) output; the values are the OpenEXR codes.
+enum class ExrCompression : std::uint8_t
+{
+    None = 0,
+    Zips = 2,  // zlib, one scanline per block
+    Zip = 3    // zlib, sixteen scanlines per block
+};
 
 // Tunables for a render pass. These mirror the fields that main.cpp historically
 // read out of a scene JSON's $workerConfiguration / $renderConfiguration blocks.
@@ -125,12 +134,29 @@ struct RenderSettings
     bool useProbeGather = true;
 
     // Maximum raw bounces retained by the BounceStore (slot capacity). Storage is
-    // bounded by the probe keep-test (visible-surface-area), but the store still
-    // needs a fixed up-front capacity; this is the ceiling. Bounces past it are
-    // dropped and counted. Default 40M (~960 MiB at 24 B/record) comfortably holds
-    // a Cornell-scale visible surface at multi-million photon budgets.
+    // bounded by the probe keep-test (visible-surface-area) and committed lazily in
+    // segments as deposits land, so this is a MEMORY CEILING, not a reservation:
+    // a frame only pays for the bounces it keeps, up to capacity * 52 B. Bounces
+    // past it are dropped and counted. Default 40M (~2 GiB ceiling) comfortably
+    // holds a Cornell-scale visible surface at multi-million photon budgets.
     size_t bounceStoreCapacity = 40 * kMillion;
 
+    // Out-of-core BounceStore: resident-memory limit in MiB for the raw-bounce
+    // records. 0 (default) keeps the whole store in RAM. When > 0, segments past
+    // this budget spill to a memory-mapped scratch file in the system temp
+    // directory (TMPDIR; point it at fast local disk), so $bounceStoreCapacity can
+    // be raised past RAM instead of dropping energy on the highest-quality frames.
+    size_t bounceStoreResidentMiB = 0;
+
+    // Deposit merging: after the photon pass, deposits inside one sub-cell of edge
+    // (depositMergeScale * gather footprint) whose normals, incoming directions and
+    // times agree are folded into one power-weighted deposit (BounceStore::
+    // mergeDeposits), so a brightly lit flat region stores and gathers far fewer of
+    // them. The bias grows with the scale: a merged deposit moves by at most the
+    // sub-cell diagonal. 0 (default) = no merging; ~0.25 keeps the shift well inside
+    // the gather disc.
+    double depositMergeScale = 0.0;
+
     // Keep-radius scale: a non-delta bounce is kept iff a probe lies within
     // (probeKeepRadiusScale * sceneDepthFootprint) of it. >= 1 so the keep radius
     // is at least one gather footprint (a bounce exactly one footprint from a
@@ -146,14 +172,22 @@ struct RenderSettings
     // Default 1.
     size_t probeSubSample = 1;
 
-    // PROBE TEMPORAL COVERAGE (animation). With a finite shutter the camera sees
-    // animated geometry across a continuum of poses; the probe pass samples this
-    // many DISCRETE time slices across [frameTime, frameTime+shutterTime) and unions
-    // the probes so a fast-moving object's later poses are covered and its deposits
-    // survive the keep-test. Ignored when shutterTime == 0 (a single slice at
-    // frameTime — the static baseline). Probe count governs COVERAGE, not gather
-    // smoothness (the gather stays continuous, weighting deposits by photon time);
-    // a handful of slices conservatively covers normal motion. Default 5.
+    // Gather record order. ProbeGather::run always buckets a camera's records by
+    // 16x16 screen tile (one thread owns a tile's pixels). When true (default) the
+    // records INSIDE each tile run in Morton order of their world position, so a
+    // tile's records that reach the same surface through different pixels/specular
+    // chains gather back to back from warm BounceStore cells; locality does not
+    // extend across tiles. false keeps the probe pass's pixel order within a tile
+    // (same image up to float summation order; kept for A/B timing).
+    bool gatherSpatialOrder = true;
+
+    // DEPOSIT TIME SLICES (animation). With a finite shutter the raw-bounce index
+    // orders each cell's deposits into this many equal slices of the shutter
+    // (BounceStore::buildIndex), so a gather at a camera sample's time visits only
+    // the slices its temporal window overlaps and takes the slices inside it without
+    // a per-deposit time test. The image is unchanged. (It once set the probe pass's
+    // discrete time slices; every probe sample now carries its own random time.)
+    // Ignored when shutterTime == 0. 1 = unsliced cells. Default 5.
     int probeTimeSlices = 5;
 
     // CAMERA MOTION-BLUR SAMPLES (animation). With a finite shutter each pixel takes
@@ -163,6 +197,90 @@ struct RenderSettings
     // static baseline). Higher = smoother blur at linear cost. Default 16.
     int cameraTimeSamples = 16;
 
+    // ADAPTIVE CAMERA SAMPLING (opt-in). A pixel that takes several primary samples
+    // (DOF aperture and/or shutter-time samples) first takes 8 pilot samples and
+    // spends the rest of its budget only if they disagree — hit different surfaces,
+    // spread past about one pixel's footprint, carry different specular throughput,
+    // or partly miss. In-focus, static pixels thus cost 8 samples instead of 16; the
+    // 1/N sampleWeight uses the samples actually taken. Pixels whose pilot passed
+    // through glass always take the full budget, and so do shutter samples whenever
+    // the camera or any object is animated. The stop is still BIASED: a feature
+    // covering a small fraction of a pixel's samples can be missed by every pilot
+    // (a 30% occluder ~6% of the time). Default false (fixed budget everywhere).
+    bool adaptiveCameraSamples = false;
+
+    // PROBE-PASS REUSE ACROSS FRAMES (animation). When an animation is rendered
+    // frame by frame, the executable keeps each camera's probe records between frames
+    // and, for a camera that does not move, re-traces only the screen tiles whose
+    // traced rays an animated object's swept bounds can reach; the rest keep last
+    // frame's records and the keep-test index is patched rather than rebuilt (see
+    // ProbeGather::ProbeReuse). false = trace every frame from scratch. Default true.
+    bool probeFrameReuse = true;
+
+    // PROGRESSIVE PHOTON MAPPING (SPPM, probe mode). With $progressivePasses > 1 the
+    // frame runs that many photon passes of $photonsPerLight photons each. After
+    // every pass each gather record folds the deposits inside its radius into its
+    // own (count, radius, flux) statistics, its radius shrinks, and the BounceStore
+    // is released before the next pass (ProbeGather::ProgressiveState). Memory is
+    // bounded by the records plus one pass's deposits, so the photon total can grow
+    // past what $bounceStoreCapacity could hold at once. Each pass's deposits are
+    // bounded by the same capacity as a one-shot render. 1 (default) = the one-shot
+    // gather.
+    size_t progressivePasses = 1;
+    // Fraction of each pass's deposits a record keeps in its count (alpha in (0, 1]).
+    // Smaller shrinks the radius faster (sharper, noisier); 1 never shrinks it (the
+    // passes just average). Default 0.7.
+    double progressiveAlpha = 0.7;
+    // CHECKPOINTS (progressive renders). With $checkpointPasses > 0 a progressive
+    // frame writes its state (RenderCheckpoint) to `checkpointPath` after every that
+    // many passes, and a frame begun with `resumeFromCheckpoint` set continues from
+    // the checkpoint found there, to the image the uninterrupted frame would have
+    // rendered. Needs a $seed (or $deterministic) so the resumed frame traces the
+    // same probe records. A one-pass render has no pass boundary to stop at and
+    // writes none. 0 (default) = no checkpoints. `checkpointPath` and
+    // `resumeFromCheckpoint` are set by the executable (`--resume`), not scene keys.
+    size_t checkpointPasses = 0;
+    std::filesystem::path checkpointPath;
+    bool resumeFromCheckpoint = false;
+
+    // STREAMING GATHER (probe mode, one-shot only). When every non-debug camera sees
+    // only Lambertian surfaces and emitter faces, the photon pass adds each kept
+    // bounce's power straight into the gather records it lands on instead of storing
+    // it (StreamingGather), so no BounceStore is allocated, indexed or searched. The
+    // image is the one-shot gather's. A view with any other material, or a
+    // progressive render, falls back to the BounceStore path. Default false.
+    bool streamingGather = false;
+
+    // FRAME PIPELINE (animation, executable). With $pipelineDepth > 1 the executable
+    // overlaps frames (FramePipeline): frame N + 1's probe and photon passes run
+    // while frame N gathers, tonemaps and writes its PNG on a second thread. The
+    // depth is how many frames may be in flight at once; $pipelineMemoryMiB caps
+    // the memory they hold together (bounce stores, records, buffers), holding a
+    // frame back until an earlier one is written. Each frame's image is the one a
+    // sequential render produces. 1 (default) = one frame at a time; 0 MiB = no cap.
+    size_t pipelineDepth = 1;
+    size_t pipelineMemoryMiB = 0;
+
+    // PHOTON SHARD (executable: `ray-tracer <scene> --shard i/N`; not a scene key).
+    // Shard i of N emits photons [i*M/N, (i+1)*M/N) of each light's M =
+    // $photonsPerLight at the WHOLE frame's per-photon flux (Phi / M), with worker
+    // seeds of its own, so the N shards' pre-tonemap buffers sum to one render of
+    // all M photons (DESIGN.md §7). Only shard 0 adds the light fixtures' own
+    // surface radiance. Set a $seed so every shard traces the same probe records.
+    // Not with $progressivePasses > 1: its radius update is not additive. 0 of 1
+    // (default) = the whole frame.
+    size_t shardIndex = 0;
+    size_t shardCount = 1;
+
+    // FLOAT OUTPUT (executable). With $exrOutput the executable also writes every
+    // camera's pre-tonemap radiance buffer to an OpenEXR file beside the PNG
+    // (ExrWriter), so the exposure can change in post without a re-render.
+    // $exrHalf stores 16-bit half channels instead of 32-bit float; $exrCompression
+    // is "none", "zips" or "zip" (default). Default false (PNG only).
+    bool exrOutput = false;
+    bool exrHalf = false;
+    ExrCompression exrCompression = ExrCompression::Zip;
+
     // ===== Deterministic test mode (objective-test infrastructure) =====
     //
     // Production renders seed every RNG from std::random_device, so two runs of the
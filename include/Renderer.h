@@ -5,14 +5,19 @@
 #include "DensityGrid.h"
 #include "EmissiveGather.h"
 #include "Image.h"
+#include "LightQueue.h"
 #include "MirrorGather.h"
+#include "Photon.h"
 #include "ProbeGather.h"
+#include "ProbeIndex.h"
 #include "SceneLoader.h"
+#include "WorkQueue.h"
 
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 // Wave 6: per-camera output of a multi-camera render. The photon pass / bounce
@@ -100,8 +105,74 @@ struct RenderResult
     // silently swallowed; raise $bounceStoreCapacity (or lower photon budget) to
     // clear it.
     std::uint64_t bounceStoreDropped = 0;
+
+    // Probe-pass reuse (renderFrame's `cache`): screen tiles whose records were
+    // carried over from the previous frame vs traced for this one, over all cameras.
+    size_t probeTilesReused = 0;
+    size_t probeTilesTraced = 0;
+
+    // $streamingGather: whether this frame used it (false when it fell back to the
+    // BounceStore) and the bytes of per-record state it held in place of the store.
+    bool streamedGather = false;
+    std::size_t streamingGatherBytes = 0;
+
+    // Photons the lights were seeded with, over every light and photon pass. A
+    // photon shard's share of the frame (RenderSettings::shardIndex).
+    std::size_t photonsEmitted = 0;
+
+    // Progressive passes a resumed frame took from its checkpoint instead of
+    // running (RenderSettings::resumeFromCheckpoint); 0 for a frame run whole.
+    std::size_t resumedPasses = 0;
+
+    // $depositMergeScale: deposits in the store before and after merging, summed
+    // over the photon passes (equal when merging is off).
+    std::size_t depositsBeforeMerge = 0;
+    std::size_t depositsAfterMerge = 0;
 };
 
+// Probe-pass state an animation carries from one frame to the next (renderFrame's
+// optional `cache`). Holds each camera's records and ProbeGather::ProbeReuse tile
+// state, plus the keep-test ProbeIndex over them — one index source per camera
+// tile, so a frame that re-traced a few tiles patches just those sources instead of
+// rebuilding the index. Pass the same cache to every frame of ONE scene (cameras are
+// keyed by address); a default-constructed cache simply traces everything.
+struct FrameCache
+{
+    std::unordered_map<const Camera*, ProbeGather::ProbeReuse> cameras;
+    std::shared_ptr<ProbeIndex> probeIndex;
+    std::vector<const Camera*> indexCameras;  // camera order of the index's sources
+    double indexKeepRadius = 0.0;
+    // Set when a frame's beginFrame finished with the cache. A frame that threw
+    // there leaves it clear (its records never reached the cache), and the next
+    // frame starts over.
+    bool primed = false;
+};
+
+// The large per-frame allocations, kept from one frame to the next (renderFrame's
+// optional `context`): the photon queue ($photonQueueSize slots, all faulted in
+// when it is built), the light queue, the raw-bounce store's committed segments and
+// each camera's splat buffer. A frame takes an idle one of the right size from each
+// pool and resets it in place; it allocates only when none is idle — the first
+// frame, a size change, or while earlier frames still hold theirs (pending frames
+// in a pipeline, or RenderResults the caller kept). Spill stores are never pooled.
+// Splat buffers pool by camera order, so a scene reloaded between frames still
+// reuses them. Begin frames with a context one at a time, as with the cache.
+struct RenderContext
+{
+    std::vector<std::shared_ptr<WorkQueue<Photon>>> photonQueues;
+    std::vector<std::shared_ptr<LightQueue>> lightQueues;
+    std::vector<std::shared_ptr<BounceStore>> bounceStores;
+    std::vector<std::vector<std::shared_ptr<Buffer>>> splatBuffers;  // per camera slot
+    // Allocations frames took from the pools vs made afresh (diagnostics, tests).
+    std::size_t reused = 0;
+    std::size_t allocated = 0;
+};
+
+// A frame between Renderer::beginFrame and Renderer::finishFrame: its records,
+// bounce store and splat buffers, plus a copy of the scene it began with. Opaque;
+// held through a shared_ptr.
+struct PendingFrame;
+
 namespace Renderer
 {
 
@@ -140,8 +211,40 @@ using PreviewCallback =
 // remains the executable's responsibility (it loops and calls per frame).
 //
 // Throws if a worker raises an exception.
+//
+// `cache`, when given, carries the probe pass over from the previous frame rendered
+// with it (FrameCache): tiles of a still camera that cannot see anything animated
+// keep their records, and only the rest are traced.
+//
+// `context`, when given, supplies the photon queue, bounce store and splat buffers
+// (RenderContext) instead of fresh allocations; the image is the same either way.
 RenderResult renderFrame(const LoadedScene& scene, ProgressCallback progress = nullptr,
-                         PreviewCallback preview = nullptr);
+                         PreviewCallback preview = nullptr, FrameCache* cache = nullptr,
+                         RenderContext* context = nullptr);
+
+// renderFrame in two stages, for callers that overlap frames (the CLI's frame
+// pipeline, FramePipeline.h). beginFrame runs the probe pass, the photon pass(es)
+// and the bounce-index build, and hands its records to `cache`; finishFrame runs
+// each camera's gather and tonemap. finishFrame(*beginFrame(...)) is renderFrame.
+//
+// A pending frame owns everything its gather reads, including a copy of `scene`
+// taken when beginFrame returns, so the caller may change scene.settings.frameTime
+// and begin the next frame — with the same `cache` — while this frame finishes on
+// another thread. Cameras are shared: the next beginFrame resets their exposure
+// windows, which only the photon pass reads. finishFrame consumes the frame; call
+// it once. Begin frames one at a time and in order: they share the cameras, cache
+// and context.
+std::shared_ptr<PendingFrame> beginFrame(const LoadedScene& scene,
+                                         ProgressCallback progress = nullptr,
+                                         PreviewCallback preview = nullptr,
+                                         FrameCache* cache = nullptr,
+                                         RenderContext* context = nullptr);
+RenderResult finishFrame(PendingFrame& frame);
+
+// Bytes a pending frame holds until finishFrame returns: its bounce store (or
+// streaming sums), gather records, splat buffers and the images to come. For
+// memory budgets over frames in flight.
+std::size_t pendingFrameBytes(const PendingFrame& frame);
 
 // Tonemap a raw energy Buffer into a 16-bit Image. Wave 2: applies the two-step
 // physical conversion — (a) raw accumulated photon energy -> physical luminance
@@ -153,6 +256,8 @@ RenderResult renderFrame(const LoadedScene& scene, ProgressCallback progress = n
 //   saturationLuminance  = camera L_max = (N_f^2 * K) / (t * S).
 //
 // Exposed separately so progressive preview can tonemap an in-flight snapshot.
-void tonemapBufferToImage(const Buffer& buffer, Image& image, double photonsEmitted, double saturationLuminance);
+// `workerCount` threads split the rows; the image is the same at any count.
+void tonemapBufferToImage(const Buffer& buffer, Image& image, double photonsEmitted,
+                          double saturationLuminance, std::size_t workerCount = 1);
 
 }
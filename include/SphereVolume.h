@@ -20,6 +20,8 @@ public:
     void radius(double radius);
     double radius() const;
 
+    std::optional<Bounds> localBounds() const override;
+
 protected:
     std::optional<Hit> castTransformedRay(const Ray& ray, std::vector<Hit>& castBuffer) const override;
 
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "BounceStore.h"
+#include "Buffer.h"
+#include "Camera.h"
+#include "Color.h"
+#include "MaterialLibrary.h"
+#include "ProbeGather.h"
+#include "ProbeIndex.h"
+#include "Vector.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// STREAMING GATHER: the BounceStore's opt-in replacement for a matte view
+// ($streamingGather).
+//
+// When every gather record lands on a Lambertian surface (or an emitter face), the
+// gather's Σ f(wi, wo)·Φ over a record's footprint is f·ΣΦ: the BRDF is a constant
+// albedo/pi over the upper hemisphere (1 for an emitter), so all the gather needs
+// per record is the sum of the deposit powers that pass its filters. The photon
+// pass can form that sum directly. A kept bounce looks up, through the keep-test
+// ProbeIndex, every record whose footprint it lands in and atomically adds its
+// power to that record's accumulator — with the same filters the gather applies
+// (temporal window, normal agreement, tangent band, and the Lambertian's
+// wi·n > 0). Nothing is stored per bounce: no BounceStore, no buildIndex, no
+// post-pass radius searches. resolve() then turns each record's sum into pixel
+// radiance with the gather's own normalization.
+//
+// The result is the one-shot gather's image (up to float summation order): the
+// same keep-test decides which bounces count, and a kept bounce reaches exactly
+// the records whose floored footprint holds it (the index query spans the largest
+// footprint, then each record tests its own).
+//
+// Memory: 12 B of accumulator plus 24 B of unpacked record data per record, for
+// the records the index spans (every camera's). Deposits are atomic float adds,
+// so concurrent workers may race on the same record without locks; the sum order
+// (and so the low bits) then depends on scheduling, like the Buffer's.
+class StreamingGather
+{
+public:
+    // One ProbeIndex source: records [begin, begin + view count) of `records`, the
+    // gather records of camera slot `camera`. Sources are listed in the index's
+    // source order.
+    struct Source
+    {
+        const ProbeGather::GatherPointStore* records = nullptr;
+        std::size_t begin = 0;
+        std::size_t camera = 0;
+    };
+
+    // `cameraRecords[c]` is camera slot c's full record set; `sources` maps the
+    // index's sources onto them. Every record's footprint is floored at
+    // `minGatherRadius` (the gather's floor) and deposits are kept within
+    // `shutterTime` of its sample time (the gather's temporal window). `index` must
+    // outlive this object. Throws std::runtime_error if a source falls outside its
+    // camera's records.
+    StreamingGather(std::vector<const ProbeGather::GatherPointStore*> cameraRecords,
+                    std::vector<Source> sources,
+                    const ProbeIndex& index,
+                    double minGatherRadius,
+                    float shutterTime);
+
+    StreamingGather(const StreamingGather&) = delete;
+    StreamingGather& operator=(const StreamingGather&) = delete;
+
+    // True when every record of `records` is on a Lambertian or emitter surface —
+    // the views a streaming gather renders exactly.
+    static bool supports(const ProbeGather::GatherPointStore& records,
+                         const MaterialLibrary& materials);
+
+    // Fold one kept bounce into every record whose footprint it lands in. Returns
+    // true if at least one record took it. `scratch` is the caller's reusable
+    // ProbeIndex query buffer. Safe to call concurrently.
+    bool deposit(const RawBounce& bounce, std::vector<ProbeIndex::ProbeRef>& scratch) noexcept;
+
+    // Bounces deposit() accepted so far.
+    std::size_t depositCount() const noexcept { return m_deposits.load(); }
+
+    // Write camera slot `camera`'s records into `buffer`: per record
+    //   throughput · (4/pi) · f · ΣΦ / (pi r²) · sampleWeight
+    // exactly as ProbeGather::run would have gathered it. Call after the photon pass.
+    ProbeGather::Result resolve(std::size_t camera,
+                                const std::shared_ptr<Camera>& view,
+                                const MaterialLibrary& materials,
+                                Buffer& buffer) const;
+
+    // Bytes of per-record state (accumulators plus unpacked record data).
+    std::size_t memoryBytes() const noexcept;
+
+private:
+    // The per-record fields the deposit test reads, unpacked once up front.
+    struct Target
+    {
+        float nx = 0.0f, ny = 0.0f, nz = 0.0f;  // record normal
+        float radius = 0.0f;                    // floored footprint radius
+        float time = 0.0f;                      // sample time
+        bool emitter = false;
+    };
+
+    struct CameraState
+    {
+        const ProbeGather::GatherPointStore* records = nullptr;
+        std::vector<Target> targets;
+        std::unique_ptr<std::atomic<float>[]> flux;  // 3 channels per record
+    };
+
+    const ProbeIndex& m_index;
+    std::vector<Source> m_sources;
+    std::vector<CameraState> m_cameras;
+    float m_timeHalfWindow;
+    double m_searchRadius = 0.0;  // the largest floored footprint radius
+    std::atomic<std::size_t> m_deposits{0};
+};
@@ -38,6 +38,8 @@ public:
     Tree(const std::vector<T>& objects, size_t pageSize = 1);
 
     std::shared_ptr<Node> root() noexcept;
+    // Bounds of every object in the tree (the root node's bounds).
+    Bounds bounds() const noexcept;
     size_t size() const noexcept;
     size_t nodeCount() const noexcept;
     size_t nodeDepth() const noexcept;
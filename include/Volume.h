@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Bounds.h"
 #include "Hit.h"
 #include "Ray.h"
 #include "Object.h"
@@ -32,6 +33,18 @@ public:
     std::optional<Hit> castRayAt(const Ray& ray, std::vector<Hit>& castBuffer,
                                   float time, const AnimationQuery* animation) const;
 
+    // Axis-aligned bounds of the surface in its OWN (untransformed) frame — the frame
+    // castTransformedRay intersects in. std::nullopt means unbounded (an infinite
+    // plane) or unknown; callers must then assume the volume can be anywhere.
+    virtual std::optional<Bounds> localBounds() const;
+
+    // World-space bounds swept by the volume while `animation` moves it over
+    // [begin, end]: the local bounds' corners placed at evenly spaced times across
+    // the interval, padded by the largest corner step between consecutive times so
+    // the motion between samples stays inside. std::nullopt when localBounds() is
+    // unbounded.
+    std::optional<Bounds> sweptBounds(float begin, float end, const AnimationQuery* animation) const;
+
 protected:
     virtual std::optional<Hit> castTransformedRay(const Ray& ray, std::vector<Hit>& castBuffer) const;
 
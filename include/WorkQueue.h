@@ -44,6 +44,12 @@ public:
 
     WorkQueue(size_t size);
 
+    // Empty the queue in place for another photon pass, keeping its slots (already
+    // faulted in) instead of reallocating them. Whatever a previous pass left in it
+    // — an aborted pass's photons, a worker's unreleased block — is dropped. Only
+    // call it while no worker holds the queue.
+    void reset();
+
     Block initialize(size_t count);
     void ready(Block block);
     Block fetch(size_t count);
@@ -14,6 +14,7 @@
 #include "Object.h"
 #include "Photon.h"
 #include "RandomGenerator.h"
+#include "StreamingGather.h"
 #include "Volume.h"
 #include "WorkQueue.h"
 
@@ -120,6 +121,10 @@ public:
     // null, the worker uses the legacy density-grid deposit + camera splat path.
     std::shared_ptr<BounceStore> bounceStore;
     std::shared_ptr<ProbeIndex> probeIndex;
+    // Streaming gather ($streamingGather). When set (with `probeIndex`), a kept
+    // bounce is folded straight into the per-record sums of the records it lands on
+    // instead of appended to `bounceStore`, which may then be null.
+    std::shared_ptr<StreamingGather> streamingGather;
     // Continuous-time transform oracle (vision doc pillar 1). Default initialization is
     // a StaticAnimationQuery — every transformAt() call returns the scene-load transform
     // regardless of time. Workers currently read object positions through the existing
@@ -211,6 +216,7 @@ private:
 
     std::vector<Hit> m_castBuffer;
     std::vector<PhotonHit> m_volumeHitBuffer;
+    std::vector<ProbeIndex::ProbeRef> m_probeRefs;
 
     std::exception_ptr m_exception;
 };
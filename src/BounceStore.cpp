@@ -1,11 +1,196 @@
 #include "BounceStore.h"
 
+#if RAY_TRACER_HAS_BOUNCE_SPILL
+#  include <sys/mman.h>
+#  include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
 #include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#if RAY_TRACER_HAS_BOUNCE_SPILL
+namespace
+{
+
+// Create a sparse scratch file of `bytes` in `directory` and map it shared,
+// read-write. The file is unlinked as soon as it is mapped, so it never
+// outlives the mapping (or a crashed render) on disk.
+RawBounce* mapScratchFile(const std::filesystem::path& directory, std::size_t bytes)
+{
+    std::string pattern = (directory / "ray-tracer-bounces-XXXXXX").string();
+    const int fd = ::mkstemp(pattern.data());
+    if (fd < 0)
+    {
+        throw std::runtime_error("BounceStore: cannot create spill file in " +
+                                 directory.string() + ": " + std::strerror(errno));
+    }
+    ::unlink(pattern.c_str());
+
+    void* mapped = MAP_FAILED;
+    if (::ftruncate(fd, static_cast<off_t>(bytes)) == 0)
+    {
+        mapped = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    const int mapError = errno;
+    ::close(fd);
+    if (mapped == MAP_FAILED)
+    {
+        throw std::runtime_error("BounceStore: cannot map " + std::to_string(bytes) +
+                                 " B spill file: " + std::strerror(mapError));
+    }
+    return static_cast<RawBounce*>(mapped);
+}
+
+// Drop the whole pages inside [begin, begin + bytes) from this process's
+// mapping. They stay (dirty) in the page cache, where the kernel writes them
+// back to the scratch file and evicts them under pressure.
+void releasePages(const void* begin, std::size_t bytes)
+{
+    const std::size_t pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const auto first = reinterpret_cast<std::uintptr_t>(begin);
+    const std::uintptr_t alignedBegin = (first + pageSize - 1) / pageSize * pageSize;
+    const std::uintptr_t alignedEnd = (first + bytes) / pageSize * pageSize;
+    if (alignedEnd > alignedBegin)
+    {
+        ::madvise(reinterpret_cast<void*>(alignedBegin), alignedEnd - alignedBegin, MADV_DONTNEED);
+    }
+}
+
+}
+#endif
 
 BounceStore::BounceStore(std::size_t capacity)
-    : m_records(capacity)
+    : m_segmentCount((capacity + kSegmentRecords - 1) >> kSegmentShift)
     , m_capacity(capacity)
+    , m_residentSegments(m_segmentCount)
+{
+    m_segments = std::make_unique<std::atomic<RawBounce*>[]>(m_segmentCount);
+    for (std::size_t i = 0; i < m_segmentCount; ++i)
+    {
+        m_segments[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+BounceStore::BounceStore(std::size_t capacity, std::size_t residentBytes,
+                         const std::filesystem::path& spillDirectory)
+    : BounceStore(capacity)
+{
+    const std::size_t segmentBytes = kSegmentRecords * sizeof(RawBounce);
+    m_residentSegments = std::max<std::size_t>(1, residentBytes / segmentBytes);
+    if (m_residentSegments >= m_segmentCount)
+    {
+        m_residentSegments = m_segmentCount;
+        return;  // the whole ceiling fits the resident budget; nothing to spill
+    }
+
+#if RAY_TRACER_HAS_BOUNCE_SPILL
+    // One sparse scratch file covers every segment past the resident budget.
+    m_spillDirectory = spillDirectory;
+    const std::size_t spillSegments = m_segmentCount - m_residentSegments;
+    m_spillMappedBytes = spillSegments * segmentBytes;
+    m_spillBase = mapScratchFile(spillDirectory, m_spillMappedBytes);
+
+    // Spilled segments need no commit step: their table slots point straight into
+    // the mapping (the file is sparse, so untouched segments cost no disk either).
+    m_spillFill = std::make_unique<std::atomic<std::size_t>[]>(spillSegments);
+    for (std::size_t i = 0; i < spillSegments; ++i)
+    {
+        m_spillFill[i].store(0, std::memory_order_relaxed);
+        m_segments[m_residentSegments + i].store(m_spillBase + i * kSegmentRecords,
+                                                 std::memory_order_relaxed);
+    }
+#else
+    (void)spillDirectory;
+    throw std::runtime_error("BounceStore: spill mode ($bounceStoreResidentMiB) is not supported "
+                             "on this platform; leave it at 0 and size $bounceStoreCapacity "
+                             "to fit in RAM");
+#endif
+}
+
+BounceStore::~BounceStore()
 {
+    for (std::size_t i = 0; i < m_residentSegments; ++i)
+    {
+        delete[] m_segments[i].load(std::memory_order_relaxed);
+    }
+#if RAY_TRACER_HAS_BOUNCE_SPILL
+    if (m_spillBase)
+    {
+        ::munmap(m_spillBase, m_spillMappedBytes);
+    }
+#endif
+}
+
+void BounceStore::reset()
+{
+    if (m_spillBase)
+    {
+        throw std::runtime_error("BounceStore::reset: a spill store cannot be reset");
+    }
+    m_writeCursor.store(0);
+    m_mergedAway = 0;
+    m_cellSize = 1.0;
+    m_invCellSize = 1.0;
+    m_cells.clear();
+    m_timeBins = 1;
+    m_timeMin = 0.0f;
+    m_sliceScale = 0.0;
+    m_sliceWidth = 0.0;
+    m_bucketEnd.clear();
+}
+
+std::size_t BounceStore::segmentLength(std::size_t segment) const noexcept
+{
+    const std::size_t begin = segment << kSegmentShift;
+    const std::size_t remaining = m_capacity - begin;
+    return remaining < kSegmentRecords ? remaining : kSegmentRecords;
+}
+
+RawBounce* BounceStore::commitSegment(std::size_t segment) noexcept
+{
+    RawBounce* existing = m_segments[segment].load(std::memory_order_acquire);
+    if (existing)
+    {
+        return existing;
+    }
+
+    // First writer into this segment: allocate and try to publish. Several
+    // workers can race here at a segment boundary; exactly one CAS wins and the
+    // others free their copy. (Out-of-memory here terminates, as append() is
+    // noexcept; `capacity` is the knob that keeps the commit under the machine.)
+    RawBounce* fresh = new RawBounce[segmentLength(segment)];
+    if (m_segments[segment].compare_exchange_strong(existing, fresh,
+                                                    std::memory_order_acq_rel,
+                                                    std::memory_order_acquire))
+    {
+        m_committedSegments.fetch_add(1, std::memory_order_relaxed);
+        return fresh;
+    }
+    delete[] fresh;
+    return existing;
+}
+
+void BounceStore::noteSpilledWrite(std::size_t segment) noexcept
+{
+    const std::size_t spillIndex = segment - m_residentSegments;
+    const std::size_t written = m_spillFill[spillIndex].fetch_add(1, std::memory_order_acq_rel) + 1;
+    if (written == 1)
+    {
+        m_spilledSegments.fetch_add(1, std::memory_order_relaxed);
+    }
+#if RAY_TRACER_HAS_BOUNCE_SPILL
+    if (written == segmentLength(segment))
+    {
+        // Sealed: no worker writes here again, so its pages can leave the process.
+        releasePages(m_spillBase + spillIndex * kSegmentRecords,
+                     segmentLength(segment) * sizeof(RawBounce));
+    }
+#endif
 }
 
 bool BounceStore::append(const RawBounce& record) noexcept
@@ -15,19 +200,38 @@ bool BounceStore::append(const RawBounce& record) noexcept
     {
         return false;  // budget exhausted; record dropped (counted via attemptedCount)
     }
-    m_records[slot] = record;
+    const std::size_t segmentIndex = slot >> kSegmentShift;
+    RawBounce* segment = commitSegment(segmentIndex);
+    segment[slot & (kSegmentRecords - 1)] = record;
+    if (segmentIndex >= m_residentSegments)
+    {
+        noteSpilledWrite(segmentIndex);
+    }
     return true;
 }
 
 std::size_t BounceStore::size() const noexcept
 {
     const std::size_t claimed = m_writeCursor.load();
-    return claimed < m_capacity ? claimed : m_capacity;
+    return (claimed < m_capacity ? claimed : m_capacity) - m_mergedAway;
 }
 
 std::size_t BounceStore::memoryBytes() const noexcept
 {
-    return m_capacity * sizeof(RawBounce);
+    // Every committed resident segment is full-length except possibly the last
+    // segment of the store, which is trimmed to the capacity.
+    std::size_t records = m_committedSegments.load() * kSegmentRecords;
+    const std::size_t last = m_segmentCount - 1;
+    if (m_segmentCount > 0 && last < m_residentSegments && m_segments[last].load() != nullptr)
+    {
+        records -= kSegmentRecords - segmentLength(last);
+    }
+    return records * sizeof(RawBounce) + m_segmentCount * sizeof(std::atomic<RawBounce*>);
+}
+
+std::size_t BounceStore::spilledBytes() const noexcept
+{
+    return m_spilledSegments.load() * kSegmentRecords * sizeof(RawBounce);
 }
 
 BounceStore::CellKey BounceStore::cellOf(const Vector& p) const noexcept
@@ -39,17 +243,189 @@ BounceStore::CellKey BounceStore::cellOf(const Vector& p) const noexcept
     };
 }
 
-void BounceStore::buildIndex(double cellSize)
+std::size_t BounceStore::timeBinOf(float time) const noexcept
+{
+    if (m_timeBins <= 1 || time == RawBounce::kTimelessDeposit)
+    {
+        return 0;
+    }
+    const double slice = std::floor((static_cast<double>(time) - m_timeMin) * m_sliceScale);
+    const double last = static_cast<double>(m_timeBins - 2);
+    return 1 + static_cast<std::size_t>(std::clamp(slice, 0.0, last));
+}
+
+std::size_t BounceStore::bucketOf(const RawBounce& record) const
+{
+    return m_cells.find(cellOf(record.position()))->second.bucket + timeBinOf(record.time);
+}
+
+void BounceStore::buildIndex(double cellSize, std::size_t timeSlices)
 {
     m_cellSize = cellSize > 0.0 ? cellSize : 1.0;
     m_invCellSize = 1.0 / m_cellSize;
     m_cells.clear();
+    m_bucketEnd.clear();
+    m_timeBins = 1;
 
+    // Time slicing needs a finite span to cut: find the stored deposits' time range
+    // (timeless deposits aside). One shared time — a static frame — leaves one bin.
     const std::size_t count = size();
+    if (timeSlices > 1)
+    {
+        float lo = std::numeric_limits<float>::infinity();
+        float hi = -std::numeric_limits<float>::infinity();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const float time = (*this)[i].time;
+            if (time != RawBounce::kTimelessDeposit)
+            {
+                lo = std::min(lo, time);
+                hi = std::max(hi, time);
+            }
+        }
+        if (hi > lo)
+        {
+            m_timeBins = timeSlices + 1;
+            m_timeMin = lo;
+            m_sliceWidth = (static_cast<double>(hi) - lo) / static_cast<double>(timeSlices);
+            m_sliceScale = 1.0 / m_sliceWidth;
+        }
+    }
+
+    // Pass 1 (sequential read): count records per cell, and per bucket when time
+    // sliced (m_bucketEnd holds the counts until the layout turns them into ends).
     for (std::size_t i = 0; i < count; ++i)
     {
-        m_cells[cellOf(m_records[i].position())].push_back(i);
+        const RawBounce& record = (*this)[i];
+        const auto [it, inserted] = m_cells.try_emplace(cellOf(record.position()));
+        CellRange& range = it->second;
+        if (inserted)
+        {
+            range.bucket = m_cells.size() - 1;
+            if (m_timeBins > 1)
+            {
+                range.bucket *= m_timeBins;
+                m_bucketEnd.resize(m_bucketEnd.size() + m_timeBins, 0);
+            }
+        }
+        ++range.count;
+        if (m_timeBins > 1)
+        {
+            ++m_bucketEnd[range.bucket + timeBinOf(record.time)];
+        }
+    }
+
+    // Lay the cells out in z/y/x order, so a radius search's row of cells maps
+    // to consecutive runs of slots; a cell's time bins follow in bin order.
+    std::vector<std::pair<CellKey, CellRange*>> ordered;
+    ordered.reserve(m_cells.size());
+    for (auto& [key, range] : m_cells)
+    {
+        ordered.emplace_back(key, &range);
+    }
+    std::sort(ordered.begin(), ordered.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    // `cursor[bucket]` is the bucket's next free slot during the reorder.
+    std::vector<std::size_t> cursor(m_cells.size() * m_timeBins);
+    std::size_t offset = 0;
+    for (auto& [key, range] : ordered)
+    {
+        range->begin = offset;
+        std::uint32_t end = 0;
+        for (std::size_t bin = 0; bin < m_timeBins; ++bin)
+        {
+            cursor[range->bucket + bin] = range->begin + end;
+            if (m_timeBins > 1)
+            {
+                end += m_bucketEnd[range->bucket + bin];
+                m_bucketEnd[range->bucket + bin] = end;
+            }
+        }
+        offset += range->count;
+    }
+
+    if (m_spillBase)
+    {
+        reorderSpilled(count, cursor);
+        return;
+    }
+
+    // Resident store: an in-place bucket permutation (American flag sort). Walk
+    // the buckets in layout order; any record sitting in a bucket's unfilled run
+    // that belongs elsewhere is swapped straight to its own bucket's next free
+    // slot. Each swap settles one record for good, so this is O(count) swaps with
+    // no per-record scratch — only the per-bucket cursors. The order inside a
+    // bucket is a fixed function of the append order, not the append order itself.
+    for (const auto& [key, range] : ordered)
+    {
+        for (std::size_t bin = 0; bin < m_timeBins; ++bin)
+        {
+            const std::size_t bucket = range->bucket + bin;
+            const std::size_t end =
+                range->begin + (m_timeBins > 1 ? m_bucketEnd[bucket] : range->count);
+            std::size_t& next = cursor[bucket];
+            while (next < end)
+            {
+                const std::size_t home = bucketOf(mutableAt(next));
+                if (home == bucket)
+                {
+                    ++next;
+                    continue;
+                }
+                std::swap(mutableAt(next), mutableAt(cursor[home]++));
+            }
+        }
+    }
+}
+
+void BounceStore::reorderSpilled(std::size_t count, std::vector<std::size_t>& cursor)
+{
+#if RAY_TRACER_HAS_BOUNCE_SPILL
+    // Spilled store: permuting in place would be random read-modify-write I/O
+    // against the scratch file, and would re-dirty every page the photon pass
+    // already released. Instead, read the store front to back once and write a
+    // bucketed copy into a fresh scratch file: every record is read once in slot
+    // order and written once, appended to its bucket's run, and no page of the old
+    // file is written again. A resident segment is freed as soon as it has been
+    // read, so the copy never holds more RAM than the store did.
+    const std::size_t usedSegments = (count + kSegmentRecords - 1) >> kSegmentShift;
+    const std::size_t copyBytes = usedSegments * kSegmentRecords * sizeof(RawBounce);
+    RawBounce* copy = mapScratchFile(m_spillDirectory, copyBytes);
+
+    for (std::size_t segment = 0; segment < usedSegments; ++segment)
+    {
+        const RawBounce* records = m_segments[segment].load(std::memory_order_relaxed);
+        const std::size_t begin = segment << kSegmentShift;
+        const std::size_t length = std::min(kSegmentRecords, count - begin);
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            copy[cursor[bucketOf(records[i])]++] = records[i];
+        }
+        if (segment < m_residentSegments)
+        {
+            delete[] records;
+        }
     }
+
+    // The copy replaces both halves of the old store: every segment now lives in
+    // the new file, whose pages are handed to the page cache like sealed ones.
+    ::munmap(m_spillBase, m_spillMappedBytes);
+    releasePages(copy, copyBytes);
+    m_spillBase = copy;
+    m_spillMappedBytes = copyBytes;
+    for (std::size_t segment = 0; segment < m_segmentCount; ++segment)
+    {
+        m_segments[segment].store(segment < usedSegments ? copy + segment * kSegmentRecords : nullptr,
+                                  std::memory_order_relaxed);
+    }
+    m_residentSegments = 0;
+    m_committedSegments.store(0);
+    m_spilledSegments.store(usedSegments);
+#else
+    (void)count;
+    (void)cursor;
+#endif
 }
 
 std::vector<std::size_t> BounceStore::radiusSearch(const Vector& p, double r) const
@@ -77,9 +453,10 @@ std::vector<std::size_t> BounceStore::radiusSearch(const Vector& p, double r) co
                 {
                     continue;
                 }
-                for (const std::size_t index : it->second)
+                const CellRange& range = it->second;
+                for (std::size_t index = range.begin; index < range.begin + range.count; ++index)
                 {
-                    const RawBounce& rec = m_records[index];
+                    const RawBounce& rec = (*this)[index];
                     const double ddx = static_cast<double>(rec.px) - p.x;
                     const double ddy = static_cast<double>(rec.py) - p.y;
                     const double ddz = static_cast<double>(rec.pz) - p.z;
@@ -93,3 +470,265 @@ std::vector<std::size_t> BounceStore::radiusSearch(const Vector& p, double r) co
     }
     return result;
 }
+
+std::vector<std::size_t> BounceStore::radiusSearch(const Vector& p,
+                                                   double r,
+                                                   float time,
+                                                   float timeHalfWindow) const
+{
+    std::vector<std::size_t> result;
+    if (r <= 0.0 || m_cells.empty())
+    {
+        return result;
+    }
+
+    // A slice is taken whole or skipped whole only with a margin past its nominal
+    // bounds, so a record binned across a rounding edge still gets the exact
+    // per-record test; the slices in between are decided by their bounds alone.
+    const double windowLo = static_cast<double>(time) - timeHalfWindow;
+    const double windowHi = static_cast<double>(time) + timeHalfWindow;
+    const double margin =
+        1e-3 * m_sliceWidth + 1e-5 * (1.0 + std::abs(static_cast<double>(time)));
+
+    const double r2 = r * r;
+    const CellKey center = cellOf(p);
+    const std::int64_t reach =
+        static_cast<std::int64_t>(std::ceil(r * m_invCellSize));
+
+    // Append the records of [begin, end) within r of p, testing each record's time
+    // too when `testTime`.
+    const auto scan = [&](std::size_t begin, std::size_t end, bool testTime) {
+        for (std::size_t index = begin; index < end; ++index)
+        {
+            const RawBounce& rec = (*this)[index];
+            if (testTime && rec.time != RawBounce::kTimelessDeposit &&
+                std::abs(rec.time - time) > timeHalfWindow)
+            {
+                continue;
+            }
+            const double ddx = static_cast<double>(rec.px) - p.x;
+            const double ddy = static_cast<double>(rec.py) - p.y;
+            const double ddz = static_cast<double>(rec.pz) - p.z;
+            if (ddx * ddx + ddy * ddy + ddz * ddz <= r2)
+            {
+                result.push_back(index);
+            }
+        }
+    };
+
+    for (std::int64_t dz = -reach; dz <= reach; ++dz)
+    {
+        for (std::int64_t dy = -reach; dy <= reach; ++dy)
+        {
+            for (std::int64_t dx = -reach; dx <= reach; ++dx)
+            {
+                const CellKey key{center.x + dx, center.y + dy, center.z + dz};
+                const auto it = m_cells.find(key);
+                if (it == m_cells.end())
+                {
+                    continue;
+                }
+                const CellRange& range = it->second;
+                if (m_timeBins <= 1)
+                {
+                    scan(range.begin, range.begin + range.count, true);
+                    continue;
+                }
+
+                // Bin 0 holds the timeless deposits, which pass any window.
+                scan(range.begin, range.begin + m_bucketEnd[range.bucket], false);
+                for (std::size_t bin = 1; bin < m_timeBins; ++bin)
+                {
+                    const std::size_t begin = range.begin + m_bucketEnd[range.bucket + bin - 1];
+                    const std::size_t end = range.begin + m_bucketEnd[range.bucket + bin];
+                    if (begin == end)
+                    {
+                        continue;
+                    }
+                    const double sliceLo = m_timeMin + static_cast<double>(bin - 1) * m_sliceWidth;
+                    const double sliceHi = sliceLo + m_sliceWidth;
+                    if (sliceHi + margin < windowLo || sliceLo - margin > windowHi)
+                    {
+                        continue;  // every deposit here is outside the window
+                    }
+                    const bool inside = (sliceLo - margin >= windowLo) && (sliceHi + margin <= windowHi);
+                    scan(begin, end, !inside);
+                }
+            }
+        }
+    }
+    return result;
+}
+
+namespace
+{
+
+// True when `a` lies within the cosine `minCos` of `b`. Two unset (zero) vectors
+// also agree: a deposit without a normal only merges with others without one.
+bool directionsAgree(const Vector& a, const Vector& b, double minCos)
+{
+    const double la = a.magnitude();
+    const double lb = b.magnitude();
+    if (la == 0.0 || lb == 0.0)
+    {
+        return la == lb;
+    }
+    return Vector::dot(a, b) >= minCos * la * lb;
+}
+
+// Normalize a power-weighted direction sum, or leave it unset if it cancelled.
+Vector unitOrZero(const Vector& sum)
+{
+    const double length = sum.magnitude();
+    return length > 0.0 ? sum / length : Vector{0.0, 0.0, 0.0};
+}
+
+}  // namespace
+
+BounceStore::MergeResult BounceStore::mergeDeposits(const MergeTolerance& tolerance)
+{
+    MergeResult result;
+    result.before = size();
+    result.after = result.before;
+    if (tolerance.cellSize <= 0.0 || m_cells.empty())
+    {
+        return result;
+    }
+    const double invMergeCell = 1.0 / tolerance.cellSize;
+
+    // Walk the cells in layout order so the compacted runs stay in that order and
+    // each one only ever moves toward the front of the store.
+    std::vector<CellRange*> layout;
+    layout.reserve(m_cells.size());
+    for (auto& [key, range] : m_cells)
+    {
+        layout.push_back(&range);
+    }
+    std::sort(layout.begin(), layout.end(),
+              [](const CellRange* a, const CellRange* b) { return a->begin < b->begin; });
+
+    // One cluster's seed (the tolerance reference) and power-weighted sums.
+    struct Cluster
+    {
+        Vector seedIncoming;
+        Vector seedNormal;
+        float seedTime = 0.0f;
+        double weight = 0.0;
+        Vector position;
+        Vector incoming;
+        Vector normal;
+        double time = 0.0;
+        Color power{0.0f, 0.0f, 0.0f};
+    };
+    std::vector<Cluster> clusters;
+    std::unordered_map<CellKey, std::vector<std::size_t>, CellKeyHash> subCells;
+
+    std::size_t out = 0;
+    for (CellRange* range : layout)
+    {
+        const std::size_t newBegin = out;
+        std::uint32_t binStart = 0;
+        for (std::size_t bin = 0; bin < m_timeBins; ++bin)
+        {
+            const std::size_t bucket = range->bucket + bin;
+            const std::uint32_t binEnd =
+                m_timeBins > 1 ? m_bucketEnd[bucket] : static_cast<std::uint32_t>(range->count);
+
+            // Cluster the bucket's run. Every record is read before any cluster is
+            // written back, and the write cursor never passes the read range.
+            clusters.clear();
+            subCells.clear();
+            for (std::size_t index = range->begin + binStart; index < range->begin + binEnd; ++index)
+            {
+                const RawBounce& record = (*this)[index];
+                const Vector position = record.position();
+                const Vector incoming = record.incoming();
+                const Vector normal = record.normal();
+                const bool timeless = (record.time == RawBounce::kTimelessDeposit);
+                const CellKey sub{
+                    static_cast<std::int64_t>(std::floor(position.x * invMergeCell)),
+                    static_cast<std::int64_t>(std::floor(position.y * invMergeCell)),
+                    static_cast<std::int64_t>(std::floor(position.z * invMergeCell)),
+                };
+
+                std::vector<std::size_t>& candidates = subCells[sub];
+                Cluster* target = nullptr;
+                for (const std::size_t c : candidates)
+                {
+                    Cluster& cluster = clusters[c];
+                    const bool seedTimeless = (cluster.seedTime == RawBounce::kTimelessDeposit);
+                    const bool timeAgrees =
+                        timeless ? seedTimeless
+                                 : (!seedTimeless &&
+                                    std::abs(record.time - cluster.seedTime) <= tolerance.timeTolerance);
+                    if (timeAgrees &&
+                        directionsAgree(normal, cluster.seedNormal, tolerance.normalCos) &&
+                        directionsAgree(incoming, cluster.seedIncoming, tolerance.directionCos))
+                    {
+                        target = &cluster;
+                        break;
+                    }
+                }
+                if (!target)
+                {
+                    candidates.push_back(clusters.size());
+                    Cluster& cluster = clusters.emplace_back();
+                    cluster.seedIncoming = incoming;
+                    cluster.seedNormal = normal;
+                    cluster.seedTime = record.time;
+                    target = &cluster;
+                }
+
+                // Weight by the summed channels, so a merged deposit sits where its
+                // energy landed (a black deposit still counts, barely).
+                const double weight =
+                    std::max(static_cast<double>(record.power.red) + record.power.green +
+                                 record.power.blue,
+                             std::numeric_limits<double>::min());
+                target->weight += weight;
+                target->position += position * weight;
+                target->incoming += incoming * weight;
+                target->normal += normal * weight;
+                if (!timeless)
+                {
+                    target->time += static_cast<double>(record.time) * weight;
+                }
+                target->power += record.power;
+            }
+
+            for (const Cluster& cluster : clusters)
+            {
+                const float time = (cluster.seedTime == RawBounce::kTimelessDeposit)
+                                       ? RawBounce::kTimelessDeposit
+                                       : static_cast<float>(cluster.time / cluster.weight);
+                mutableAt(out++) = RawBounce{cluster.position / cluster.weight,
+                                             unitOrZero(cluster.incoming),
+                                             unitOrZero(cluster.normal), time, cluster.power};
+            }
+            if (m_timeBins > 1)
+            {
+                m_bucketEnd[bucket] = static_cast<std::uint32_t>(out - newBegin);
+            }
+            binStart = binEnd;
+        }
+        range->begin = newBegin;
+        range->count = out - newBegin;
+    }
+
+    m_mergedAway += result.before - out;
+    result.after = out;
+
+    // Free the resident segments the compacted store no longer reaches.
+    const std::size_t usedSegments = (out + kSegmentRecords - 1) >> kSegmentShift;
+    for (std::size_t segment = usedSegments; segment < m_residentSegments && segment < m_segmentCount;
+         ++segment)
+    {
+        RawBounce* records = m_segments[segment].exchange(nullptr);
+        if (records)
+        {
+            delete[] records;
+            m_committedSegments.fetch_sub(1);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,286 @@
+#include "ExrWriter.h"
+
+#include "Color.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// EXR files are little-endian whatever the host; every multi-byte value goes
+// through these.
+void appendU32(std::vector<unsigned char>& out, std::uint32_t value)
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        out.push_back(static_cast<unsigned char>(value >> (8 * i)));
+    }
+}
+
+void appendU16(std::vector<unsigned char>& out, std::uint16_t value)
+{
+    out.push_back(static_cast<unsigned char>(value));
+    out.push_back(static_cast<unsigned char>(value >> 8));
+}
+
+void appendFloat(std::vector<unsigned char>& out, float value)
+{
+    std::uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    appendU32(out, bits);
+}
+
+void appendU64(std::vector<unsigned char>& out, std::uint64_t value)
+{
+    appendU32(out, static_cast<std::uint32_t>(value));
+    appendU32(out, static_cast<std::uint32_t>(value >> 32));
+}
+
+void appendString(std::vector<unsigned char>& out, const char* text)
+{
+    out.insert(out.end(), text, text + std::strlen(text) + 1);  // with the terminator
+}
+
+// Header attribute: name, type name, byte size, then the value the caller appends.
+void beginAttribute(std::vector<unsigned char>& out, const char* name, const char* type,
+                    std::uint32_t size)
+{
+    appendString(out, name);
+    appendString(out, type);
+    appendU32(out, size);
+}
+
+void appendBox(std::vector<unsigned char>& out, const char* name, std::uint32_t width,
+               std::uint32_t height)
+{
+    beginAttribute(out, name, "box2i", 16);
+    appendU32(out, 0);
+    appendU32(out, 0);
+    appendU32(out, width - 1);
+    appendU32(out, height - 1);
+}
+
+// The EXR zlib schemes deflate the block after splitting its bytes into even and
+// odd halves and delta-coding them, which lines up the slowly varying high bytes
+// of neighbouring values.
+void predictAndInterleave(const std::vector<unsigned char>& raw, std::vector<unsigned char>& out)
+{
+    const std::size_t n = raw.size();
+    out.resize(n);
+    std::size_t even = 0;
+    std::size_t odd = (n + 1) / 2;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        out[(i % 2 == 0) ? even++ : odd++] = raw[i];
+    }
+    int previous = n > 0 ? out[0] : 0;
+    for (std::size_t i = 1; i < n; ++i)
+    {
+        const int current = out[i];
+        out[i] = static_cast<unsigned char>(current - previous + (128 + 256));
+        previous = current;
+    }
+}
+
+}  // namespace
+
+std::uint16_t ExrWriter::toHalf(float value) noexcept
+{
+    std::uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const std::uint32_t sign = (bits >> 16) & 0x8000u;
+    const int exponent = static_cast<int>((bits >> 23) & 0xffu);
+    std::uint32_t mantissa = bits & 0x7fffffu;
+
+    if (exponent == 0xff)
+    {
+        return static_cast<std::uint16_t>(sign | 0x7c00u | (mantissa != 0 ? 0x200u : 0u));
+    }
+    const int halfExponent = exponent - 127 + 15;
+    if (halfExponent >= 31)
+    {
+        return static_cast<std::uint16_t>(sign | 0x7c00u);
+    }
+    if (halfExponent <= 0)
+    {
+        // Subnormal half (or zero): the implicit bit joins the mantissa.
+        if (halfExponent < -10)
+        {
+            return static_cast<std::uint16_t>(sign);
+        }
+        mantissa |= 0x800000u;
+        const int shift = 14 - halfExponent;
+        std::uint32_t half = mantissa >> shift;
+        const std::uint32_t rest = mantissa & ((1u << shift) - 1u);
+        const std::uint32_t halfway = 1u << (shift - 1);
+        if (rest > halfway || (rest == halfway && (half & 1u)))
+        {
+            ++half;
+        }
+        return static_cast<std::uint16_t>(sign | half);
+    }
+    std::uint32_t half = (static_cast<std::uint32_t>(halfExponent) << 10) | (mantissa >> 13);
+    const std::uint32_t rest = mantissa & 0x1fffu;
+    if (rest > 0x1000u || (rest == 0x1000u && (half & 1u)))
+    {
+        ++half;  // a carry into the exponent is still the right rounding (up to infinity)
+    }
+    return static_cast<std::uint16_t>(sign | half);
+}
+
+void ExrWriter::writeBuffer(const std::filesystem::path& path, const Buffer& buffer,
+                            const Options& options)
+{
+    const std::size_t width = buffer.width();
+    const std::size_t height = buffer.height();
+    if (width == 0 || height == 0)
+    {
+        throw std::runtime_error("ExrWriter: empty buffer for " + path.generic_string());
+    }
+
+    const std::filesystem::path parent = path.parent_path();
+    if (!parent.empty())
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(parent, ec);
+    }
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        throw std::runtime_error("ExrWriter: cannot write " + path.generic_string());
+    }
+
+    // ===== Header
+    const std::uint32_t pixelType = options.halfFloat ? 1u : 2u;  // HALF : FLOAT
+    std::vector<unsigned char> header;
+    appendU32(header, 20000630u);  // magic
+    appendU32(header, 2u);         // version 2, single-part scanline
+    beginAttribute(header, "channels", "chlist", 3 * 18 + 1);
+    for (const char* channel : {"B", "G", "R"})  // EXR keeps channels in name order
+    {
+        appendString(header, channel);
+        appendU32(header, pixelType);
+        appendU32(header, 0);  // pLinear + reserved
+        appendU32(header, 1);  // x sampling
+        appendU32(header, 1);  // y sampling
+    }
+    header.push_back(0);
+    beginAttribute(header, "compression", "compression", 1);
+    header.push_back(static_cast<unsigned char>(options.compression));
+    appendBox(header, "dataWindow", static_cast<std::uint32_t>(width),
+              static_cast<std::uint32_t>(height));
+    appendBox(header, "displayWindow", static_cast<std::uint32_t>(width),
+              static_cast<std::uint32_t>(height));
+    beginAttribute(header, "lineOrder", "lineOrder", 1);
+    header.push_back(0);  // INCREASING_Y
+    beginAttribute(header, "pixelAspectRatio", "float", 4);
+    appendFloat(header, 1.0f);
+    beginAttribute(header, "screenWindowCenter", "v2f", 8);
+    appendFloat(header, 0.0f);
+    appendFloat(header, 0.0f);
+    beginAttribute(header, "screenWindowWidth", "float", 4);
+    appendFloat(header, 1.0f);
+    if (options.saturationLuminance > 0.0)
+    {
+        beginAttribute(header, "saturationLuminance", "float", 4);
+        appendFloat(header, static_cast<float>(options.saturationLuminance));
+    }
+    header.push_back(0);
+
+    // ===== Offset table, filled in once the blocks are written
+    const std::size_t linesPerBlock = (options.compression == ExrCompression::Zip) ? 16 : 1;
+    const std::size_t blockCount = (height + linesPerBlock - 1) / linesPerBlock;
+    out.write(reinterpret_cast<const char*>(header.data()),
+              static_cast<std::streamsize>(header.size()));
+    const std::streamoff tableStart = out.tellp();
+    std::vector<unsigned char> table(blockCount * 8, 0);
+    std::vector<std::uint64_t> offsets(blockCount, 0);
+    out.write(reinterpret_cast<const char*>(table.data()),
+              static_cast<std::streamsize>(table.size()));
+
+    // ===== Scanline blocks. Image row r is buffer row height-1-r read right to
+    // left, as tonemapBufferToImage lays out the PNG; each row holds all of B,
+    // then G, then R.
+    const float halfMax = 65504.0f;
+    std::vector<unsigned char> raw;
+    std::vector<unsigned char> predicted;
+    std::vector<unsigned char> packed;
+    std::vector<Color> row(width);
+    for (std::size_t block = 0; block < blockCount; ++block)
+    {
+        const std::size_t firstLine = block * linesPerBlock;
+        const std::size_t lines = std::min(linesPerBlock, height - firstLine);
+        raw.clear();
+        for (std::size_t line = firstLine; line < firstLine + lines; ++line)
+        {
+            const std::size_t y = height - 1 - line;
+            for (std::size_t x = 0; x < width; ++x)
+            {
+                row[x] = buffer.fetchColor({width - 1 - x, y});
+            }
+            for (float Color::*channel : {&Color::blue, &Color::green, &Color::red})
+            {
+                for (const Color& color : row)
+                {
+                    const float value = color.*channel;
+                    if (options.halfFloat)
+                    {
+                        appendU16(raw, toHalf(std::clamp(value, -halfMax, halfMax)));
+                    }
+                    else
+                    {
+                        appendFloat(raw, value);
+                    }
+                }
+            }
+        }
+
+        const std::vector<unsigned char>* data = &raw;
+        if (options.compression != ExrCompression::None)
+        {
+            predictAndInterleave(raw, predicted);
+            uLongf packedSize = compressBound(static_cast<uLong>(predicted.size()));
+            packed.resize(packedSize);
+            if (compress(packed.data(), &packedSize, predicted.data(),
+                         static_cast<uLong>(predicted.size())) != Z_OK)
+            {
+                throw std::runtime_error("ExrWriter: zlib failed on " + path.generic_string());
+            }
+            // A block that does not shrink is stored as it is, as EXR readers expect.
+            if (packedSize < raw.size())
+            {
+                packed.resize(packedSize);
+                data = &packed;
+            }
+        }
+
+        offsets[block] = static_cast<std::uint64_t>(out.tellp());
+        std::vector<unsigned char> prefix;
+        appendU32(prefix, static_cast<std::uint32_t>(firstLine));
+        appendU32(prefix, static_cast<std::uint32_t>(data->size()));
+        out.write(reinterpret_cast<const char*>(prefix.data()),
+                  static_cast<std::streamsize>(prefix.size()));
+        out.write(reinterpret_cast<const char*>(data->data()),
+                  static_cast<std::streamsize>(data->size()));
+    }
+
+    table.clear();
+    for (const std::uint64_t offset : offsets)
+    {
+        appendU64(table, offset);
+    }
+    out.seekp(tableStart);
+    out.write(reinterpret_cast<const char*>(table.data()),
+              static_cast<std::streamsize>(table.size()));
+    if (!out.flush())
+    {
+        throw std::runtime_error("ExrWriter: cannot write " + path.generic_string());
+    }
+}
@@ -0,0 +1,148 @@
+#include "FramePipeline.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+FramePipeline::Stats FramePipeline::run(std::size_t first, std::size_t last, const Limits& limits,
+                                        const Begin& begin)
+{
+    Stats stats;
+    if (last < first)
+    {
+        return stats;
+    }
+
+    if (limits.depth <= 1)
+    {
+        for (std::size_t frame = first; frame <= last; ++frame)
+        {
+            Tail tail = begin(frame);
+            stats.peakFrames = 1;
+            stats.peakBytes = std::max(stats.peakBytes, tail.bytes);
+            tail.gather();
+            tail.output();
+        }
+        return stats;
+    }
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<Tail> queue;
+    std::size_t inFlight = 0;  // begun, output not yet finished
+    std::size_t bytes = 0;     // their Tail::bytes
+    bool finished = false;     // no more frames will be queued
+    std::exception_ptr tailError;
+
+    // The tail thread: gather and output each queued frame in order. After a
+    // failure it drops the rest, so no later frame is written.
+    std::thread tailThread([&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            changed.wait(lock, [&]() { return !queue.empty() || finished; });
+            if (queue.empty())
+            {
+                return;
+            }
+            Tail tail = std::move(queue.front());
+            queue.pop_front();
+            if (!tailError)
+            {
+                lock.unlock();
+                std::exception_ptr error;
+                try
+                {
+                    tail.gather();
+                    tail.output();
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+                // Release the frame's stores before counting it out of the budget.
+                const std::size_t tailBytes = tail.bytes;
+                tail = Tail{};
+                lock.lock();
+                if (error)
+                {
+                    tailError = error;
+                }
+                bytes -= tailBytes;
+            }
+            else
+            {
+                bytes -= tail.bytes;
+            }
+            --inFlight;
+            changed.notify_all();
+        }
+    });
+
+    std::exception_ptr beginError;
+    std::size_t lastBytes = 0;  // the last begun frame's, as the next one's estimate
+    for (std::size_t frame = first; frame <= last; ++frame)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [&]() {
+                if (tailError)
+                {
+                    return true;
+                }
+                if (inFlight >= limits.depth)
+                {
+                    return false;
+                }
+                return limits.memoryBudget == 0 || inFlight == 0 ||
+                       bytes + lastBytes <= limits.memoryBudget;
+            });
+            if (tailError)
+            {
+                break;
+            }
+        }
+
+        Tail tail;
+        try
+        {
+            tail = begin(frame);
+        }
+        catch (...)
+        {
+            beginError = std::current_exception();
+            break;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        lastBytes = tail.bytes;
+        bytes += tail.bytes;
+        ++inFlight;
+        stats.peakFrames = std::max(stats.peakFrames, inFlight);
+        stats.peakBytes = std::max(stats.peakBytes, bytes);
+        queue.push_back(std::move(tail));
+        changed.notify_all();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        finished = true;
+        changed.notify_all();
+    }
+    tailThread.join();
+
+    // A tail that failed belongs to an earlier frame than a failed begin.
+    if (tailError)
+    {
+        std::rethrow_exception(tailError);
+    }
+    if (beginError)
+    {
+        std::rethrow_exception(beginError);
+    }
+    return stats;
+}
@@ -3,6 +3,10 @@
 #include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <type_traits>
+
+static_assert(sizeof(Pixel) == 3 * sizeof(png_uint_16) && std::is_standard_layout_v<Pixel>,
+              "Image::data() hands its Pixels out as packed RGB16");
 
 Image::Image(size_t width, size_t height)
     : m_width(width)
@@ -37,6 +41,11 @@ Pixel& Image::getPixel(size_t x, size_t y) noexcept
     return m_pixels[(y * m_width) + x];
 }
 
+const Pixel* Image::data() const noexcept
+{
+    return m_pixels.data();
+}
+
 void Image::clear()
 {
     std::fill(m_pixels.begin(), m_pixels.end(), 0);
@@ -1,6 +1,7 @@
 #include "LightQueue.h"
 
-void LightQueue::registerLight(const std::string& name, size_t count, double luminousFlux)
+void LightQueue::registerLight(const std::string& name, size_t count, double luminousFlux,
+                               size_t normalizationCount)
 {
     std::scoped_lock<std::mutex> lock(m_mutex);
     // Single-photon model: BAKE the per-photon magnitude = Phi / N at emission, so
@@ -13,12 +14,22 @@ void LightQueue::registerLight(const std::string& name, size_t count, double lum
     // and 10 photons each carrying Phi/10 deposit the same expected total energy,
     // so doubling N halves per-photon magnitude and the image brightness is
     // unchanged (only noise drops). A zero count would divide by zero; guard it.
-    const double perPhotonFlux = (count > 0) ? (luminousFlux / static_cast<double>(count)) : 0.0;
+    const size_t frameCount = (normalizationCount > 0) ? normalizationCount : count;
+    const double perPhotonFlux =
+        (frameCount > 0) ? (luminousFlux / static_cast<double>(frameCount)) : 0.0;
     m_flux.insert_or_assign(name, perPhotonFlux);
     m_photons.insert_or_assign(name, count);
     m_remaining.fetch_add(count);
 }
 
+void LightQueue::reset()
+{
+    std::scoped_lock<std::mutex> lock(m_mutex);
+    m_photons.clear();
+    m_flux.clear();
+    m_remaining.store(0);
+}
+
 size_t LightQueue::remainingPhotons() const
 {
     return m_remaining.load();
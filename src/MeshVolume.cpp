@@ -23,6 +23,15 @@ std::shared_ptr<Mesh> MeshVolume::mesh() const
     return m_mesh;
 }
 
+std::optional<Bounds> MeshVolume::localBounds() const
+{
+    if (!m_mesh)
+    {
+        return std::nullopt;
+    }
+    return m_mesh->bounds();
+}
+
 std::optional<Hit> MeshVolume::castTransformedRay(const Ray& ray, std::vector<Hit>& castBuffer) const
 {
     return m_mesh->castRay(ray, castBuffer);
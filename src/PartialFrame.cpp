@@ -0,0 +1,245 @@
+#include "PartialFrame.h"
+
+#include "Camera.h"
+#include "Color.h"
+#include "Image.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+
+constexpr char kMagic[8] = {'R', 'T', 'P', 'A', 'R', 'T', '1', '\n'};
+constexpr std::uint32_t kByteOrderMarker = 0x01020304u;
+
+void writeU64(std::ofstream& out, std::size_t value)
+{
+    const std::uint64_t v = value;
+    out.write(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+std::runtime_error readError(const std::filesystem::path& path, const char* what)
+{
+    std::string message = "PartialFrame: ";
+    message += path.generic_string();
+    message += ": ";
+    message += what;
+    return std::runtime_error(message);
+}
+
+std::size_t readU64(std::ifstream& in, const std::filesystem::path& path)
+{
+    std::uint64_t v = 0;
+    if (!in.read(reinterpret_cast<char*>(&v), sizeof(v)))
+    {
+        throw readError(path, "truncated header");
+    }
+    return static_cast<std::size_t>(v);
+}
+
+}  // namespace
+
+PartialFrame PartialFrame::fromRender(const RenderResult& render, const RenderSettings& settings,
+                                      std::size_t frame)
+{
+    PartialFrame partial;
+    partial.frame = frame;
+    partial.shardIndex = settings.shardIndex;
+    partial.shardCount = settings.shardCount;
+    partial.photonsPerLight = settings.photonsPerLight;
+    partial.photonsEmitted = render.photonsEmitted;
+    for (const CameraRender& cr : render.cameras)
+    {
+        View view;
+        view.name = cr.outputName;
+        view.width = cr.camera->width();
+        view.height = cr.camera->height();
+        view.saturationLuminance = cr.camera->saturationLuminance();
+        view.radiance.resize(view.width * view.height * 3);
+        if (cr.buffer)
+        {
+            for (std::size_t y = 0; y < view.height; ++y)
+            {
+                for (std::size_t x = 0; x < view.width; ++x)
+                {
+                    const Color c = cr.buffer->fetchColor({x, y});
+                    float* rgb = &view.radiance[(y * view.width + x) * 3];
+                    rgb[0] = c.red;
+                    rgb[1] = c.green;
+                    rgb[2] = c.blue;
+                }
+            }
+        }
+        partial.views.push_back(std::move(view));
+    }
+    return partial;
+}
+
+void PartialFrame::write(const std::filesystem::path& path) const
+{
+    const std::filesystem::path parent = path.parent_path();
+    if (!parent.empty())
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(parent, ec);
+    }
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        throw std::runtime_error("PartialFrame: cannot write " + path.generic_string());
+    }
+    out.write(kMagic, sizeof(kMagic));
+    out.write(reinterpret_cast<const char*>(&kByteOrderMarker), sizeof(kByteOrderMarker));
+    writeU64(out, frame);
+    writeU64(out, shardIndex);
+    writeU64(out, shardCount);
+    writeU64(out, photonsPerLight);
+    writeU64(out, photonsEmitted);
+    writeU64(out, views.size());
+    for (const View& view : views)
+    {
+        writeU64(out, view.name.size());
+        out.write(view.name.data(), static_cast<std::streamsize>(view.name.size()));
+        writeU64(out, view.width);
+        writeU64(out, view.height);
+        out.write(reinterpret_cast<const char*>(&view.saturationLuminance),
+                  sizeof(view.saturationLuminance));
+        out.write(reinterpret_cast<const char*>(view.radiance.data()),
+                  static_cast<std::streamsize>(view.radiance.size() * sizeof(float)));
+    }
+    if (!out.flush())
+    {
+        throw std::runtime_error("PartialFrame: cannot write " + path.generic_string());
+    }
+}
+
+PartialFrame PartialFrame::read(const std::filesystem::path& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+        throw readError(path, "cannot open");
+    }
+    char magic[sizeof(kMagic)] = {};
+    std::uint32_t marker = 0;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0)
+    {
+        throw readError(path, "not a partial frame");
+    }
+    if (!in.read(reinterpret_cast<char*>(&marker), sizeof(marker)) || marker != kByteOrderMarker)
+    {
+        throw readError(path, "written on a machine of the other byte order");
+    }
+
+    PartialFrame partial;
+    partial.frame = readU64(in, path);
+    partial.shardIndex = readU64(in, path);
+    partial.shardCount = readU64(in, path);
+    partial.photonsPerLight = readU64(in, path);
+    partial.photonsEmitted = readU64(in, path);
+    const std::size_t viewCount = readU64(in, path);
+    for (std::size_t v = 0; v < viewCount; ++v)
+    {
+        View view;
+        view.name.resize(readU64(in, path));
+        in.read(view.name.data(), static_cast<std::streamsize>(view.name.size()));
+        view.width = readU64(in, path);
+        view.height = readU64(in, path);
+        in.read(reinterpret_cast<char*>(&view.saturationLuminance),
+                sizeof(view.saturationLuminance));
+        view.radiance.resize(view.width * view.height * 3);
+        if (!in.read(reinterpret_cast<char*>(view.radiance.data()),
+                     static_cast<std::streamsize>(view.radiance.size() * sizeof(float))))
+        {
+            throw readError(path, "truncated buffer");
+        }
+        partial.views.push_back(std::move(view));
+    }
+    return partial;
+}
+
+PartialFrame PartialFrame::merge(const std::vector<PartialFrame>& shards)
+{
+    if (shards.empty())
+    {
+        throw std::runtime_error("PartialFrame::merge: no shards");
+    }
+    const PartialFrame& first = shards.front();
+    std::vector<bool> seen(first.shardCount, false);
+    PartialFrame whole = first;
+    whole.shardIndex = 0;
+    whole.shardCount = 1;
+    whole.photonsEmitted = 0;
+    for (View& view : whole.views)
+    {
+        std::fill(view.radiance.begin(), view.radiance.end(), 0.0f);
+    }
+
+    for (const PartialFrame& shard : shards)
+    {
+        if (shard.frame != first.frame || shard.shardCount != first.shardCount ||
+            shard.photonsPerLight != first.photonsPerLight ||
+            shard.views.size() != first.views.size())
+        {
+            throw std::runtime_error("PartialFrame::merge: the shards are not of one frame render");
+        }
+        if (shard.shardIndex >= shard.shardCount || seen[shard.shardIndex])
+        {
+            throw std::runtime_error("PartialFrame::merge: shard " +
+                                     std::to_string(shard.shardIndex) + " given twice or out of range");
+        }
+        seen[shard.shardIndex] = true;
+        whole.photonsEmitted += shard.photonsEmitted;
+        for (std::size_t v = 0; v < whole.views.size(); ++v)
+        {
+            View& sum = whole.views[v];
+            const View& part = shard.views[v];
+            if (part.width != sum.width || part.height != sum.height)
+            {
+                throw std::runtime_error("PartialFrame::merge: camera " + std::to_string(v) +
+                                         " differs in size between shards");
+            }
+            for (std::size_t i = 0; i < sum.radiance.size(); ++i)
+            {
+                sum.radiance[i] += part.radiance[i];
+            }
+        }
+    }
+    const std::size_t missing = static_cast<std::size_t>(std::count(seen.begin(), seen.end(), false));
+    if (missing > 0)
+    {
+        throw std::runtime_error("PartialFrame::merge: " + std::to_string(missing) + " of " +
+                                 std::to_string(first.shardCount) + " shards missing");
+    }
+    return whole;
+}
+
+std::shared_ptr<Buffer> PartialFrame::buffer(std::size_t view) const
+{
+    const View& v = views.at(view);
+    auto buffer = std::make_shared<Buffer>(v.width, v.height);
+    for (std::size_t y = 0; y < v.height; ++y)
+    {
+        for (std::size_t x = 0; x < v.width; ++x)
+        {
+            const float* rgb = &v.radiance[(y * v.width + x) * 3];
+            buffer->addColor({x, y}, Color{rgb[0], rgb[1], rgb[2]});
+        }
+    }
+    return buffer;
+}
+
+std::shared_ptr<Image> PartialFrame::image(std::size_t view) const
+{
+    const View& v = views.at(view);
+    auto image = std::make_shared<Image>(v.width, v.height);
+    image->clear();
+    Renderer::tonemapBufferToImage(*buffer(view), *image, static_cast<double>(photonsPerLight),
+                                   v.saturationLuminance);
+    return image;
+}
@@ -1,6 +1,12 @@
 #include "PngWriteSession.h"
 
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
 #include <cstring>
+#include <thread>
 
 namespace
 {
@@ -10,6 +16,229 @@ namespace
 // deep inside png_set_IHDR.
 constexpr uint32_t kMaxDimension = 1000000U;
 
+// Raw bytes per compressed strip: large enough that the restarted deflate window
+// costs little, small enough that a 4K frame makes dozens of strips.
+constexpr size_t kStripBytes = size_t{1} << 20;
+
+// RGB16: six bytes per pixel, the distance the Sub / Average / Paeth filters
+// look back.
+constexpr size_t kBytesPerPixel = 6;
+
+// Filter type bytes (PNG specification, section 9.2).
+enum : png_byte
+{
+    kFilterNone = 0,
+    kFilterSub = 1,
+    kFilterUp = 2,
+    kFilterAverage = 3,
+    kFilterPaeth = 4
+};
+
+// Row `y` of `pixels` big-endian, as the PNG stores it.
+void packRow(const png_uint_16* pixels, uint32_t width, uint32_t y, png_byte* out)
+{
+    const png_uint_16* src = pixels + static_cast<size_t>(y) * width * 3U;
+    for (size_t i = 0; i < static_cast<size_t>(width) * 3U; ++i)
+    {
+        png_save_uint_16(out + i * 2U, src[i]);
+    }
+}
+
+png_byte paethPredictor(int a, int b, int c)
+{
+    const int p = a + b - c;
+    const int pa = std::abs(p - a);
+    const int pb = std::abs(p - b);
+    const int pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc)
+    {
+        return static_cast<png_byte>(a);
+    }
+    return static_cast<png_byte>(pb <= pc ? b : c);
+}
+
+// Filter `row` (above it: `prior`) with `type` into `out`, type byte first.
+// Returns libpng's heuristic cost: the sum of the filtered bytes read as signed.
+size_t filterRow(png_byte type, const png_byte* row, const png_byte* prior, size_t rowBytes,
+                 png_byte* out)
+{
+    out[0] = type;
+    size_t cost = 0;
+    for (size_t i = 0; i < rowBytes; ++i)
+    {
+        const int left = (i >= kBytesPerPixel) ? row[i - kBytesPerPixel] : 0;
+        const int upLeft = (i >= kBytesPerPixel) ? prior[i - kBytesPerPixel] : 0;
+        int predicted = 0;
+        switch (type)
+        {
+        case kFilterSub: predicted = left; break;
+        case kFilterUp: predicted = prior[i]; break;
+        case kFilterAverage: predicted = (left + prior[i]) / 2; break;
+        case kFilterPaeth: predicted = paethPredictor(left, prior[i], upLeft); break;
+        default: break;
+        }
+        const png_byte filtered = static_cast<png_byte>(row[i] - predicted);
+        out[i + 1] = filtered;
+        cost += (filtered < 128) ? filtered : 256U - filtered;
+    }
+    return cost;
+}
+
+// Filter and raw-deflate rows [firstRow, firstRow + rows) into `out`. The last
+// strip finishes the deflate stream; the others end on a sync flush (an empty
+// stored block), so the next strip's stream starts on a byte boundary. `adler`
+// gets the Adler-32 of the filtered bytes.
+bool deflateStrip(const png_uint_16* pixels, uint32_t width, uint32_t firstRow, uint32_t rows,
+                  bool last, std::vector<png_byte>& out, uLong& adler)
+{
+    const size_t rowBytes = static_cast<size_t>(width) * kBytesPerPixel;
+    std::vector<png_byte> prior(rowBytes, 0);  // above the first row: zeros
+    std::vector<png_byte> row(rowBytes);
+    std::vector<png_byte> best(rowBytes + 1);
+    std::vector<png_byte> candidate(rowBytes + 1);
+    if (firstRow > 0)
+    {
+        packRow(pixels, width, firstRow - 1, prior.data());
+    }
+
+    // libpng's defaults for a filtered image.
+    z_stream stream{};
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8, Z_FILTERED) != Z_OK)
+    {
+        return false;
+    }
+    out.resize(deflateBound(&stream, static_cast<uLong>(rows * (rowBytes + 1))) + 16);
+    stream.next_out = out.data();
+    stream.avail_out = static_cast<uInt>(out.size());
+    adler = adler32(0, nullptr, 0);
+
+    bool ok = true;
+    for (uint32_t r = 0; r < rows && ok; ++r)
+    {
+        packRow(pixels, width, firstRow + r, row.data());
+        size_t bestCost = filterRow(kFilterNone, row.data(), prior.data(), rowBytes, best.data());
+        for (const png_byte type : {kFilterSub, kFilterUp, kFilterAverage, kFilterPaeth})
+        {
+            const size_t cost = filterRow(type, row.data(), prior.data(), rowBytes, candidate.data());
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                best.swap(candidate);
+            }
+        }
+        adler = adler32(adler, best.data(), static_cast<uInt>(best.size()));
+
+        const int flush = (r + 1 < rows) ? Z_NO_FLUSH : (last ? Z_FINISH : Z_SYNC_FLUSH);
+        stream.next_in = best.data();
+        stream.avail_in = static_cast<uInt>(best.size());
+        for (;;)
+        {
+            if (stream.avail_out == 0)
+            {
+                const size_t produced = stream.total_out;
+                out.resize(out.size() * 2);
+                stream.next_out = out.data() + produced;
+                stream.avail_out = static_cast<uInt>(out.size() - produced);
+            }
+            const int status = deflate(&stream, flush);
+            if (status == Z_STREAM_ERROR)
+            {
+                ok = false;
+                break;
+            }
+            if ((flush == Z_FINISH) ? (status == Z_STREAM_END) : (stream.avail_out != 0))
+            {
+                break;
+            }
+        }
+        row.swap(prior);
+    }
+    out.resize(stream.total_out);
+    deflateEnd(&stream);
+    return ok;
+}
+
+// Compress the whole image into `strips`: strip streams on up to one thread per
+// core, then the zlib header on the first and the combined Adler-32 on the last,
+// so the strips in order are the zlib stream the IDAT chunks carry.
+bool compressStrips(const png_uint_16* pixels, uint32_t width, uint32_t height,
+                    std::vector<std::vector<png_byte>>& strips) noexcept
+{
+    try
+    {
+        const size_t rowBytes = static_cast<size_t>(width) * kBytesPerPixel;
+        const uint32_t stripRows = static_cast<uint32_t>(
+            std::clamp<size_t>(kStripBytes / rowBytes, 1, height));
+        const size_t stripCount = (height + stripRows - 1) / stripRows;
+        strips.assign(stripCount, {});
+        std::vector<uLong> adlers(stripCount, 0);
+
+        std::atomic<size_t> next{0};
+        std::atomic<bool> failed{false};
+        const auto compress = [&]() {
+            for (size_t s = next.fetch_add(1); s < stripCount; s = next.fetch_add(1))
+            {
+                const uint32_t first = static_cast<uint32_t>(s * stripRows);
+                const uint32_t rows = std::min(stripRows, height - first);
+                try
+                {
+                    if (!deflateStrip(pixels, width, first, rows, s + 1 == stripCount, strips[s],
+                                      adlers[s]))
+                    {
+                        failed = true;
+                    }
+                }
+                catch (...)
+                {
+                    failed = true;
+                }
+            }
+        };
+        const size_t threads =
+            std::min<size_t>(std::max(1U, std::thread::hardware_concurrency()), stripCount);
+        std::vector<std::thread> pool;
+        for (size_t t = 1; t < threads; ++t)
+        {
+            try
+            {
+                pool.emplace_back(compress);
+            }
+            catch (...)
+            {
+                break;  // the threads there are (or this one) take the rest
+            }
+        }
+        compress();
+        for (auto& thread : pool)
+        {
+            thread.join();
+        }
+        if (failed)
+        {
+            return false;
+        }
+
+        uLong adler = adlers[0];
+        for (size_t s = 1; s < stripCount; ++s)
+        {
+            const size_t rows = std::min<size_t>(stripRows, height - s * stripRows);
+            adler = adler32_combine(adler, adlers[s], static_cast<z_off_t>(rows * (rowBytes + 1)));
+        }
+        // CMF 0x78: deflate with a 32K window; FLG 0x9c: default level, check bits.
+        const png_byte header[2] = {0x78, 0x9c};
+        strips.front().insert(strips.front().begin(), header, header + 2);
+        for (int shift = 24; shift >= 0; shift -= 8)
+        {
+            strips.back().push_back(static_cast<png_byte>(adler >> shift));
+        }
+        return true;
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
 }  // namespace
 
 PngWriteSession::PngWriteSession(const std::filesystem::path& path) noexcept
@@ -100,28 +329,43 @@ bool PngWriteSession::valid() const noexcept
 bool PngWriteSession::writeRgb16(uint32_t width, uint32_t height,
                                  const std::vector<png_uint_16>& pixels,
                                  const std::string& title) noexcept
+{
+    // Validate that the pixel buffer matches the 3-channel (RGB) claim; the
+    // pointer overload checks the rest.
+    const size_t expected =
+        static_cast<size_t>(width) * static_cast<size_t>(height) * 3U;
+    if (pixels.size() < expected)
+    {
+        return false;
+    }
+    return writeRgb16(width, height, pixels.data(), title);
+}
+
+bool PngWriteSession::writeRgb16(uint32_t width, uint32_t height,
+                                 const png_uint_16* pixels,
+                                 const std::string& title) noexcept
 {
     if (!valid() || m_written)
     {
         return false;
     }
 
-    // Validate dimensions and that the pixel buffer matches the 3-channel
-    // (RGB) claim before touching libpng.
+    // Validate dimensions before touching libpng.
     if (width == 0 || height == 0 || width > kMaxDimension ||
-        height > kMaxDimension)
+        height > kMaxDimension || pixels == nullptr)
     {
         return false;
     }
-    const size_t expected =
-        static_cast<size_t>(width) * static_cast<size_t>(height) * 3U;
-    if (pixels.size() < expected)
+
+    // All the compression happens here, before any libpng call: its locals are
+    // gone before a longjmp could skip them, and the strips are members.
+    if (!compressStrips(pixels, width, height, m_strips))
     {
         return false;
     }
 
-    // setjmp landing pad: any libpng error longjmps back here. The row buffer
-    // is RAII (std::vector), so unwinding to this point leaks nothing.
+    // setjmp landing pad: any libpng error longjmps back here. Everything
+    // libpng reads below is member storage, so unwinding leaks nothing.
     if (setjmp(png_jmpbuf(m_structPtr)))
     {
         return false;
@@ -146,29 +390,16 @@ bool PngWriteSession::writeRgb16(uint32_t width, uint32_t height,
 
     png_write_info(m_structPtr, m_infoPtr);
 
-    // One contiguous row buffer reused per row: width * 3 channels * 2 bytes.
-    // png_save_uint_16 writes each channel big-endian, matching the previous
-    // writer's on-disk bytes exactly. Held as a member so a libpng longjmp
-    // mid-write does not leak it.
-    const size_t rowBytes = static_cast<size_t>(width) * 3U * 2U;
-    m_rowScratch.assign(rowBytes, 0);
-    for (uint32_t y = 0; y < height; ++y)
+    // One IDAT chunk per strip, then IEND. png_write_end is not used: it
+    // insists on image data having gone through png_write_row.
+    for (const std::vector<png_byte>& strip : m_strips)
     {
-        const png_uint_16* src =
-            pixels.data() + static_cast<size_t>(y) * width * 3U;
-        for (uint32_t x = 0; x < width; ++x)
-        {
-            for (uint32_t k = 0; k < 3U; ++k)
-            {
-                png_save_uint_16(
-                    &m_rowScratch[(static_cast<size_t>(x) * 6U) + (k * 2U)],
-                    src[(static_cast<size_t>(x) * 3U) + k]);
-            }
-        }
-        png_write_row(m_structPtr, m_rowScratch.data());
+        png_write_chunk(m_structPtr, reinterpret_cast<png_const_bytep>("IDAT"),
+                        strip.data(), strip.size());
     }
-
-    png_write_end(m_structPtr, nullptr);
+    png_write_chunk(m_structPtr, reinterpret_cast<png_const_bytep>("IEND"), nullptr, 0);
+    png_write_flush(m_structPtr);
+    m_strips.clear();
     m_written = true;
     return true;
 }
@@ -6,16 +6,24 @@
 #include "Material.h"
 #include "RandomGenerator.h"
 #include "Ray.h"
+#include "StreamingGather.h"
 #include "UnitVector.h"
 #include "Utility.h"
 #include "Vector.h"
 #include "Volume.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
+#include <exception>
 #include <limits>
 #include <optional>
+#include <stdexcept>
+#include <string>
 #include <thread>
+#include <utility>
 
 namespace ProbeGather
 {
@@ -42,8 +50,9 @@ constexpr double kReflectionEpsilon = 1e-3;
 //     may be gathered). A zero shutter collapses the window to ~0 (single instant).
 // Sizing it to the full shutter (not a tight fraction) is the conservative choice
 // that guarantees static parity; the blur itself comes from the per-camera-sample
-// random shutter time integrating poses, not from a tight temporal cut.
-constexpr float kEmitterTimeless = RawBounce::kTimelessDeposit;
+// random shutter time integrating poses, not from a tight temporal cut. The window
+// is applied by BounceStore's time-windowed radiusSearch; a kTimelessDeposit (an
+// emitter patch) passes it at any time.
 
 // Sentinel material index marking a Hit on an emitter (AreaLight) surface. The
 // emitter is not a scene Volume / has no MaterialLibrary entry, so a hit on its
@@ -88,6 +97,14 @@ double firstEmitterHit(const std::vector<EmitterPatch>& patches,
 // the stochastic choice introduces. Mirrors are deterministic (single sample).
 constexpr int kCameraSamplesPerPixel = 16;
 
+// Adaptive camera sampling: a multi-sample pixel (DOF / shutter) first takes this
+// many PILOT samples and takes the rest of its budget only if they disagree (see
+// pilotConverged). The stop is biased toward whatever the pilot saw: a feature
+// covering a fraction f of the pixel's samples is missed by every pilot with
+// probability (1 - f)^n. Eight pilots put that at ~6% for a 30% occluder (four
+// left it at ~24%), at the price of halving at most a 16-sample budget.
+constexpr int kAdaptivePilotSamples = 8;
+
 // Closest visible surface along a ray (mirrors the photon pass first-hit). Emitter
 // patches (if supplied) are intersected alongside scene Volumes, so a camera or
 // specular ray that lands on a light fixture returns an emitter Hit and gathers
@@ -128,11 +145,251 @@ std::optional<Hit> firstHit(const std::vector<std::shared_ptr<Object>>& objects,
 
 }  // namespace
 
+// ===== Compact record store =====
+
+namespace
+{
+
+constexpr std::uint16_t kPackedEmitterMaterial = 0xFFFF;
+
+// Octahedral unit-vector encoding: project onto the |x|+|y|+|z| = 1 octahedron,
+// fold the lower hemisphere over the upper, and quantize the two remaining
+// coordinates to 16 bits each (worst-case angular error ~5e-5 rad).
+double signNotZero(double value) noexcept
+{
+    return value >= 0.0 ? 1.0 : -1.0;
+}
+
+std::uint32_t packUnitVector(const Vector& v) noexcept
+{
+    const double l1 = std::abs(v.x) + std::abs(v.y) + std::abs(v.z);
+    double u = l1 > 0.0 ? v.x / l1 : 0.0;
+    double w = l1 > 0.0 ? v.y / l1 : 0.0;
+    if (v.z < 0.0)
+    {
+        const double foldedU = (1.0 - std::abs(w)) * signNotZero(u);
+        w = (1.0 - std::abs(u)) * signNotZero(w);
+        u = foldedU;
+    }
+    const auto quantize = [](double value) {
+        return static_cast<std::uint32_t>(std::lround((std::clamp(value, -1.0, 1.0) * 0.5 + 0.5) * 65535.0));
+    };
+    return quantize(u) | (quantize(w) << 16);
+}
+
+Vector unpackUnitVector(std::uint32_t packed) noexcept
+{
+    double u = static_cast<double>(packed & 0xFFFFu) / 65535.0 * 2.0 - 1.0;
+    double w = static_cast<double>(packed >> 16) / 65535.0 * 2.0 - 1.0;
+    const double z = 1.0 - std::abs(u) - std::abs(w);
+    if (z < 0.0)
+    {
+        const double unfoldedU = (1.0 - std::abs(w)) * signNotZero(u);
+        w = (1.0 - std::abs(u)) * signNotZero(w);
+        u = unfoldedU;
+    }
+    return Vector::normalized(Vector{u, w, z});
+}
+
+}  // namespace
+
+void GatherPointStore::push_back(const GatherPoint& point)
+{
+    const std::size_t pixel = point.pixel.y * m_width + point.pixel.x;
+    if (point.pixel.x >= m_width || pixel > std::numeric_limits<std::uint32_t>::max())
+    {
+        throw std::runtime_error("GatherPointStore: pixel (" + std::to_string(point.pixel.x) + ", " +
+                                 std::to_string(point.pixel.y) + ") does not fit a 32-bit index at width " +
+                                 std::to_string(m_width));
+    }
+    std::uint16_t material = kPackedEmitterMaterial;
+    if (point.materialIndex != kEmitterMaterial)
+    {
+        if (point.materialIndex >= kPackedEmitterMaterial)
+        {
+            throw std::runtime_error("GatherPointStore: material index " +
+                                     std::to_string(point.materialIndex) + " does not fit 16 bits");
+        }
+        material = static_cast<std::uint16_t>(point.materialIndex);
+    }
+
+    m_x.push_back(static_cast<float>(point.position.x));
+    m_y.push_back(static_cast<float>(point.position.y));
+    m_z.push_back(static_cast<float>(point.position.z));
+    m_normal.push_back(packUnitVector(point.normal));
+    m_viewDir.push_back(packUnitVector(point.viewDir));
+    m_pixel.push_back(static_cast<std::uint32_t>(pixel));
+    m_material.push_back(material);
+    m_throughput.push_back(point.specularThroughput);
+    m_pathLength.push_back(static_cast<float>(point.unfoldedPathLength));
+    m_footprint.push_back(static_cast<float>(point.footprintRadius));
+    m_time.push_back(point.sampleTime);
+    m_weight.push_back(point.sampleWeight);
+}
+
+void GatherPointStore::append(const GatherPointStore& other)
+{
+    const auto appendColumn = [](auto& to, const auto& from) {
+        to.insert(to.end(), from.begin(), from.end());
+    };
+    appendColumn(m_x, other.m_x);
+    appendColumn(m_y, other.m_y);
+    appendColumn(m_z, other.m_z);
+    appendColumn(m_normal, other.m_normal);
+    appendColumn(m_viewDir, other.m_viewDir);
+    appendColumn(m_pixel, other.m_pixel);
+    appendColumn(m_material, other.m_material);
+    appendColumn(m_throughput, other.m_throughput);
+    appendColumn(m_pathLength, other.m_pathLength);
+    appendColumn(m_footprint, other.m_footprint);
+    appendColumn(m_time, other.m_time);
+    appendColumn(m_weight, other.m_weight);
+}
+
+void GatherPointStore::appendRange(const GatherPointStore& other, std::size_t begin, std::size_t end,
+                                   float fromFrameTime, float toFrameTime)
+{
+    const auto appendColumn = [begin, end](auto& to, const auto& from) {
+        to.insert(to.end(), from.begin() + static_cast<std::ptrdiff_t>(begin),
+                  from.begin() + static_cast<std::ptrdiff_t>(end));
+    };
+    appendColumn(m_x, other.m_x);
+    appendColumn(m_y, other.m_y);
+    appendColumn(m_z, other.m_z);
+    appendColumn(m_normal, other.m_normal);
+    appendColumn(m_viewDir, other.m_viewDir);
+    appendColumn(m_pixel, other.m_pixel);
+    appendColumn(m_material, other.m_material);
+    appendColumn(m_throughput, other.m_throughput);
+    appendColumn(m_pathLength, other.m_pathLength);
+    appendColumn(m_footprint, other.m_footprint);
+    appendColumn(m_weight, other.m_weight);
+    // Same offset into the new frame's shutter as into the old one's; a zero
+    // offset (a zero shutter) lands exactly on toFrameTime, as a fresh trace would.
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        m_time.push_back(toFrameTime + (other.m_time[i] - fromFrameTime));
+    }
+}
+
+void GatherPointStore::reserve(std::size_t count)
+{
+    m_x.reserve(count);
+    m_y.reserve(count);
+    m_z.reserve(count);
+    m_normal.reserve(count);
+    m_viewDir.reserve(count);
+    m_pixel.reserve(count);
+    m_material.reserve(count);
+    m_throughput.reserve(count);
+    m_pathLength.reserve(count);
+    m_footprint.reserve(count);
+    m_time.reserve(count);
+    m_weight.reserve(count);
+}
+
+GatherPoint GatherPointStore::operator[](std::size_t index) const
+{
+    GatherPoint point;
+    point.pixel = pixel(index);
+    point.position = position(index);
+    point.normal = unpackUnitVector(m_normal[index]);
+    point.viewDir = unpackUnitVector(m_viewDir[index]);
+    point.materialIndex =
+        (m_material[index] == kPackedEmitterMaterial) ? kEmitterMaterial : m_material[index];
+    point.specularThroughput = m_throughput[index];
+    point.unfoldedPathLength = m_pathLength[index];
+    point.footprintRadius = m_footprint[index];
+    point.sampleTime = m_time[index];
+    point.sampleWeight = m_weight[index];
+    return point;
+}
+
+std::size_t GatherPointStore::memoryBytes() const noexcept
+{
+    const auto columnBytes = [](const auto& column) {
+        return column.capacity() * sizeof(column[0]);
+    };
+    return columnBytes(m_x) + columnBytes(m_y) + columnBytes(m_z) + columnBytes(m_normal) +
+           columnBytes(m_viewDir) + columnBytes(m_pixel) + columnBytes(m_material) +
+           columnBytes(m_throughput) + columnBytes(m_pathLength) + columnBytes(m_footprint) +
+           columnBytes(m_time) + columnBytes(m_weight);
+}
+
 // ===== Probe pass = single camera-side specular tracer =====
 
 namespace
 {
 
+// What the specular tracer needs to know about one material index, resolved ONCE
+// per probe pass: the material itself (a raw pointer — the library outlives the
+// pass, so no shared_ptr refcount traffic per hit), whether it is a delta surface
+// (extend through it) and whether that delta is STOCHASTIC (a dielectric's Fresnel
+// pick — fan into extra samples, no reusable ray differential). Indexed by
+// Hit::material; an index past the table (or a null slot) is a missing material.
+struct MaterialTraits
+{
+    const Material* material = nullptr;
+    bool delta = false;
+    bool stochastic = false;
+};
+
+std::vector<MaterialTraits> resolveMaterialTraits(const MaterialLibrary& materials)
+{
+    std::vector<MaterialTraits> traits(materials.size());
+    for (size_t i = 0; i < traits.size(); ++i)
+    {
+        const std::shared_ptr<Material> material = materials.fetchByIndex(i);
+        if (material)
+        {
+            traits[i].material = material.get();
+            traits[i].delta = material->isDelta();
+            traits[i].stochastic =
+                (dynamic_cast<const DielectricMaterial*>(material.get()) != nullptr);
+        }
+    }
+    return traits;
+}
+
+const MaterialTraits* traitsOf(const std::vector<MaterialTraits>& traits, size_t index) noexcept
+{
+    return (index < traits.size() && traits[index].material) ? &traits[index] : nullptr;
+}
+
+// Everything a tile's camera-side rays passed through, for ProbeReuse, and whether
+// any ray left the scene (an unbounded segment no box holds). Every traced segment
+// is cut into kReachPieces equal pieces and piece i joins box i (a piece lies inside
+// the box of its two ends). One box over whole segments would be useless: every
+// primary ray starts at the eye, so it would span from the eye to the far wall and
+// meet anything moving in front of the camera. Piece by piece the boxes follow the
+// tile's narrow wedge of rays instead.
+struct TileReach
+{
+    std::array<std::optional<Bounds>, ProbeReuse::kReachPieces> pieces;
+    bool escaped = false;
+
+    void addSegment(const Vector& from, const Vector& to)
+    {
+        const Vector step = (to - from) / static_cast<double>(ProbeReuse::kReachPieces);
+        Vector begin = from;
+        for (size_t i = 0; i < ProbeReuse::kReachPieces; ++i)
+        {
+            const Vector end = (i + 1 == ProbeReuse::kReachPieces) ? to : begin + step;
+            Bounds piece{begin};
+            piece += Bounds{end};
+            if (pieces[i])
+            {
+                *pieces[i] += piece;
+            }
+            else
+            {
+                pieces[i] = piece;
+            }
+            begin = end;
+        }
+    }
+};
+
 // Result of walking a camera ray through the delta chain to its first non-delta
 // hit, accumulating throughput and path length along the way.
 struct ExtendResult
@@ -143,6 +400,8 @@ struct ExtendResult
     Vector finalDirection{};       // direction of the last segment (the ray that hit the
                                    //   non-delta surface); wo = -finalDirection
     bool traversedDelta = false;   // passed through at least one delta surface
+    bool traversedStochastic = false;  // ... at least one of them a stochastic (glass) pick
+    bool castFirstSegment = false; // intersected the camera segment itself (no knownFirst)
     bool valid = false;            // false => chain escaped or exceeded the depth cap
 };
 
@@ -150,20 +409,39 @@ struct ExtendResult
 // product of the delta BSDF weights (the specular throughput) and the unfolded path
 // length. This is the irreducible camera-side specular trace (a delta vs a point
 // camera is measure-zero — a mirror must be TRACED, not gathered; DESIGN §6b). It
-// runs ONCE here in the probe pass; the gather does no extension.
+// runs ONCE here in the probe pass; the gather does no extension. `knownFirst`, when
+// given, is `ray`'s already-cast first hit: the walk starts from it instead of
+// intersecting the scene again for the same first segment. `reach`, when given,
+// takes every segment the walk traces.
 ExtendResult extendAndRecord(const std::vector<std::shared_ptr<Object>>& objects,
-                             const MaterialLibrary& materials,
+                             const std::vector<MaterialTraits>& traits,
                              const AnimationQuery* animation,
                              std::vector<Hit>& castBuffer,
                              RandomGenerator& generator,
                              Ray ray,
                              float time,
-                             const std::vector<EmitterPatch>& patches)
+                             const std::vector<EmitterPatch>& patches,
+                             const Hit* knownFirst = nullptr,
+                             TileReach* reach = nullptr)
 {
     ExtendResult out;
     for (int depth = 0; depth < kMaxSpecularDepth; ++depth)
     {
-        std::optional<Hit> hit = firstHit(objects, ray, castBuffer, time, animation, &patches);
+        std::optional<Hit> hit = (depth == 0 && knownFirst)
+            ? std::optional<Hit>(*knownFirst)
+            : firstHit(objects, ray, castBuffer, time, animation, &patches);
+        out.castFirstSegment = out.castFirstSegment || (depth == 0 && !knownFirst);
+        if (reach && !(depth == 0 && knownFirst))  // the caller has the first segment
+        {
+            if (hit)
+            {
+                reach->addSegment(ray.origin, hit->position);
+            }
+            else
+            {
+                reach->escaped = true;
+            }
+        }
         if (!hit)
         {
             return out;  // escaped: invalid
@@ -177,12 +455,12 @@ ExtendResult extendAndRecord(const std::vector<std::shared_ptr<Object>>& objects
             out.valid = true;
             return out;
         }
-        std::shared_ptr<Material> material = materials.fetchByIndex(hit->material);
+        const MaterialTraits* material = traitsOf(traits, hit->material);
         if (!material)
         {
             return out;
         }
-        if (!material->isDelta())
+        if (!material->delta)
         {
             out.hit = *hit;  // reached the first non-delta surface
             out.finalDirection = ray.direction;
@@ -196,8 +474,9 @@ ExtendResult extendAndRecord(const std::vector<std::shared_ptr<Object>>& objects
         // DISCARDED s.weight and kept only the endpoint — the gather had to re-walk
         // the chain to recover it. Now the throughput rides the record.
         out.traversedDelta = true;
+        out.traversedStochastic = out.traversedStochastic || material->stochastic;
         const UnitVector hitNormal = UnitVector::alreadyNormalized(hit->normal);
-        const BSDFSample s = material->sample(ray.direction, hitNormal, generator);
+        const BSDFSample s = material->material->sample(ray.direction, hitNormal, generator);
         if (!s.valid)
         {
             return out;
@@ -236,6 +515,450 @@ ExtendResult extendAndRecord(const std::vector<std::shared_ptr<Object>>& objects
 // call the production code directly). The probe pass + gather call sites use those
 // same definitions — no behavior change.
 
+namespace
+{
+
+// Screen tile edge (in traced pixels, i.e. after the subSample stride) — the unit of
+// parallel probe-pass work. Each tile owns its record vector and its RNG stream.
+constexpr size_t kProbeTileSize = 16;
+
+// Everything the per-pixel probe trace reads that is fixed for the whole pass.
+struct ProbeContext
+{
+    const std::vector<std::shared_ptr<Object>>& objects;
+    const Camera& camera;
+    const std::vector<MaterialTraits>& traits;
+    const AnimationQuery* animation;
+    const std::vector<EmitterPatch>& patches;
+    double pixelHalfAngle;
+    float frameTime;
+    float shutterSpan;
+    bool motionActive;
+    bool dofActive;
+    int cameraSamples;
+    size_t width;
+    // Every pixel is traced (no subSample stride) with ONE fixed primary ray (no
+    // DOF, no shutter samples), so a neighbour's traced chain is exactly the chain
+    // of the ray the reflected differential needs. See ChainEndpoint.
+    bool reuseNeighbourChains;
+    // Multi-sample pixels stop after kAdaptivePilotSamples when the pilot agrees
+    // (never set for a shutter pass over an animated scene; see sceneAnimated).
+    bool adaptiveSamples;
+    // A delta first hit's extension starts from the hit already cast (off only to
+    // A/B the records against a walk that re-casts the camera segment).
+    bool reuseFirstHit;
+};
+
+// Where a pixel's single primary ray ended up after walking its DETERMINISTIC delta
+// chain (or directly, for a non-delta first hit): the first non-delta surface it
+// reached. The probe pass walks pixel rows left to right inside a tile and hands
+// each pixel its left neighbour's endpoint, so a mirror record's reflected ray
+// differential (issue #63) reads the already-traced neighbour's hit instead of
+// re-tracing the neighbour's whole chain. Invalid for a miss, a stochastic (glass)
+// chain, or a pixel not traced in this row of this tile.
+struct ChainEndpoint
+{
+    bool valid = false;
+    std::size_t material = 0;
+    Vector position{};
+    Vector normal{};
+};
+
+// Seed of tile `tile`'s RNG stream: a splitmix64 finalizer over (seed, tile), so
+// neighbouring tiles get decorrelated mt19937 states and a tile's draws depend
+// only on the pass seed and the tile — not on which thread ran it or when.
+std::uint32_t tileSeed(long long seed, size_t tile) noexcept
+{
+    std::uint64_t z = (static_cast<std::uint64_t>(seed) << 32) ^ static_cast<std::uint64_t>(tile);
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return static_cast<std::uint32_t>(z);
+}
+
+// True when a pixel's pilot records (out.points from `begin`) say the rest of its
+// camera samples would add nothing: every pilot sample reached the SAME surface
+// (material) with the same specular throughput, and their positions spread no more
+// than the pixel itself spans there — RMS distance from their centroid within 1.5x
+// the mean gather footprint radius (the sub-pixel spread alone is ~0.8x, so only
+// blur of about a pixel or less passes) — or every pilot sample missed. A pixel
+// that is in focus, static over the shutter and seen directly or through mirrors
+// passes; a blurred, moving or silhouette pixel does not and takes its full budget.
+bool pilotConverged(const GatherPointStore& points, size_t begin, size_t pilotMisses)
+{
+    const size_t count = points.size() - begin;
+    if (count == 0)
+    {
+        return true;
+    }
+    if (pilotMisses > 0)
+    {
+        return false;  // some pilot samples hit, some missed: an edge
+    }
+    const GatherPoint first = points[begin];
+    const float scale = std::max({first.specularThroughput.red, first.specularThroughput.green,
+                                  first.specularThroughput.blue, 1e-6f});
+    Vector centroid = first.position;
+    double radius = first.footprintRadius;
+    for (size_t i = begin + 1; i < points.size(); ++i)
+    {
+        const GatherPoint gp = points[i];
+        if (gp.materialIndex != first.materialIndex ||
+            std::abs(gp.specularThroughput.red - first.specularThroughput.red) > 1e-3f * scale ||
+            std::abs(gp.specularThroughput.green - first.specularThroughput.green) > 1e-3f * scale ||
+            std::abs(gp.specularThroughput.blue - first.specularThroughput.blue) > 1e-3f * scale)
+        {
+            return false;
+        }
+        centroid = centroid + gp.position;
+        radius += gp.footprintRadius;
+    }
+    centroid = centroid / static_cast<double>(count);
+    radius /= static_cast<double>(count);
+
+    double spread2 = 0.0;
+    for (size_t i = begin; i < points.size(); ++i)
+    {
+        const Vector d = points.position(i) - centroid;
+        spread2 += Vector::dot(d, d);
+    }
+    spread2 /= static_cast<double>(count);
+    return spread2 <= (1.5 * radius) * (1.5 * radius);
+}
+
+// True when some geometry the camera sees could change over the shutter: the camera
+// or any Volume has an animation entry. The probe pass then never stops a shutter
+// (motion) pixel early — an occluder that crosses the pixel between the pilot's
+// sample times would otherwise be dropped from the estimate outright, with no
+// pilot disagreement to catch it. Deliberately scene-wide and conservative: being
+// animated, not the distance moved, is what disqualifies the stop.
+bool sceneAnimated(const std::vector<std::shared_ptr<Object>>& objects,
+                   const Camera& camera,
+                   const AnimationQuery* animation,
+                   float frameTime)
+{
+    if (!animation)
+    {
+        return false;
+    }
+    if (animation->transformAt(camera.name(), frameTime))
+    {
+        return true;
+    }
+    for (const auto& object : objects)
+    {
+        if (object->hasType<Volume>() && animation->transformAt(object->name(), frameTime))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Trace one pixel's camera samples and append its surviving records (with their
+// 1/N sampleWeight filled) and diagnostics to `out`. `left` is the left neighbour's
+// chain endpoint (see ChainEndpoint); this pixel's own endpoint is written to `self`.
+// Every segment traced is added to the tile's `reach`.
+void tracePixel(const ProbeContext& ctx,
+                const PixelCoords& coord,
+                RandomGenerator& generator,
+                std::vector<Hit>& castBuffer,
+                const ChainEndpoint& left,
+                ChainEndpoint& self,
+                ProbeResult& out,
+                TileReach& reach)
+{
+    self = ChainEndpoint{};
+
+    // This pixel's camera samples mirror the former gather loop exactly so the
+    // records are an unbiased camera-side estimate: DOF aperture samples
+    // (RealLens) and/or random shutter-time samples (finite shutter); each
+    // draws a sample time and generates its ray at that time (camera pose
+    // resolved at the time — §9e). A dielectric first hit then fans into
+    // kCameraSamplesPerPixel stochastic Fresnel picks (unless DOF already
+    // multisamples); a mirror is one deterministic extension.
+    //
+    // ADAPTIVE: a multi-sample pixel stops after kAdaptivePilotSamples when the
+    // pilot converged (pilotConverged). N in the 1/N sampleWeight is simply the
+    // number of samples actually taken, so the estimate stays a plain average. Any
+    // stochastic (glass) pick in the pilot keeps the full budget: a minority Fresnel
+    // branch the pilot happened to miss must still get its chance to be sampled
+    // (and probed).
+    const int motionSamples = ctx.motionActive ? ctx.cameraSamples : 1;
+    const int dofSamples = ctx.dofActive ? kCameraSamplesPerPixel : 1;
+    const int primarySamples = std::max(dofSamples, motionSamples);
+
+    // Stage the surviving records for THIS pixel so the sampleWeight (1/N
+    // over the pixel's surviving samples) can be filled once N is known.
+    const size_t pixelRecordBegin = out.points.size();
+    const size_t pixelMissBegin = out.misses;
+    bool pixelStochastic = false;
+
+    for (int primary = 0; primary < primarySamples; ++primary)
+    {
+        if (primary == kAdaptivePilotSamples && ctx.adaptiveSamples && !pixelStochastic &&
+            pilotConverged(out.points, pixelRecordBegin, out.misses - pixelMissBegin))
+        {
+            ++out.adaptiveStops;
+            break;
+        }
+
+        const float sampleTime =
+            ctx.motionActive
+                ? ctx.frameTime + static_cast<float>(generator.value(ctx.shutterSpan))
+                : ctx.frameTime;
+
+        const Ray ray = ctx.dofActive
+            ? ctx.camera.generatePrimaryRayAt(coord, sampleTime, ctx.animation, &generator)
+            : ctx.camera.generatePrimaryRayAt(coord, sampleTime, ctx.animation);
+        ++out.cameraRays;
+
+        std::optional<Hit> firstSurface =
+            firstHit(ctx.objects, ray, castBuffer, sampleTime, ctx.animation, &ctx.patches);
+        ++out.firstSegmentCasts;
+        if (!firstSurface)
+        {
+            reach.escaped = true;
+            ++out.misses;
+            continue;
+        }
+        reach.addSegment(ray.origin, firstSurface->position);
+
+        const bool firstIsEmitter = (firstSurface->material == kEmitterMaterial);
+        const MaterialTraits* firstMat =
+            firstIsEmitter ? nullptr : traitsOf(ctx.traits, firstSurface->material);
+        if (!firstIsEmitter && !firstMat)
+        {
+            continue;
+        }
+
+        // DIRECT non-delta first hit: emit a depth-0 record with identity
+        // throughput and the ray-differential footprint (distortion- and
+        // foreshortening-correct).
+        if (firstIsEmitter || !firstMat->delta)
+        {
+            GatherPoint gp;
+            gp.pixel = coord;
+            gp.position = firstSurface->position;
+            gp.normal = firstSurface->normal;
+            gp.viewDir = Vector::normalized(ray.origin - firstSurface->position);
+            gp.materialIndex = firstSurface->material;
+            gp.specularThroughput = Color{1.0f, 1.0f, 1.0f};
+            gp.unfoldedPathLength = firstSurface->distance;
+            gp.footprintRadius = testing::pixelFootprintRadius(
+                ctx.camera, ctx.animation, ctx.pixelHalfAngle, coord, *firstSurface,
+                firstSurface->distance, sampleTime);
+            gp.sampleTime = sampleTime;
+            gp.sampleWeight = 1.0f;  // filled below
+            out.points.push_back(gp);
+            self = ChainEndpoint{true, firstSurface->material, firstSurface->position,
+                                 firstSurface->normal};
+            continue;
+        }
+
+        // DELTA first hit: extend through the specular chain, starting AT the
+        // first hit already in hand (every extension sample shares the camera
+        // segment, so it is never re-cast). Glass is stochastic so fan into extra
+        // Fresnel picks; a mirror is deterministic (single pick).
+        const bool stochasticDelta = firstMat->stochastic;
+        pixelStochastic = pixelStochastic || stochasticDelta;
+        const int extensionSamples =
+            (stochasticDelta && !ctx.dofActive) ? kCameraSamplesPerPixel : 1;
+
+        for (int ext = 0; ext < extensionSamples; ++ext)
+        {
+            const ExtendResult chain = extendAndRecord(
+                ctx.objects, ctx.traits, ctx.animation, castBuffer, generator, ray,
+                sampleTime, ctx.patches, ctx.reuseFirstHit ? &*firstSurface : nullptr, &reach);
+            out.firstSegmentCasts += chain.castFirstSegment ? 1 : 0;
+            pixelStochastic = pixelStochastic || chain.traversedStochastic;
+            if (chain.traversedDelta)
+            {
+                ++out.deltaExtensions;
+            }
+            if (!chain.valid)
+            {
+                ++out.misses;
+                continue;
+            }
+            // wo at a reflected surface is back along the final segment
+            // toward the last specular vertex (= -finalDirection): the same
+            // viewer the old shade() evaluated the reflected BRDF toward.
+            const Vector reflectedView = -chain.finalDirection;
+
+            // issue #63 — reflected ray-differential footprint. Unfold the
+            // ADJACENT pixel's primary ray through the SAME specular chain and,
+            // if it reaches the SAME reflected surface (same material, normal
+            // agrees), use its hit position to tighten the gather disc exactly
+            // like the direct path's differential. Only for a DETERMINISTIC
+            // mirror chain: a stochastic dielectric (glass) chain would make the
+            // adjacent re-walk a different random Fresnel path, so the
+            // differential would be noise — skip it there and keep the
+            // perpendicular (2x-capped) footprint.
+            //
+            // The left neighbour in this row has usually ALREADY walked exactly
+            // that chain, so its endpoint is reused as is. Only at a tile's left
+            // edge, when the neighbour's endpoint is unusable (miss, glass) or
+            // disagrees (different surface), or when rays are not fixed per pixel
+            // (DOF/shutter/subSample), is the neighbour's chain traced here. A
+            // fresh local RNG keeps that walk from perturbing the main sampling
+            // sequence (so the direct/glass paths stay bitwise-deterministic).
+            const auto sameSurface = [&chain](std::size_t material, const Vector& normal) {
+                return material == chain.hit.material &&
+                       Vector::dot(normal, chain.hit.normal) >= 0.5;
+            };
+            Vector adjReflectedHit;
+            bool haveAdjReflected = false;
+            if (!stochasticDelta && ctx.reuseNeighbourChains && left.valid &&
+                sameSurface(left.material, left.normal))
+            {
+                adjReflectedHit = left.position;
+                haveAdjReflected = true;
+                ++out.reusedDifferentials;
+            }
+            else if (!stochasticDelta)
+            {
+                const size_t adjX = (coord.x + 1 < ctx.width) ? coord.x + 1
+                                    : (coord.x > 0)       ? coord.x - 1
+                                                          : coord.x;
+                if (adjX != coord.x)
+                {
+                    const PixelCoords adjCoord{adjX, coord.y};
+                    const Ray adjRay = ctx.dofActive
+                        ? ctx.camera.generatePrimaryRayAt(adjCoord, sampleTime,
+                                                          ctx.animation, &generator)
+                        : ctx.camera.generatePrimaryRayAt(adjCoord, sampleTime,
+                                                          ctx.animation);
+                    RandomGenerator adjGenerator(0xC0FFEEu);
+                    const ExtendResult adjChain = extendAndRecord(
+                        ctx.objects, ctx.traits, ctx.animation, castBuffer,
+                        adjGenerator, adjRay, sampleTime, ctx.patches, nullptr, &reach);
+                    ++out.differentialTraces;
+                    out.firstSegmentCasts += adjChain.castFirstSegment ? 1 : 0;
+                    // Same reflected surface: valid, same material index, and
+                    // normals agree (>= cos 60°) — so we measure spacing ON the
+                    // surface, not across a silhouette / different facet.
+                    if (adjChain.valid && sameSurface(adjChain.hit.material, adjChain.hit.normal))
+                    {
+                        adjReflectedHit = adjChain.hit.position;
+                        haveAdjReflected = true;
+                    }
+                }
+            }
+            // Publish this endpoint for the right neighbour only if the WHOLE
+            // chain was deterministic: a mirror first hit can still pass through
+            // glass further on, and that endpoint is one random Fresnel pick.
+            if (!chain.traversedStochastic)
+            {
+                self = ChainEndpoint{true, chain.hit.material, chain.hit.position,
+                                     chain.hit.normal};
+            }
+
+            GatherPoint gp;
+            gp.pixel = coord;
+            gp.position = chain.hit.position;
+            gp.normal = chain.hit.normal;
+            gp.viewDir = Vector::normalized(reflectedView);
+            gp.materialIndex = chain.hit.material;
+            gp.specularThroughput = chain.throughput;
+            gp.unfoldedPathLength = chain.unfoldedPathLength;
+            gp.footprintRadius = testing::reflectedFootprintRadius(
+                ctx.pixelHalfAngle, chain.unfoldedPathLength, reflectedView,
+                chain.hit, haveAdjReflected ? &adjReflectedHit : nullptr);
+            gp.sampleTime = sampleTime;
+            gp.sampleWeight = 1.0f;  // filled below
+            out.points.push_back(gp);
+        }
+    }
+
+    // sampleWeight = 1 / (surviving samples for this pixel): the average over
+    // the pixel's DOF/shutter/Fresnel samples. A pixel whose every sample
+    // missed contributes no records (and no weight).
+    const size_t survived = out.points.size() - pixelRecordBegin;
+    if (survived > 0)
+    {
+        const float w = 1.0f / static_cast<float>(survived);
+        for (size_t i = pixelRecordBegin; i < out.points.size(); ++i)
+        {
+            out.points.setSampleWeight(i, w);
+        }
+    }
+}
+
+// World bounds the ANIMATED volumes sweep over [begin, end]. An object counts as
+// animated when the query overrides its transform; `unbounded` when one of them has
+// no finite bounds (it could then be anywhere).
+struct AnimatedSweep
+{
+    bool any = false;
+    bool unbounded = false;
+    std::vector<Bounds> bounds;
+
+    // True if any swept box meets any of tile `tile`'s reach pieces in `reach`
+    // (ProbeReuse::tileReach layout).
+    bool reaches(const std::vector<std::optional<Bounds>>& reach, size_t tile) const
+    {
+        if (!any)
+        {
+            return false;
+        }
+        if (unbounded)
+        {
+            return true;
+        }
+        for (size_t i = 0; i < ProbeReuse::kReachPieces; ++i)
+        {
+            const std::optional<Bounds>& piece = reach[tile * ProbeReuse::kReachPieces + i];
+            if (!piece)
+            {
+                continue;
+            }
+            for (const Bounds& swept : bounds)
+            {
+                if (swept.intersects(*piece))
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+};
+
+AnimatedSweep sweepAnimated(const std::vector<std::shared_ptr<Object>>& objects,
+                            const AnimationQuery* animation,
+                            float begin,
+                            float end)
+{
+    AnimatedSweep sweep;
+    if (!animation)
+    {
+        return sweep;
+    }
+    for (const auto& object : objects)
+    {
+        if (!object->hasType<Volume>() || !animation->transformAt(object->name(), begin))
+        {
+            continue;
+        }
+        sweep.any = true;
+        const std::optional<Bounds> swept =
+            std::static_pointer_cast<Volume>(object)->sweptBounds(begin, end, animation);
+        if (swept)
+        {
+            sweep.bounds.push_back(*swept);
+        }
+        else
+        {
+            sweep.unbounded = true;
+        }
+    }
+    return sweep;
+}
+
+}  // namespace
+
 ProbeResult collectGatherPoints(const std::vector<std::shared_ptr<Object>>& objects,
                                 const Camera& camera,
                                 const MaterialLibrary& materials,
@@ -244,11 +967,16 @@ ProbeResult collectGatherPoints(const std::vector<std::shared_ptr<Object>>& obje
                                 float shutterTime,
                                 int cameraSamples,
                                 size_t subSample,
-                                long long seed)
+                                long long seed,
+                                size_t workerCount,
+                                bool adaptiveSamples,
+                                ProbeReuse* reuse,
+                                bool reuseFirstHit)
 {
     ProbeResult result;
     const size_t width = camera.width();
     const size_t height = camera.height();
+    result.points = GatherPointStore(width);
     if (width == 0 || height == 0)
     {
         return result;
@@ -272,199 +1000,218 @@ ProbeResult collectGatherPoints(const std::vector<std::shared_ptr<Object>>& obje
     const bool dofActive = (camera.projection() == Camera::Projection::RealLens) &&
                            (camera.effectiveApertureRadius() > 0.0);
 
-    // The camera-side specular trace is camera-ray-scale and cheap; run it
-    // single-threaded so the record list (and its diagnostics) accumulate without
-    // cross-thread merging. For very large frames this could be parallelized like
-    // the gather; not needed at current resolutions.
-    std::vector<Hit> castBuffer;
-    // Deterministic test mode seeds the camera-side sampling RNG; production passes
-    // seed < 0 -> the random_device-seeded default ctor.
-    RandomGenerator generator = (seed >= 0)
-        ? RandomGenerator(static_cast<std::uint32_t>(seed))
-        : RandomGenerator();
-
-    for (size_t y = 0; y < height; y += stride)
-    {
-        for (size_t x = 0; x < width; x += stride)
-        {
-            const PixelCoords coord{x, y};
-
-            // This pixel's camera samples mirror the former gather loop exactly so the
-            // records are an unbiased camera-side estimate: DOF aperture samples
-            // (RealLens) and/or random shutter-time samples (finite shutter); each
-            // draws a sample time and generates its ray at that time (camera pose
-            // resolved at the time — §9e). A dielectric first hit then fans into
-            // kCameraSamplesPerPixel stochastic Fresnel picks (unless DOF already
-            // multisamples); a mirror is one deterministic extension.
-            const int motionSamples = motionActive ? cameraSamples : 1;
-            const int dofSamples = dofActive ? kCameraSamplesPerPixel : 1;
-            const int primarySamples = std::max(dofSamples, motionSamples);
-
-            // Stage the surviving records for THIS pixel so the sampleWeight (1/N
-            // over the pixel's surviving samples) can be filled once N is known.
-            const size_t pixelRecordBegin = result.points.size();
-
-            for (int primary = 0; primary < primarySamples; ++primary)
-            {
-                const float sampleTime =
-                    motionActive
-                        ? frameTime + static_cast<float>(generator.value(shutterSpan))
-                        : frameTime;
-
-                const Ray ray = dofActive
-                    ? camera.generatePrimaryRayAt(coord, sampleTime, animation, &generator)
-                    : camera.generatePrimaryRayAt(coord, sampleTime, animation);
-                ++result.cameraRays;
-
-                std::optional<Hit> firstSurface =
-                    firstHit(objects, ray, castBuffer, sampleTime, animation, &patches);
-                if (!firstSurface)
-                {
-                    ++result.misses;
-                    continue;
-                }
-
-                const bool firstIsEmitter = (firstSurface->material == kEmitterMaterial);
-                std::shared_ptr<Material> firstMat =
-                    firstIsEmitter ? nullptr
-                                   : materials.fetchByIndex(firstSurface->material);
-                if (!firstIsEmitter && !firstMat)
-                {
-                    continue;
-                }
-
-                // DIRECT non-delta first hit: emit a depth-0 record with identity
-                // throughput and the ray-differential footprint (distortion- and
-                // foreshortening-correct).
-                if (firstIsEmitter || !firstMat->isDelta())
-                {
-                    GatherPoint gp;
-                    gp.pixel = coord;
-                    gp.position = firstSurface->position;
-                    gp.normal = firstSurface->normal;
-                    gp.viewDir = Vector::normalized(ray.origin - firstSurface->position);
-                    gp.materialIndex = firstSurface->material;
-                    gp.specularThroughput = Color{1.0f, 1.0f, 1.0f};
-                    gp.unfoldedPathLength = firstSurface->distance;
-                    gp.footprintRadius = testing::pixelFootprintRadius(
-                        camera, animation, pixelHalfAngle, coord, *firstSurface,
-                        firstSurface->distance, sampleTime);
-                    gp.sampleTime = sampleTime;
-                    gp.sampleWeight = 1.0f;  // filled below
-                    result.points.push_back(gp);
-                    continue;
-                }
-
-                // DELTA first hit: extend through the specular chain. Glass is
-                // stochastic so fan into extra Fresnel picks; a mirror is
-                // deterministic (single pick).
-                const bool stochasticDelta =
-                    (dynamic_cast<DielectricMaterial*>(firstMat.get()) != nullptr);
-                const int extensionSamples =
-                    (stochasticDelta && !dofActive) ? kCameraSamplesPerPixel : 1;
+    const bool reuseNeighbourChains = (stride == 1) && !motionActive && !dofActive;
+    // A shutter pixel may stop early only if nothing in view can move (sceneAnimated).
+    const bool adaptive =
+        adaptiveSamples && !(motionActive && sceneAnimated(objects, camera, animation, frameTime));
+    const std::vector<MaterialTraits> traits = resolveMaterialTraits(materials);
+    const ProbeContext ctx{objects, camera, traits, animation,
+                           patches, pixelHalfAngle, frameTime, shutterSpan,
+                           motionActive, dofActive, cameraSamples, width,
+                           reuseNeighbourChains, adaptive, reuseFirstHit};
+
+    // TILE-PARALLEL. The traced pixels (every `stride`-th) are cut into
+    // kProbeTileSize-square tiles that worker threads pull from a shared cursor.
+    // Each tile traces into its OWN record vector with its OWN RNG stream, and the
+    // tiles are concatenated in tile order afterwards — so the records (and every
+    // RNG draw behind them) depend only on the seed and the tile layout, never on
+    // the worker count or the thread interleaving. A seeded ($deterministic) pass is
+    // bitwise-stable at any worker count. Production (seed < 0) seeds each tile's
+    // stream from random_device.
+    const size_t columns = (width + stride - 1) / stride;
+    const size_t rows = (height + stride - 1) / stride;
+    const size_t tilesX = (columns + kProbeTileSize - 1) / kProbeTileSize;
+    const size_t tilesY = (rows + kProbeTileSize - 1) / kProbeTileSize;
+    const size_t tileCount = tilesX * tilesY;
+
+    // FRAME-TO-FRAME REUSE (ProbeReuse): with the camera still and the sampling
+    // unchanged, a tile keeps last frame's records unless something animated may
+    // cross a segment it traced — over the window it was traced in (recorded as
+    // kTileTouchedAnimated then) or over this frame's window (checked here).
+    const AnimatedSweep sweep =
+        reuse ? sweepAnimated(objects, animation, frameTime, frameTime + shutterSpan)
+              : AnimatedSweep{};
+    const bool cameraStatic = !animation || !animation->transformAt(camera.name(), frameTime);
+    const bool reusable = reuse && reuse->primed && cameraStatic &&
+                          reuse->width == width && reuse->height == height &&
+                          reuse->subSample == stride && reuse->shutterSpan == shutterSpan &&
+                          reuse->cameraSamples == cameraSamples && reuse->seed == seed &&
+                          reuse->adaptiveSamples == adaptiveSamples &&
+                          reuse->tileBegin.size() == tileCount + 1 &&
+                          reuse->points && reuse->points->size() == reuse->tileBegin.back();
+    std::vector<bool> keepTile(tileCount, false);
+    std::vector<size_t> traceList;
+    traceList.reserve(tileCount);
+    for (size_t tile = 0; tile < tileCount; ++tile)
+    {
+        if (reusable)
+        {
+            const std::uint8_t flags = reuse->tileFlags[tile];
+            keepTile[tile] = !(flags & ProbeReuse::kTileTouchedAnimated) &&
+                             !((flags & ProbeReuse::kTileEscaped) && sweep.any) &&
+                             !sweep.reaches(reuse->tileReach, tile);
+        }
+        if (!keepTile[tile])
+        {
+            traceList.push_back(tile);
+        }
+    }
 
-                for (int ext = 0; ext < extensionSamples; ++ext)
+    std::vector<ProbeResult> tileResults(tileCount);
+    std::vector<TileReach> tileReach(tileCount);
+    for (size_t tile : traceList)
+    {
+        tileResults[tile].points = GatherPointStore(width);
+    }
+    // A tile that throws (e.g. GatherPointStore::push_back out of memory) must not
+    // escape its worker thread, where it would std::terminate the process: it is
+    // captured per tile, the cursor is run out so the other workers stop taking
+    // tiles, and the lowest failed tile's exception is rethrown here after the join.
+    std::vector<std::exception_ptr> tileErrors(tileCount);
+    std::atomic<size_t> nextTile{0};
+    const auto traceTiles = [&]() {
+        std::vector<Hit> castBuffer;
+        for (size_t next = nextTile.fetch_add(1); next < traceList.size();
+             next = nextTile.fetch_add(1))
+        {
+            const size_t tile = traceList[next];
+            try
+            {
+                RandomGenerator generator = (seed >= 0)
+                    ? RandomGenerator(tileSeed(seed, tile))
+                    : RandomGenerator();
+                const size_t column0 = (tile % tilesX) * kProbeTileSize;
+                const size_t row0 = (tile / tilesX) * kProbeTileSize;
+                const size_t columnEnd = std::min(columns, column0 + kProbeTileSize);
+                const size_t rowEnd = std::min(rows, row0 + kProbeTileSize);
+                for (size_t row = row0; row < rowEnd; ++row)
                 {
-                    const ExtendResult chain = extendAndRecord(
-                        objects, materials, animation, castBuffer, generator, ray,
-                        sampleTime, patches);
-                    if (chain.traversedDelta)
+                    // The tile's left edge has no traced neighbour in this tile.
+                    ChainEndpoint left;
+                    ChainEndpoint self;
+                    for (size_t column = column0; column < columnEnd; ++column)
                     {
-                        ++result.deltaExtensions;
+                        tracePixel(ctx, PixelCoords{column * stride, row * stride}, generator,
+                                   castBuffer, left, self, tileResults[tile], tileReach[tile]);
+                        left = self;
                     }
-                    if (!chain.valid)
-                    {
-                        ++result.misses;
-                        continue;
-                    }
-                    // wo at a reflected surface is back along the final segment
-                    // toward the last specular vertex (= -finalDirection): the same
-                    // viewer the old shade() evaluated the reflected BRDF toward.
-                    const Vector reflectedView = -chain.finalDirection;
-
-                    // issue #63 — reflected ray-differential footprint. Unfold the
-                    // ADJACENT pixel's primary ray through the SAME specular chain and,
-                    // if it reaches the SAME reflected surface (same material, normal
-                    // agrees), use its hit position to tighten the gather disc exactly
-                    // like the direct path's differential. Only for a DETERMINISTIC
-                    // mirror chain: a stochastic dielectric (glass) chain would make the
-                    // adjacent re-walk a different random Fresnel path, so the
-                    // differential would be noise — skip it there and keep the
-                    // perpendicular (2x-capped) footprint. A fresh local RNG keeps the
-                    // adjacent walk from perturbing the main sampling sequence (so the
-                    // direct/glass paths stay bitwise-deterministic).
-                    Vector adjReflectedHit;
-                    bool haveAdjReflected = false;
-                    if (!stochasticDelta)
-                    {
-                        const size_t adjX = (coord.x + 1 < width) ? coord.x + 1
-                                            : (coord.x > 0)       ? coord.x - 1
-                                                                  : coord.x;
-                        if (adjX != coord.x)
-                        {
-                            const PixelCoords adjCoord{adjX, coord.y};
-                            const Ray adjRay = dofActive
-                                ? camera.generatePrimaryRayAt(adjCoord, sampleTime,
-                                                              animation, &generator)
-                                : camera.generatePrimaryRayAt(adjCoord, sampleTime,
-                                                              animation);
-                            RandomGenerator adjGenerator(0xC0FFEEu);
-                            const ExtendResult adjChain = extendAndRecord(
-                                objects, materials, animation, castBuffer,
-                                adjGenerator, adjRay, sampleTime, patches);
-                            // Same reflected surface: valid, same material index, and
-                            // normals agree (>= cos 60°) — so we measure spacing ON the
-                            // surface, not across a silhouette / different facet.
-                            if (adjChain.valid &&
-                                adjChain.hit.material == chain.hit.material &&
-                                Vector::dot(adjChain.hit.normal, chain.hit.normal) >= 0.5)
-                            {
-                                adjReflectedHit = adjChain.hit.position;
-                                haveAdjReflected = true;
-                            }
-                        }
-                    }
-
-                    GatherPoint gp;
-                    gp.pixel = coord;
-                    gp.position = chain.hit.position;
-                    gp.normal = chain.hit.normal;
-                    gp.viewDir = Vector::normalized(reflectedView);
-                    gp.materialIndex = chain.hit.material;
-                    gp.specularThroughput = chain.throughput;
-                    gp.unfoldedPathLength = chain.unfoldedPathLength;
-                    gp.footprintRadius = testing::reflectedFootprintRadius(
-                        pixelHalfAngle, chain.unfoldedPathLength, reflectedView,
-                        chain.hit, haveAdjReflected ? &adjReflectedHit : nullptr);
-                    gp.sampleTime = sampleTime;
-                    gp.sampleWeight = 1.0f;  // filled below
-                    result.points.push_back(gp);
                 }
             }
+            catch (...)
+            {
+                tileErrors[tile] = std::current_exception();
+                nextTile.store(traceList.size());
+            }
+        }
+    };
+
+    const size_t threads = std::min(std::max<size_t>(1, workerCount), traceList.size());
+    if (threads <= 1)
+    {
+        traceTiles();
+    }
+    else
+    {
+        std::vector<std::thread> pool;
+        pool.reserve(threads);
+        for (size_t t = 0; t < threads; ++t)
+        {
+            pool.emplace_back(traceTiles);
+        }
+        for (auto& thread : pool)
+        {
+            thread.join();
+        }
+    }
+    for (const std::exception_ptr& error : tileErrors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
 
-            // sampleWeight = 1 / (surviving samples for this pixel): the average over
-            // the pixel's DOF/shutter/Fresnel samples. A pixel whose every sample
-            // missed contributes no records (and no weight).
-            const size_t survived = result.points.size() - pixelRecordBegin;
-            if (survived > 0)
+    // Deterministic merge: tile order. A kept tile's records are copied over with
+    // their sample times moved into this frame; the counters cover traced tiles only.
+    size_t total = 0;
+    for (size_t tile = 0; tile < tileCount; ++tile)
+    {
+        total += keepTile[tile] ? reuse->tileBegin[tile + 1] - reuse->tileBegin[tile]
+                                : tileResults[tile].points.size();
+    }
+    result.points.reserve(total);
+    std::vector<size_t> tileBegin(tileCount + 1, 0);
+    for (size_t tile = 0; tile < tileCount; ++tile)
+    {
+        tileBegin[tile] = result.points.size();
+        if (keepTile[tile])
+        {
+            result.points.appendRange(*reuse->points, reuse->tileBegin[tile],
+                                      reuse->tileBegin[tile + 1], reuse->frameTime, frameTime);
+            ++result.reusedTiles;
+            continue;
+        }
+        ProbeResult& traced = tileResults[tile];
+        result.points.append(traced.points);
+        result.cameraRays += traced.cameraRays;
+        result.firstSegmentCasts += traced.firstSegmentCasts;
+        result.deltaExtensions += traced.deltaExtensions;
+        result.misses += traced.misses;
+        result.reusedDifferentials += traced.reusedDifferentials;
+        result.differentialTraces += traced.differentialTraces;
+        result.adaptiveStops += traced.adaptiveStops;
+        ++result.retracedTiles;
+        traced.points = GatherPointStore(width);
+    }
+    tileBegin[tileCount] = result.points.size();
+
+    if (reuse)
+    {
+        reuse->tileReach.resize(tileCount * ProbeReuse::kReachPieces);
+        reuse->tileFlags.resize(tileCount, 0);
+        for (size_t tile : traceList)
+        {
+            const TileReach& reach = tileReach[tile];
+            std::copy(reach.pieces.begin(), reach.pieces.end(),
+                      reuse->tileReach.begin() + static_cast<std::ptrdiff_t>(tile * ProbeReuse::kReachPieces));
+            std::uint8_t flags = 0;
+            if (reach.escaped)
             {
-                const float w = 1.0f / static_cast<float>(survived);
-                for (size_t i = pixelRecordBegin; i < result.points.size(); ++i)
-                {
-                    result.points[i].sampleWeight = w;
-                }
+                flags |= ProbeReuse::kTileEscaped;
+            }
+            if (sweep.reaches(reuse->tileReach, tile))
+            {
+                flags |= ProbeReuse::kTileTouchedAnimated;
             }
+            reuse->tileFlags[tile] = flags;
         }
+        reuse->primed = true;
+        reuse->width = width;
+        reuse->height = height;
+        reuse->subSample = stride;
+        reuse->shutterSpan = shutterSpan;
+        reuse->cameraSamples = cameraSamples;
+        reuse->seed = seed;
+        reuse->adaptiveSamples = adaptiveSamples;
+        reuse->frameTime = frameTime;
+        reuse->tileBegin = std::move(tileBegin);
+        reuse->retracedTiles = std::move(traceList);
     }
     return result;
 }
 
 // ===== Emitter deposits =====
 
-EmitterDepositResult depositEmitters(const std::vector<std::shared_ptr<Object>>& objects,
-                                     const ProbeIndex& probeIndex,
-                                     double depositSpacing,
-                                     BounceStore& store)
+namespace
+{
+
+// The emitter tiling shared by both depositEmitters overloads; `keep(record)`
+// stores one kept deposit and returns whether it was taken.
+template <typename Keep>
+EmitterDepositResult tileEmitters(const std::vector<std::shared_ptr<Object>>& objects,
+                                  const ProbeIndex& probeIndex,
+                                  double depositSpacing,
+                                  Keep&& keep)
 {
     EmitterDepositResult result;
     const std::vector<EmitterPatch> patches = collectEmitterPatches(objects);
@@ -540,7 +1287,7 @@ EmitterDepositResult depositEmitters(const std::vector<std::shared_ptr<Object>>&
                 continue;  // no camera path lands here; the deposit can't be gathered
             }
             const RawBounce record{position, patch.normal, patch.normal, perDepositPower};
-            if (store.append(record))
+            if (keep(record))
             {
                 ++result.kept;
             }
@@ -549,85 +1296,74 @@ EmitterDepositResult depositEmitters(const std::vector<std::shared_ptr<Object>>&
     return result;
 }
 
-// ===== Unified gather = PURE COLLECTION =====
+}  // namespace
 
-namespace
+EmitterDepositResult depositEmitters(const std::vector<std::shared_ptr<Object>>& objects,
+                                     const ProbeIndex& probeIndex,
+                                     double depositSpacing,
+                                     BounceStore& store)
 {
+    return tileEmitters(objects, probeIndex, depositSpacing,
+                        [&store](const RawBounce& record) { return store.append(record); });
+}
 
-// Everything the pure-collection gather needs that is NOT carried per-record: the
-// store to density-estimate, the materials for the BRDF, the radius floor, and the
-// temporal window. No objects, no camera, no animation — the gather casts no rays.
-struct Context
+EmitterDepositResult depositEmitters(const std::vector<std::shared_ptr<Object>>& objects,
+                                     const ProbeIndex& probeIndex,
+                                     double depositSpacing,
+                                     StreamingGather& gather)
 {
-    const BounceStore& store;
-    const MaterialLibrary& materials;
-    double minGatherRadius;
-    float timeHalfWindow;  // gather temporal window half-width (shutter-sized)
-};
-
-}  // namespace
-
-// Density estimate of the radiance leaving a non-delta surface point toward the
-// viewer: sum BRDF(incoming, wo) * power over the raw bounces within the gather
-// footprint, divided by the gather AREA. The photon-mapping density estimate
-//   L_o = (1/ΔA) Σ_p f(wi_p, wo) Φ_p
-// has NO cos(theta_view) term — the photons already carry the incoming geometry
-// (cos_theta_i folded into the deposit), the BRDF f handles the view direction,
-// and ΔA is the surface area the gather covers.
-//
-// `wo` is the unit direction from the hit toward the viewer (precomputed by the
-// probe pass and carried on the record): the camera eye for a direct hit, the last
-// specular vertex for a reflected one. `footprintRadius` is the world-space radius
-// of the gather disc ON the surface — a RAY DIFFERENTIAL (the spacing on the
-// surface between this pixel's hit and an adjacent pixel's hit) for a direct hit,
-// the unfolded-path perpendicular footprint for a reflected hit, also precomputed
-// by the probe pass. Using the real per-pixel surface footprint (rather than a
-// constant angular footprint) is load-bearing for brightness parity with the
-// retired splat AND for matching it across the frame: a rectilinear camera's pixels
-// subtend different solid angles toward the edges and project onto tilted surfaces
-// with foreshortening, so a CONSTANT half-angle footprint over/under-counts at frame
-// edges and on grazing surfaces (measured: side walls +20%, corners +40% vs the
-// splat). The differential footprint is exactly the surface area one pixel covers,
-// so gathering over it and dividing by it reproduces the splat's "energy per pixel"
-// by construction — the cos(theta)/projection/edge factors all fall out
-// automatically. The disc is gathered with a radius covering the pixel footprint (so
-// adjacent discs tile the surface, losing no energy) and the normalization divides
-// by that SAME area, so the estimate stays unbiased.
-Color testing::gatherRadiance(const BounceStore& store,
-                              const MaterialLibrary& materials,
-                              const Hit& hit,
-                              const std::shared_ptr<Material>& material,
-                              const Vector& wo,
-                              double footprintRadius,
-                              double minGatherRadius,
-                              float rayTime,
-                              float timeHalfWindow,
-                              std::size_t& outDeposits)
+    std::vector<ProbeIndex::ProbeRef> scratch;
+    return tileEmitters(objects, probeIndex, depositSpacing,
+                        [&gather, &scratch](const RawBounce& record)
+                        { return gather.deposit(record, scratch); });
+}
+
+// ===== Unified gather = PURE COLLECTION =====
+
+namespace
 {
-    outDeposits = 0;
 
+// Everything the pure-collection gather needs that is NOT carried per-record: the
+// store to density-estimate, the materials for the BRDF, the radius floor, and the
+// temporal window. No objects, no camera, no animation — the gather casts no rays.
+struct Context
+{
+    const BounceStore& store;
+    const MaterialLibrary& materials;
+    double minGatherRadius;
+    float timeHalfWindow;  // gather temporal window half-width (shutter-sized)
+};
+
+// Sum f(wi, wo) * power over the raw bounces within radius `r` of `hit` that pass
+// the gather's filters (temporal window, normal agreement, tangent band) into
+// `sum`, and return how many were kept. The un-normalized half of the density
+// estimate: gatherRadiance divides by the disc area, the progressive gather folds
+// the sum into its per-record statistics instead.
+size_t sumFootprintFlux(const BounceStore& store,
+                        const Hit& hit,
+                        const std::shared_ptr<Material>& material,
+                        const Vector& wo,
+                        double r,
+                        float rayTime,
+                        float timeHalfWindow,
+                        Color& sum)
+{
     // An emitter hit has no MaterialLibrary entry: it is gathered with an IDENTITY
     // BRDF (f = 1) over its own radiance deposits, reproducing its view-independent
     // surface radiance L = M/pi. Any other hit uses its material's BRDF.
     const bool isEmitter = (hit.material == kEmitterMaterial);
-    (void)materials;  // BRDF arrives via `material`; kept in the signature for symmetry.
-
-    if (Vector::dot(wo, hit.normal) <= 0.0)
-    {
-        return Color{0.0f, 0.0f, 0.0f};  // surface faces away from the viewer
-    }
 
-    const double r = Utility::flooredSplatRadius(footprintRadius, minGatherRadius);
-    if (r <= 0.0)
-    {
-        return Color{0.0f, 0.0f, 0.0f};
-    }
-
-    const std::vector<std::size_t> neighbors = store.radiusSearch(hit.position, r);
-    if (neighbors.empty())
-    {
-        return Color{0.0f, 0.0f, 0.0f};
-    }
+    // TEMPORAL WINDOW. Keep a deposit only if its photon time is within the
+    // gather's half-window of this camera ray's time. A timeless deposit (an
+    // emitter patch, time == +inf) always passes. On a STATIC surface every
+    // co-located deposit is within the shutter-sized window of any camera ray
+    // time, so none is dropped (exact baseline). On a MOVING surface a deposit
+    // from a far-off time was laid down at a different position and is already
+    // outside the spatial radius — this is the backstop for two poses that
+    // overlap spatially within the gather radius. The store applies it during the
+    // radius search, where a time-sliced index settles whole slices at once.
+    const std::vector<std::size_t> neighbors =
+        store.radiusSearch(hit.position, r, rayTime, timeHalfWindow);
 
     // Leak suppression by NORMAL AGREEMENT (not a hard tangent-plane distance cut).
     // The radius search returns every deposit inside a Euclidean SPHERE of radius
@@ -650,26 +1386,11 @@ Color testing::gatherRadiance(const BounceStore& store,
     const UnitVector hitNormal = UnitVector::alreadyNormalized(hit.normal);
     constexpr double kNormalAgree = 0.5;   // cos 60°: same-surface vs perpendicular
     const double planeBand = 2.0 * r;      // loose backstop only
-    Color sum{0.0f, 0.0f, 0.0f};
     size_t kept = 0;
     for (const std::size_t index : neighbors)
     {
         const RawBounce& record = store[index];
 
-        // TEMPORAL WINDOW. Keep a deposit only if its photon time is within the
-        // gather's half-window of this camera ray's time. A timeless deposit (an
-        // emitter patch, time == +inf) always passes. On a STATIC surface every
-        // co-located deposit is within the shutter-sized window of any camera ray
-        // time, so none is dropped (exact baseline). On a MOVING surface a deposit
-        // from a far-off time was laid down at a different position and is already
-        // outside the spatial radius — this is the backstop for two poses that
-        // overlap spatially within the gather radius.
-        if (record.time != kEmitterTimeless &&
-            std::abs(record.time - rayTime) > timeHalfWindow)
-        {
-            continue;
-        }
-
         if (isEmitter)
         {
             // Emitter deposits carry the patch normal; only gather deposits whose
@@ -705,6 +1426,64 @@ Color testing::gatherRadiance(const BounceStore& store,
         sum += f * record.power;
         ++kept;
     }
+    return kept;
+}
+
+}  // namespace
+
+// Density estimate of the radiance leaving a non-delta surface point toward the
+// viewer: sum BRDF(incoming, wo) * power over the raw bounces within the gather
+// footprint, divided by the gather AREA. The photon-mapping density estimate
+//   L_o = (1/ΔA) Σ_p f(wi_p, wo) Φ_p
+// has NO cos(theta_view) term — the photons already carry the incoming geometry
+// (cos_theta_i folded into the deposit), the BRDF f handles the view direction,
+// and ΔA is the surface area the gather covers.
+//
+// `wo` is the unit direction from the hit toward the viewer (precomputed by the
+// probe pass and carried on the record): the camera eye for a direct hit, the last
+// specular vertex for a reflected one. `footprintRadius` is the world-space radius
+// of the gather disc ON the surface — a RAY DIFFERENTIAL (the spacing on the
+// surface between this pixel's hit and an adjacent pixel's hit) for a direct hit,
+// the unfolded-path perpendicular footprint for a reflected hit, also precomputed
+// by the probe pass. Using the real per-pixel surface footprint (rather than a
+// constant angular footprint) is load-bearing for brightness parity with the
+// retired splat AND for matching it across the frame: a rectilinear camera's pixels
+// subtend different solid angles toward the edges and project onto tilted surfaces
+// with foreshortening, so a CONSTANT half-angle footprint over/under-counts at frame
+// edges and on grazing surfaces (measured: side walls +20%, corners +40% vs the
+// splat). The differential footprint is exactly the surface area one pixel covers,
+// so gathering over it and dividing by it reproduces the splat's "energy per pixel"
+// by construction — the cos(theta)/projection/edge factors all fall out
+// automatically. The disc is gathered with a radius covering the pixel footprint (so
+// adjacent discs tile the surface, losing no energy) and the normalization divides
+// by that SAME area, so the estimate stays unbiased.
+Color testing::gatherRadiance(const BounceStore& store,
+                              const MaterialLibrary& materials,
+                              const Hit& hit,
+                              const std::shared_ptr<Material>& material,
+                              const Vector& wo,
+                              double footprintRadius,
+                              double minGatherRadius,
+                              float rayTime,
+                              float timeHalfWindow,
+                              std::size_t& outDeposits)
+{
+    outDeposits = 0;
+    (void)materials;  // BRDF arrives via `material`; kept in the signature for symmetry.
+
+    if (Vector::dot(wo, hit.normal) <= 0.0)
+    {
+        return Color{0.0f, 0.0f, 0.0f};  // surface faces away from the viewer
+    }
+
+    const double r = Utility::flooredSplatRadius(footprintRadius, minGatherRadius);
+    if (r <= 0.0)
+    {
+        return Color{0.0f, 0.0f, 0.0f};
+    }
+
+    Color sum{0.0f, 0.0f, 0.0f};
+    const size_t kept = sumFootprintFlux(store, hit, material, wo, r, rayTime, timeHalfWindow, sum);
     outDeposits = kept;
     if (kept == 0)
     {
@@ -855,23 +1634,149 @@ double testing::reflectedFootprintRadius(double pixelHalfAngle,
 namespace
 {
 
-// PURE COLLECTION over a contiguous slice of this camera's GatherPoint records. For
-// each record: rebuild its Hit, fetch its material, density-estimate the retained
-// raw bounces at its position over its precomputed footprint, multiply by its
-// specular throughput and 1/N sample weight, and ADD into its pixel. `buffer`
-// accumulation (atomic) does the per-pixel averaging, so records sharing a pixel may
-// be split across threads. No ray casting, no extension — the trace already happened
+// Screen tile edge (pixels) — the unit of dynamically-scheduled gather work. A
+// tile's records all land in its own pixels, so one thread owns the tile's
+// accumulator outright. Small enough that the tile queue load-balances regions of
+// very different cost (a glass pixel's 16 samples vs a dark wall), large enough
+// that a tile's spatially-sorted records share most of their BounceStore cells.
+constexpr size_t kGatherTileSize = 16;
+
+// A thread's plain-float accumulator for the one screen tile it currently owns.
+// Contributions to the tile's pixels are summed here with ordinary adds; flush()
+// then writes each touched pixel to the shared Buffer ONCE. Anything outside the
+// tile (never, for records bucketed by their own pixel — kept as the safe path)
+// goes straight to the Buffer's atomics.
+class TileAccumulator
+{
+public:
+    void reset(size_t x0, size_t y0, size_t width, size_t height)
+    {
+        m_x0 = x0;
+        m_y0 = y0;
+        m_width = width;
+        m_height = height;
+        m_sums.assign(width * height, Color{0.0f, 0.0f, 0.0f});
+        m_touched.assign(width * height, 0);
+    }
+
+    void add(PixelCoords pixel, const Color& color, Buffer& buffer)
+    {
+        if (pixel.x < m_x0 || pixel.y < m_y0 || pixel.x >= m_x0 + m_width ||
+            pixel.y >= m_y0 + m_height)
+        {
+            buffer.addColor(pixel, color);  // cross-tile: the shared atomic path
+            return;
+        }
+        const size_t index = (pixel.y - m_y0) * m_width + (pixel.x - m_x0);
+        m_sums[index] += color;
+        m_touched[index] = 1;
+    }
+
+    // The Buffer stays additive (§7): the tile's sums are ADDED, not stored.
+    void flush(Buffer& buffer) const
+    {
+        for (size_t y = 0; y < m_height; ++y)
+        {
+            for (size_t x = 0; x < m_width; ++x)
+            {
+                const size_t index = y * m_width + x;
+                if (m_touched[index])
+                {
+                    buffer.addColor({m_x0 + x, m_y0 + y}, m_sums[index]);
+                }
+            }
+        }
+    }
+
+private:
+    size_t m_x0 = 0;
+    size_t m_y0 = 0;
+    size_t m_width = 0;
+    size_t m_height = 0;
+    std::vector<Color> m_sums;
+    std::vector<unsigned char> m_touched;
+};
+
+// Spread the low 21 bits of `v` so there are two zero bits between each.
+std::uint64_t expandBits21(std::uint64_t v) noexcept
+{
+    v &= 0x1FFFFFULL;
+    v = (v | (v << 32)) & 0x1F00000000FFFFULL;
+    v = (v | (v << 16)) & 0x1F0000FF0000FFULL;
+    v = (v | (v << 8)) & 0x100F00F00F00F00FULL;
+    v = (v | (v << 4)) & 0x10C30C30C30C30C3ULL;
+    v = (v | (v << 2)) & 0x1249249249249249ULL;
+    return v;
+}
+
+// Processing order for a camera's records. Spatially ordered = sorted by the 63-bit
+// Morton key of `position` over the records' bounding box; otherwise the
+// probe-pass order. run() keeps this order inside each screen tile, so a tile's
+// consecutive records gather from neighboring BounceStore cells no matter which of
+// its pixels or specular chains produced them.
+std::vector<size_t> recordOrder(const GatherPointStore& points, bool spatialOrder)
+{
+    std::vector<size_t> order(points.size());
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        order[i] = i;
+    }
+    if (!spatialOrder || points.size() < 2)
+    {
+        return order;
+    }
+
+    Vector lo = points.position(0);
+    Vector hi = lo;
+    for (size_t i = 1; i < points.size(); ++i)
+    {
+        const Vector p = points.position(i);
+        lo = Vector{std::min(lo.x, p.x), std::min(lo.y, p.y), std::min(lo.z, p.z)};
+        hi = Vector{std::max(hi.x, p.x), std::max(hi.y, p.y), std::max(hi.z, p.z)};
+    }
+    const double extent = std::max({hi.x - lo.x, hi.y - lo.y, hi.z - lo.z, 1e-12});
+    const double scale = static_cast<double>(0x1FFFFF) / extent;
+
+    std::vector<std::pair<std::uint64_t, size_t>> keyed(points.size());
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        const Vector p = points.position(i);
+        const auto quantize = [scale](double value, double origin) {
+            return static_cast<std::uint64_t>((value - origin) * scale);
+        };
+        const std::uint64_t key = expandBits21(quantize(p.x, lo.x)) |
+                                  (expandBits21(quantize(p.y, lo.y)) << 1) |
+                                  (expandBits21(quantize(p.z, lo.z)) << 2);
+        keyed[i] = {key, i};
+    }
+    // (key, index) pairs are unique, so the order is fully deterministic.
+    std::sort(keyed.begin(), keyed.end());
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        order[i] = keyed[i].second;
+    }
+    return order;
+}
+
+// PURE COLLECTION over a slice [begin, end) of `order` into this camera's
+// GatherPoint records. For each record: rebuild its Hit, fetch its material,
+// density-estimate the retained raw bounces at its position over its precomputed
+// footprint, multiply by its specular throughput and 1/N sample weight, and ADD
+// into its pixel through the owning thread's tile accumulator (summation does the
+// per-pixel averaging). No ray casting, no extension — the trace already happened
 // in the probe pass.
-void gatherRecords(const std::vector<GatherPoint>& points,
+void gatherRecords(const GatherPointStore& points,
+                   const std::vector<size_t>& order,
                    size_t begin,
                    size_t end,
                    const Context& ctx,
+                   TileAccumulator& tile,
                    Buffer& buffer,
                    Result& stats)
 {
-    for (size_t i = begin; i < end; ++i)
+    for (size_t k = begin; k < end; ++k)
     {
-        const GatherPoint& gp = points[i];
+        const GatherPoint gp = points[order[k]];
 
         Hit hit;
         hit.position = gp.position;
@@ -900,7 +1805,7 @@ void gatherRecords(const std::vector<GatherPoint>& points,
         {
             continue;
         }
-        buffer.addColor(gp.pixel, contribution);
+        tile.add(gp.pixel, contribution, buffer);
 
         // Diagnostics (the per-pixel notions are approximated at record granularity:
         // each surviving record is a gathered sample; peak/sum track the per-record
@@ -920,28 +1825,84 @@ void gatherRecords(const std::vector<GatherPoint>& points,
 
 }  // namespace
 
+namespace
+{
+
+// One camera's records bucketed by the screen tile of their pixel, keeping
+// recordOrder's (Morton or probe-pass) order inside each tile: a stable counting
+// sort. Tile t's records are tiled[tileStart[t], tileStart[t + 1]).
+struct TiledRecords
+{
+    size_t width = 0;
+    size_t height = 0;
+    size_t tilesX = 0;
+    size_t tileCount = 0;
+    std::vector<size_t> tileStart;
+    std::vector<size_t> tiled;
+};
+
+TiledRecords tileRecords(const GatherPointStore& points, size_t width, size_t height,
+                         bool spatialOrder)
+{
+    TiledRecords tiles;
+    tiles.width = width;
+    tiles.height = height;
+    const std::vector<size_t> order = recordOrder(points, spatialOrder);
+    tiles.tilesX = (width + kGatherTileSize - 1) / kGatherTileSize;
+    const size_t tilesY = (height + kGatherTileSize - 1) / kGatherTileSize;
+    tiles.tileCount = tiles.tilesX * tilesY;
+    const auto tileOf = [&](size_t index) {
+        const PixelCoords pixel = points.pixel(index);
+        const size_t tx = std::min(pixel.x / kGatherTileSize, tiles.tilesX - 1);
+        const size_t ty = std::min(pixel.y / kGatherTileSize, tilesY - 1);
+        return ty * tiles.tilesX + tx;
+    };
+    tiles.tileStart.assign(tiles.tileCount + 1, 0);
+    for (size_t index = 0; index < points.size(); ++index)
+    {
+        ++tiles.tileStart[tileOf(index) + 1];
+    }
+    for (size_t t = 0; t < tiles.tileCount; ++t)
+    {
+        tiles.tileStart[t + 1] += tiles.tileStart[t];
+    }
+    tiles.tiled.resize(points.size());
+    std::vector<size_t> cursor(tiles.tileStart.begin(), tiles.tileStart.end() - 1);
+    for (const size_t index : order)
+    {
+        tiles.tiled[cursor[tileOf(index)]++] = index;
+    }
+    return tiles;
+}
+
+}  // namespace
+
 Result run(const std::shared_ptr<Camera>& camera,
-           const std::vector<GatherPoint>& points,
+           const GatherPointStore& points,
            const BounceStore& store,
            const MaterialLibrary& materials,
            size_t workerCount,
            double minGatherRadius,
            Buffer& buffer,
-           float shutterTime)
+           float shutterTime,
+           bool spatialOrder)
 {
-    Result result;
-    if (!camera)
-    {
-        return result;
-    }
-    const size_t width = camera->width();
-    const size_t height = camera->height();
-    if (width == 0 || height == 0)
-    {
-        return result;
-    }
+    return runCameras({CameraGather{camera, &points, &buffer}}, store, materials, workerCount,
+                      minGatherRadius, shutterTime, spatialOrder)
+        .front();
+}
+
+std::vector<Result> runCameras(const std::vector<CameraGather>& cameras,
+                               const BounceStore& store,
+                               const MaterialLibrary& materials,
+                               size_t workerCount,
+                               double minGatherRadius,
+                               float shutterTime,
+                               bool spatialOrder)
+{
+    std::vector<Result> results(cameras.size());
 
-    // Gather temporal half-window = the full shutter span (see kEmitterTimeless note
+    // Gather temporal half-window = the full shutter span (see the temporal-window note
     // above): wide enough to never reject a static surface's shutter-spread deposits
     // (exact brightness parity), with moving surfaces self-filtering spatially. A
     // zero shutter => 0 window => only same-instant deposits, which on a static scene
@@ -949,33 +1910,242 @@ Result run(const std::shared_ptr<Camera>& camera,
     const float shutterSpan = std::max(0.0f, shutterTime);
 
     const Context ctx{store, materials, minGatherRadius, shutterSpan};
+    const size_t threads = std::max<size_t>(1, workerCount);
 
-    result.pixelsHit = points.size();  // every record reached a non-delta surface
+    // The cameras with records to gather; every record reached a non-delta surface.
+    std::vector<size_t> active;
+    for (size_t c = 0; c < cameras.size(); ++c)
+    {
+        const CameraGather& job = cameras[c];
+        if (!job.camera || !job.points || !job.buffer || job.camera->width() == 0 ||
+            job.camera->height() == 0)
+        {
+            continue;
+        }
+        results[c].pixelsHit = job.points->size();
+        if (!job.points->empty())
+        {
+            active.push_back(c);
+        }
+    }
+    if (active.empty())
+    {
+        return results;
+    }
 
-    if (points.empty())
+    // Tile each camera's records — the Morton sort is the costly part, so with
+    // several cameras the threads take whole cameras from a cursor.
+    std::vector<TiledRecords> tiles(cameras.size());
     {
-        return result;
+        std::atomic<size_t> next{0};
+        const auto tileCameras = [&]() {
+            for (size_t k = next.fetch_add(1); k < active.size(); k = next.fetch_add(1))
+            {
+                const CameraGather& job = cameras[active[k]];
+                tiles[active[k]] = tileRecords(*job.points, job.camera->width(),
+                                               job.camera->height(), spatialOrder);
+            }
+        };
+        const size_t tilers = std::min(threads, active.size());
+        std::vector<std::thread> pool;
+        pool.reserve(tilers - 1);
+        for (size_t t = 1; t < tilers; ++t)
+        {
+            pool.emplace_back(tileCameras);
+        }
+        tileCameras();
+        for (auto& thread : pool)
+        {
+            thread.join();
+        }
     }
 
-    const size_t threads = std::max<size_t>(1, workerCount);
-    const size_t effectiveThreads = std::min(threads, points.size());
+    // One work list over every camera's non-empty tiles, in camera order.
+    struct TileTask
+    {
+        size_t camera;
+        size_t tile;
+    };
+    std::vector<TileTask> work;
+    for (const size_t c : active)
+    {
+        for (size_t tile = 0; tile < tiles[c].tileCount; ++tile)
+        {
+            if (tiles[c].tileStart[tile] != tiles[c].tileStart[tile + 1])
+            {
+                work.push_back(TileTask{c, tile});
+            }
+        }
+    }
 
-    std::vector<Result> perThread(effectiveThreads);
+    // Dynamic scheduling: threads pull whole tiles from a shared cursor instead of
+    // owning one static range, so a thread that drew cheap tiles keeps working
+    // while another is still on a glass-heavy region. A tile is owned by exactly
+    // one thread, so its pixels accumulate with plain float adds and reach the
+    // shared Buffer once per pixel — no CAS contention between the 16 samples of a
+    // glass/DOF pixel. Every camera's tiles share the one queue, so a frame of many
+    // small cameras keeps as many threads busy as one camera of their total size.
+    // With a single worker (deterministic mode) the tiles run in order, camera by
+    // camera, so the summation order — and each image — stays reproducible and
+    // equal to gathering the cameras one at a time.
+    const size_t effectiveThreads = std::min(threads, work.size());
+
+    std::vector<std::vector<Result>> perThread(effectiveThreads,
+                                               std::vector<Result>(cameras.size()));
     std::vector<std::thread> pool;
     pool.reserve(effectiveThreads);
-
-    const size_t perThreadCount = (points.size() + effectiveThreads - 1) / effectiveThreads;
+    std::atomic<size_t> nextTask{0};
 
     for (size_t t = 0; t < effectiveThreads; ++t)
     {
-        const size_t begin = t * perThreadCount;
-        const size_t end = std::min(points.size(), begin + perThreadCount);
-        if (begin >= end)
+        pool.emplace_back([&, t]() {
+            TileAccumulator accumulator;
+            for (size_t task = nextTask.fetch_add(1); task < work.size();
+                 task = nextTask.fetch_add(1))
+            {
+                const size_t c = work[task].camera;
+                const size_t tile = work[task].tile;
+                const TiledRecords& camTiles = tiles[c];
+                Buffer& buffer = *cameras[c].buffer;
+                const size_t x0 = (tile % camTiles.tilesX) * kGatherTileSize;
+                const size_t y0 = (tile / camTiles.tilesX) * kGatherTileSize;
+                accumulator.reset(x0, y0, std::min(kGatherTileSize, camTiles.width - x0),
+                                  std::min(kGatherTileSize, camTiles.height - y0));
+                gatherRecords(*cameras[c].points, camTiles.tiled, camTiles.tileStart[tile],
+                              camTiles.tileStart[tile + 1], ctx, accumulator, buffer,
+                              perThread[t][c]);
+                accumulator.flush(buffer);
+            }
+        });
+    }
+    for (auto& thread : pool)
+    {
+        thread.join();
+    }
+
+    for (const auto& threadResults : perThread)
+    {
+        for (const size_t c : active)
         {
-            break;
+            const Result& s = threadResults[c];
+            results[c].pixelsGathered += s.pixelsGathered;
+            results[c].maxRadiance = std::max(results[c].maxRadiance, s.maxRadiance);
+            results[c].sumRadiance += s.sumRadiance;
+            results[c].depositsAccum += s.depositsAccum;
         }
-        pool.emplace_back([&, begin, end, t]() {
-            gatherRecords(points, begin, end, ctx, buffer, perThread[t]);
+    }
+    return results;
+}
+
+// ===== Progressive gather (SPPM) =====
+
+std::size_t ProgressiveState::memoryBytes() const noexcept
+{
+    return radius.capacity() * sizeof(float) + count.capacity() * sizeof(float) +
+           flux.capacity() * sizeof(Color);
+}
+
+ProgressiveState beginProgressive(const GatherPointStore& points, double minGatherRadius)
+{
+    ProgressiveState state;
+    state.radius.resize(points.size());
+    state.count.assign(points.size(), 0.0f);
+    state.flux.assign(points.size(), Color{0.0f, 0.0f, 0.0f});
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        state.radius[i] = static_cast<float>(
+            Utility::flooredSplatRadius(points[i].footprintRadius, minGatherRadius));
+    }
+    return state;
+}
+
+std::size_t accumulateProgressive(const GatherPointStore& points,
+                                  const BounceStore& store,
+                                  const MaterialLibrary& materials,
+                                  size_t workerCount,
+                                  double minGatherRadius,
+                                  float shutterTime,
+                                  double alpha,
+                                  ProgressiveState& state)
+{
+    if (state.radius.size() != points.size())
+    {
+        throw std::runtime_error("accumulateProgressive: state does not match the records");
+    }
+    ++state.passes;
+    if (points.empty())
+    {
+        return 0;
+    }
+
+    // Same temporal window as run(): the full shutter span.
+    const float timeHalfWindow = std::max(0.0f, shutterTime);
+    const float floorRadius = static_cast<float>(std::max(0.0, minGatherRadius));
+
+    // Morton order keeps consecutive records on neighbouring BounceStore cells; each
+    // record only touches its own statistics, so chunks can go to any thread.
+    const std::vector<size_t> order = recordOrder(points, true);
+    constexpr size_t kChunk = 4096;
+    const size_t chunkCount = (order.size() + kChunk - 1) / kChunk;
+    const size_t threads = std::min(std::max<size_t>(1, workerCount), chunkCount);
+
+    std::vector<std::size_t> deposits(threads, 0);
+    std::vector<std::thread> pool;
+    pool.reserve(threads);
+    std::atomic<size_t> nextChunk{0};
+    for (size_t t = 0; t < threads; ++t)
+    {
+        pool.emplace_back([&, t]() {
+            for (size_t chunk = nextChunk.fetch_add(1); chunk < chunkCount;
+                 chunk = nextChunk.fetch_add(1))
+            {
+                const size_t end = std::min(order.size(), (chunk + 1) * kChunk);
+                for (size_t k = chunk * kChunk; k < end; ++k)
+                {
+                    const size_t i = order[k];
+                    const float r = state.radius[i];
+                    const GatherPoint gp = points[i];
+                    if (r <= 0.0f || Vector::dot(gp.viewDir, gp.normal) <= 0.0)
+                    {
+                        continue;
+                    }
+                    const bool isEmitter = (gp.materialIndex == kEmitterMaterial);
+                    const std::shared_ptr<Material> material =
+                        isEmitter ? nullptr : materials.fetchByIndex(gp.materialIndex);
+                    if (!isEmitter && !material)
+                    {
+                        continue;
+                    }
+
+                    Hit hit;
+                    hit.position = gp.position;
+                    hit.normal = gp.normal;
+                    hit.material = gp.materialIndex;
+                    hit.distance = gp.unfoldedPathLength;
+
+                    Color sum{0.0f, 0.0f, 0.0f};
+                    const size_t found = sumFootprintFlux(store, hit, material, gp.viewDir, r,
+                                                          gp.sampleTime, timeHalfWindow, sum);
+                    deposits[t] += found;
+                    if (found == 0)
+                    {
+                        continue;
+                    }
+
+                    // A record that has never seen a deposit keeps its radius until it
+                    // does (N + M > 0 from then on).
+                    const double n = state.count[i];
+                    const double m = static_cast<double>(found);
+                    const double thinned = n + alpha * m;
+                    const float shrunk = std::max(
+                        floorRadius, static_cast<float>(r * std::sqrt(thinned / (n + m))));
+                    const float ratio = (shrunk / r) * (shrunk / r);
+                    state.count[i] = static_cast<float>(thinned);
+                    state.radius[i] = shrunk;
+                    sum += state.flux[i];
+                    state.flux[i] = sum * ratio;
+                }
+            }
         });
     }
     for (auto& thread : pool)
@@ -983,12 +2153,50 @@ Result run(const std::shared_ptr<Camera>& camera,
         thread.join();
     }
 
-    for (const auto& s : perThread)
+    std::size_t total = 0;
+    for (const std::size_t d : deposits)
+    {
+        total += d;
+    }
+    return total;
+}
+
+Result resolveProgressive(const std::shared_ptr<Camera>& camera,
+                          const GatherPointStore& points,
+                          const ProgressiveState& state,
+                          Buffer& buffer)
+{
+    Result result;
+    if (!camera || points.empty() || state.passes == 0)
+    {
+        return result;
+    }
+    result.pixelsHit = points.size();
+
+    // The one-shot gather's normalization (splat parity 4/pi over the disc area),
+    // with the flux averaged over the passes folded in.
+    const double kSplatParity = 4.0 / Utility::pi;
+    const double passes = static_cast<double>(state.passes);
+    for (size_t i = 0; i < points.size(); ++i)
     {
-        result.pixelsGathered += s.pixelsGathered;
-        result.maxRadiance = std::max(result.maxRadiance, s.maxRadiance);
-        result.sumRadiance += s.sumRadiance;
-        result.depositsAccum += s.depositsAccum;
+        const double r = state.radius[i];
+        const Color& flux = state.flux[i];
+        if (r <= 0.0 || (flux.red == 0.0f && flux.green == 0.0f && flux.blue == 0.0f))
+        {
+            continue;
+        }
+        const GatherPoint gp = points[i];
+        const float scale = static_cast<float>(kSplatParity / (Utility::pi * r * r * passes));
+        const Color contribution = gp.specularThroughput * (flux * scale) * gp.sampleWeight;
+        buffer.addColor(gp.pixel, contribution);
+
+        ++result.pixelsGathered;
+        const double peak = std::max({static_cast<double>(contribution.red),
+                                      static_cast<double>(contribution.green),
+                                      static_cast<double>(contribution.blue)});
+        result.maxRadiance = std::max(result.maxRadiance, peak);
+        result.sumRadiance += 0.2126 * contribution.red + 0.7152 * contribution.green +
+                              0.0722 * contribution.blue;
     }
     return result;
 }
@@ -1006,7 +2214,8 @@ testing::ExtendResult testing::extendToNonDelta(
     // The anon-namespace ExtendResult lives at ProbeGather scope; qualify it so it is
     // not shadowed by testing::ExtendResult inside this testing-namespace function.
     const ProbeGather::ExtendResult chain = extendAndRecord(
-        objects, materials, animation, castBuffer, generator, ray, time, patches);
+        objects, resolveMaterialTraits(materials), animation, castBuffer, generator, ray,
+        time, patches);
 
     testing::ExtendResult out;
     out.hit = chain.hit;
@@ -1,18 +1,150 @@
 #include "ProbeIndex.h"
 
+#include <algorithm>
 #include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+
+std::int64_t floorDiv(std::int64_t value, std::int64_t divisor) noexcept
+{
+    const std::int64_t q = value / divisor;
+    return (value % divisor != 0 && value < 0) ? q - 1 : q;
+}
+
+}
 
 ProbeIndex::ProbeIndex(const std::vector<Vector>& probes, double cellSize, double keepRadius)
     : m_cellSize(cellSize > 0.0 ? cellSize : 1.0)
     , m_invCellSize(1.0 / (cellSize > 0.0 ? cellSize : 1.0))
     , m_keepRadius(keepRadius > 0.0 ? keepRadius : 0.0)
-    , m_probes(probes)
 {
-    m_cells.reserve(m_probes.size());
-    for (std::size_t i = 0; i < m_probes.size(); ++i)
+    m_ownedX.reserve(probes.size());
+    m_ownedY.reserve(probes.size());
+    m_ownedZ.reserve(probes.size());
+    for (const Vector& probe : probes)
+    {
+        m_ownedX.push_back(static_cast<float>(probe.x));
+        m_ownedY.push_back(static_cast<float>(probe.y));
+        m_ownedZ.push_back(static_cast<float>(probe.z));
+    }
+    m_sources.push_back(ProbePositions{m_ownedX.data(), m_ownedY.data(), m_ownedZ.data(), probes.size()});
+    build();
+}
+
+ProbeIndex::ProbeIndex(std::vector<ProbePositions> sources, double cellSize, double keepRadius)
+    : m_cellSize(cellSize > 0.0 ? cellSize : 1.0)
+    , m_invCellSize(1.0 / (cellSize > 0.0 ? cellSize : 1.0))
+    , m_keepRadius(keepRadius > 0.0 ? keepRadius : 0.0)
+    , m_sources(std::move(sources))
+{
+    build();
+}
+
+void ProbeIndex::build()
+{
+    for (const ProbePositions& source : m_sources)
+    {
+        if (source.count > 0xFFFFFFFFull)
+        {
+            throw std::runtime_error("ProbeIndex: more than 2^32 probes in one source");
+        }
+        m_probeCount += source.count;
+    }
+
+    m_cells.reserve(m_probeCount);
+    for (std::size_t s = 0; s < m_sources.size(); ++s)
+    {
+        for (std::size_t i = 0; i < m_sources[s].count; ++i)
+        {
+            const std::uint64_t ref = (static_cast<std::uint64_t>(s) << kSourceShift) | i;
+            m_cells[cellOf(probeAt(ref))].push_back(ref);
+        }
+    }
+
+    buildOccupancy();
+}
+
+void ProbeIndex::patch(std::vector<ProbePositions> sources, const std::vector<std::size_t>& changed)
+{
+    if (sources.size() != m_sources.size())
+    {
+        throw std::runtime_error("ProbeIndex: patch must keep the source count");
+    }
+
+    // Drop the changed sources' entries, visiting each cell they occupied once.
+    std::vector<bool> isChanged(m_sources.size(), false);
+    std::vector<CellKey> touched;
+    for (const std::size_t s : changed)
+    {
+        if (s >= m_sources.size() || isChanged[s])
+        {
+            continue;
+        }
+        isChanged[s] = true;
+        m_probeCount -= m_sources[s].count;
+        for (std::size_t i = 0; i < m_sources[s].count; ++i)
+        {
+            touched.push_back(cellOf(probeAt((static_cast<std::uint64_t>(s) << kSourceShift) | i)));
+        }
+    }
+    const auto keyLess = [](const CellKey& a, const CellKey& b) {
+        if (a.z != b.z)
+        {
+            return a.z < b.z;
+        }
+        if (a.y != b.y)
+        {
+            return a.y < b.y;
+        }
+        return a.x < b.x;
+    };
+    std::sort(touched.begin(), touched.end(), keyLess);
+    touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+    for (const CellKey& key : touched)
     {
-        m_cells[cellOf(m_probes[i])].push_back(i);
+        const auto it = m_cells.find(key);
+        if (it == m_cells.end())
+        {
+            continue;
+        }
+        std::vector<std::uint64_t>& refs = it->second;
+        refs.erase(std::remove_if(refs.begin(), refs.end(),
+                                  [&isChanged](std::uint64_t ref) { return isChanged[ref >> kSourceShift]; }),
+                   refs.end());
+        if (refs.empty())
+        {
+            m_cells.erase(it);
+        }
     }
+
+    // Re-point every view, then insert the changed sources' new probes.
+    m_sources = std::move(sources);
+    for (std::size_t s = 0; s < m_sources.size(); ++s)
+    {
+        if (!isChanged[s])
+        {
+            continue;
+        }
+        if (m_sources[s].count > 0xFFFFFFFFull)
+        {
+            throw std::runtime_error("ProbeIndex: more than 2^32 probes in one source");
+        }
+        m_probeCount += m_sources[s].count;
+        for (std::size_t i = 0; i < m_sources[s].count; ++i)
+        {
+            const std::uint64_t ref = (static_cast<std::uint64_t>(s) << kSourceShift) | i;
+            m_cells[cellOf(probeAt(ref))].push_back(ref);
+        }
+    }
+
+    m_occupancy.clear();
+    m_occupancyMask = 0;
+    m_occupancyShift = 64;
+    m_occupancyCount = 0;
+    buildOccupancy();
 }
 
 ProbeIndex::CellKey ProbeIndex::cellOf(const Vector& p) const noexcept
@@ -24,9 +156,192 @@ ProbeIndex::CellKey ProbeIndex::cellOf(const Vector& p) const noexcept
     };
 }
 
+void ProbeIndex::buildOccupancy()
+{
+    if (m_keepRadius <= 0.0 || m_probeCount == 0)
+    {
+        return;
+    }
+
+    // Occupancy cells are a hair larger than the keep radius, so a point within
+    // keepRadius of a probe is never more than one cell away from it even after
+    // floor() rounding — the 27-cell dilation below is then exactly conservative.
+    m_occupancyCell = m_keepRadius * (1.0 + 1e-6);
+    m_invOccupancyCell = 1.0 / m_occupancyCell;
+    const double invSubVoxel = m_invOccupancyCell * kSubVoxels;
+
+    // Occupied sub-voxels (edge cell/4), deduplicated: the stencils below only
+    // depend on WHICH sub-voxels hold a probe, and camera samples cluster heavily.
+    std::vector<CellKey> occupied;
+    occupied.reserve(m_probeCount);
+    for (const ProbePositions& source : m_sources)
+    {
+        for (std::size_t i = 0; i < source.count; ++i)
+        {
+            occupied.push_back(CellKey{
+                static_cast<std::int64_t>(std::floor(source.x[i] * invSubVoxel)),
+                static_cast<std::int64_t>(std::floor(source.y[i] * invSubVoxel)),
+                static_cast<std::int64_t>(std::floor(source.z[i] * invSubVoxel)),
+            });
+        }
+    }
+    const auto keyLess = [](const CellKey& a, const CellKey& b) {
+        if (a.z != b.z)
+        {
+            return a.z < b.z;
+        }
+        if (a.y != b.y)
+        {
+            return a.y < b.y;
+        }
+        return a.x < b.x;
+    };
+    std::sort(occupied.begin(), occupied.end(), keyLess);
+    occupied.erase(std::unique(occupied.begin(), occupied.end()), occupied.end());
+
+    const auto cellOfSubVoxel = [](const CellKey& g) {
+        return CellKey{floorDiv(g.x, kSubVoxels), floorDiv(g.y, kSubVoxels), floorDiv(g.z, kSubVoxels)};
+    };
+
+    // Dilated cell set: every cell within one cell of an occupied one.
+    std::vector<CellKey> dilated;
+    for (const CellKey& g : occupied)
+    {
+        const CellKey c = cellOfSubVoxel(g);
+        for (std::int64_t dz = -1; dz <= 1; ++dz)
+        {
+            for (std::int64_t dy = -1; dy <= 1; ++dy)
+            {
+                for (std::int64_t dx = -1; dx <= 1; ++dx)
+                {
+                    dilated.push_back(CellKey{c.x + dx, c.y + dy, c.z + dz});
+                }
+            }
+        }
+    }
+    std::sort(dilated.begin(), dilated.end(), keyLess);
+    dilated.erase(std::unique(dilated.begin(), dilated.end()), dilated.end());
+
+    // Table at <= 50% load.
+    std::size_t tableSize = 16;
+    m_occupancyShift = 60;
+    while (tableSize < dilated.size() * 2)
+    {
+        tableSize *= 2;
+        --m_occupancyShift;
+    }
+    m_occupancy.assign(tableSize, OccupancySlot{});
+    m_occupancyMask = tableSize - 1;
+    for (const CellKey& key : dilated)
+    {
+        occupancyInsert(key);
+    }
+    m_occupancyCount = dilated.size();
+
+    // "Definitely kept" stencil, in sub-voxel offsets: target sub-voxel T is
+    // wholly within keepRadius of a probe in source sub-voxel S when the FARTHEST
+    // pair of points of the two boxes is, i.e. sum((|o|+1)^2) * edge^2 <= r^2 with
+    // edge = r/4 (sum <= 16). The largest qualifying sum is 14, which leaves a
+    // margin for floor() rounding at the box faces.
+    std::vector<CellKey> keptStencil;
+    for (std::int64_t oz = -2; oz <= 2; ++oz)
+    {
+        for (std::int64_t oy = -2; oy <= 2; ++oy)
+        {
+            for (std::int64_t ox = -2; ox <= 2; ++ox)
+            {
+                const auto far = [](std::int64_t o) { return (std::abs(o) + 1) * (std::abs(o) + 1); };
+                if (far(ox) + far(oy) + far(oz) <= kSubVoxels * kSubVoxels)
+                {
+                    keptStencil.push_back(CellKey{ox, oy, oz});
+                }
+            }
+        }
+    }
+
+    // |offset| <= 2 sub-voxels never leaves the source cell's 27-neighborhood, so
+    // every target cell is already in the table.
+    for (const CellKey& g : occupied)
+    {
+        for (const CellKey& o : keptStencil)
+        {
+            const CellKey t{g.x + o.x, g.y + o.y, g.z + o.z};
+            const CellKey c = cellOfSubVoxel(t);
+            const std::int64_t bit = ((t.z - c.z * kSubVoxels) * kSubVoxels + (t.y - c.y * kSubVoxels)) * kSubVoxels +
+                                     (t.x - c.x * kSubVoxels);
+            occupancyInsert(c).keptMask |= std::uint64_t{1} << bit;
+        }
+    }
+}
+
+ProbeIndex::OccupancySlot& ProbeIndex::occupancyInsert(const CellKey& key)
+{
+    std::size_t slot = (CellKeyHash{}(key) * 0x9E3779B97F4A7C15ULL) >> m_occupancyShift;
+    while (m_occupancy[slot].used && !(m_occupancy[slot].key == key))
+    {
+        slot = (slot + 1) & m_occupancyMask;
+    }
+    m_occupancy[slot].key = key;
+    m_occupancy[slot].used = true;
+    return m_occupancy[slot];
+}
+
+const ProbeIndex::OccupancySlot* ProbeIndex::occupancyFind(const CellKey& key) const noexcept
+{
+    std::size_t slot = (CellKeyHash{}(key) * 0x9E3779B97F4A7C15ULL) >> m_occupancyShift;
+    while (m_occupancy[slot].used)
+    {
+        if (m_occupancy[slot].key == key)
+        {
+            return &m_occupancy[slot];
+        }
+        slot = (slot + 1) & m_occupancyMask;
+    }
+    return nullptr;
+}
+
+bool ProbeIndex::anyWithinKeepRadius(const Vector& p) const
+{
+    if (m_occupancy.empty())
+    {
+        return false;
+    }
+
+    const double sx = p.x * m_invOccupancyCell;
+    const double sy = p.y * m_invOccupancyCell;
+    const double sz = p.z * m_invOccupancyCell;
+    const CellKey cell{
+        static_cast<std::int64_t>(std::floor(sx)),
+        static_cast<std::int64_t>(std::floor(sy)),
+        static_cast<std::int64_t>(std::floor(sz)),
+    };
+
+    // Definitely culled: no probe in this cell or any neighbor.
+    const OccupancySlot* slot = occupancyFind(cell);
+    if (!slot)
+    {
+        return false;
+    }
+
+    // Definitely kept: p's sub-voxel lies wholly inside some probe's keep sphere.
+    const auto sub = [](double scaled, std::int64_t base) {
+        const std::int64_t s = static_cast<std::int64_t>(std::floor((scaled - static_cast<double>(base)) * kSubVoxels));
+        return std::clamp<std::int64_t>(s, 0, kSubVoxels - 1);
+    };
+    const std::int64_t bit =
+        (sub(sz, cell.z) * kSubVoxels + sub(sy, cell.y)) * kSubVoxels + sub(sx, cell.x);
+    if (slot->keptMask & (std::uint64_t{1} << bit))
+    {
+        return true;
+    }
+
+    // Boundary shell: exact test.
+    return anyWithin(p, m_keepRadius);
+}
+
 bool ProbeIndex::anyWithin(const Vector& p, double r) const
 {
-    if (r <= 0.0 || m_probes.empty())
+    if (r <= 0.0 || m_probeCount == 0)
     {
         return false;
     }
@@ -50,9 +365,9 @@ bool ProbeIndex::anyWithin(const Vector& p, double r) const
                 {
                     continue;
                 }
-                for (const std::size_t index : it->second)
+                for (const std::uint64_t ref : it->second)
                 {
-                    const Vector& probe = m_probes[index];
+                    const Vector probe = probeAt(ref);
                     const double ddx = probe.x - p.x;
                     const double ddy = probe.y - p.y;
                     const double ddz = probe.z - p.z;
@@ -66,3 +381,45 @@ bool ProbeIndex::anyWithin(const Vector& p, double r) const
     }
     return false;
 }
+
+void ProbeIndex::collectWithin(const Vector& p, double r, std::vector<ProbeRef>& out) const
+{
+    out.clear();
+    if (r <= 0.0 || m_probeCount == 0)
+    {
+        return;
+    }
+
+    const double r2 = r * r;
+    const CellKey center = cellOf(p);
+    const std::int64_t reach =
+        static_cast<std::int64_t>(std::ceil(r * m_invCellSize));
+
+    for (std::int64_t dz = -reach; dz <= reach; ++dz)
+    {
+        for (std::int64_t dy = -reach; dy <= reach; ++dy)
+        {
+            for (std::int64_t dx = -reach; dx <= reach; ++dx)
+            {
+                const CellKey key{center.x + dx, center.y + dy, center.z + dz};
+                const auto it = m_cells.find(key);
+                if (it == m_cells.end())
+                {
+                    continue;
+                }
+                for (const std::uint64_t ref : it->second)
+                {
+                    const Vector probe = probeAt(ref);
+                    const double ddx = probe.x - p.x;
+                    const double ddy = probe.y - p.y;
+                    const double ddz = probe.z - p.z;
+                    if (ddx * ddx + ddy * ddy + ddz * ddz <= r2)
+                    {
+                        out.push_back(ProbeRef{static_cast<std::size_t>(ref >> kSourceShift),
+                                               static_cast<std::size_t>(ref & 0xFFFFFFFFull)});
+                    }
+                }
+            }
+        }
+    }
+}
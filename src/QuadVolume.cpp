@@ -64,6 +64,15 @@ Vector QuadVolume::edgeV() const
     return m_quad.edgeV;
 }
 
+std::optional<Bounds> QuadVolume::localBounds() const
+{
+    Bounds bounds{m_quad.origin};
+    bounds += Bounds{m_quad.origin + m_quad.edgeU};
+    bounds += Bounds{m_quad.origin + m_quad.edgeV};
+    bounds += Bounds{m_quad.origin + m_quad.edgeU + m_quad.edgeV};
+    return bounds;
+}
+
 std::optional<Hit> QuadVolume::castTransformedRay(const Ray& ray, std::vector<Hit>& /*castBuffer*/) const
 {
     return rayIntersectsQuad(ray, m_quad);
@@ -0,0 +1,191 @@
+#include "RenderCheckpoint.h"
+
+#include "Color.h"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+namespace
+{
+
+constexpr char kMagic[8] = {'R', 'T', 'C', 'K', 'P', 'T', '1', '\n'};
+constexpr std::uint32_t kByteOrderMarker = 0x01020304u;
+
+std::runtime_error checkpointError(const std::filesystem::path& path, const char* what)
+{
+    std::string message = "RenderCheckpoint: ";
+    message += path.generic_string();
+    message += ": ";
+    message += what;
+    return std::runtime_error(message);
+}
+
+template <typename T>
+void writeValue(std::ofstream& out, const T& value)
+{
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void writeU64(std::ofstream& out, std::size_t value)
+{
+    writeValue(out, static_cast<std::uint64_t>(value));
+}
+
+template <typename T>
+void writeColumn(std::ofstream& out, const std::vector<T>& column)
+{
+    out.write(reinterpret_cast<const char*>(column.data()),
+              static_cast<std::streamsize>(column.size() * sizeof(T)));
+}
+
+template <typename T>
+T readValue(std::ifstream& in, const std::filesystem::path& path)
+{
+    T value{};
+    if (!in.read(reinterpret_cast<char*>(&value), sizeof(value)))
+    {
+        throw checkpointError(path, "truncated");
+    }
+    return value;
+}
+
+std::size_t readU64(std::ifstream& in, const std::filesystem::path& path)
+{
+    return static_cast<std::size_t>(readValue<std::uint64_t>(in, path));
+}
+
+template <typename T>
+void readColumn(std::ifstream& in, const std::filesystem::path& path, std::vector<T>& column,
+                std::size_t size)
+{
+    column.resize(size);
+    if (!in.read(reinterpret_cast<char*>(column.data()),
+                 static_cast<std::streamsize>(size * sizeof(T))))
+    {
+        throw checkpointError(path, "truncated");
+    }
+}
+
+}  // namespace
+
+bool RenderCheckpoint::sameRender(const RenderCheckpoint& other) const
+{
+    if (frameTime != other.frameTime || photonsPerLight != other.photonsPerLight ||
+        progressivePasses != other.progressivePasses ||
+        progressiveAlpha != other.progressiveAlpha || seed != other.seed ||
+        views.size() != other.views.size())
+    {
+        return false;
+    }
+    for (std::size_t v = 0; v < views.size(); ++v)
+    {
+        if (views[v].records != other.views[v].records)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void RenderCheckpoint::write(const std::filesystem::path& path) const
+{
+    const std::filesystem::path parent = path.parent_path();
+    if (!parent.empty())
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(parent, ec);
+    }
+    std::filesystem::path partial = path;
+    partial += ".tmp";
+    {
+        std::ofstream out(partial, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            throw checkpointError(partial, "cannot write");
+        }
+        out.write(kMagic, sizeof(kMagic));
+        writeValue(out, kByteOrderMarker);
+        writeValue(out, frameTime);
+        writeU64(out, photonsPerLight);
+        writeU64(out, progressivePasses);
+        writeValue(out, progressiveAlpha);
+        writeValue(out, seed);
+        writeU64(out, passesDone);
+        writeU64(out, photonsEmitted);
+        writeValue(out, droppedDeposits);
+        writeValue(out, attemptedDeposits);
+        writeU64(out, views.size());
+        for (const View& view : views)
+        {
+            writeU64(out, view.records);
+            writeU64(out, view.deposits);
+            writeColumn(out, view.state.radius);
+            writeColumn(out, view.state.count);
+            for (const Color& flux : view.state.flux)
+            {
+                writeValue(out, flux.red);
+                writeValue(out, flux.green);
+                writeValue(out, flux.blue);
+            }
+        }
+        if (!out.flush())
+        {
+            throw checkpointError(partial, "cannot write");
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(partial, path, ec);
+    if (ec)
+    {
+        throw checkpointError(path, "cannot replace");
+    }
+}
+
+RenderCheckpoint RenderCheckpoint::read(const std::filesystem::path& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+        throw checkpointError(path, "cannot open");
+    }
+    char magic[sizeof(kMagic)] = {};
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0)
+    {
+        throw checkpointError(path, "not a render checkpoint");
+    }
+    if (readValue<std::uint32_t>(in, path) != kByteOrderMarker)
+    {
+        throw checkpointError(path, "written on a machine of the other byte order");
+    }
+
+    RenderCheckpoint checkpoint;
+    checkpoint.frameTime = readValue<double>(in, path);
+    checkpoint.photonsPerLight = readU64(in, path);
+    checkpoint.progressivePasses = readU64(in, path);
+    checkpoint.progressiveAlpha = readValue<double>(in, path);
+    checkpoint.seed = readValue<std::uint32_t>(in, path);
+    checkpoint.passesDone = readU64(in, path);
+    checkpoint.photonsEmitted = readU64(in, path);
+    checkpoint.droppedDeposits = readValue<std::uint64_t>(in, path);
+    checkpoint.attemptedDeposits = readValue<std::uint64_t>(in, path);
+    checkpoint.views.resize(readU64(in, path));
+    for (View& view : checkpoint.views)
+    {
+        view.records = readU64(in, path);
+        view.deposits = readU64(in, path);
+        readColumn(in, path, view.state.radius, view.records);
+        readColumn(in, path, view.state.count, view.records);
+        view.state.flux.resize(view.records);
+        for (Color& flux : view.state.flux)
+        {
+            flux.red = readValue<float>(in, path);
+            flux.green = readValue<float>(in, path);
+            flux.blue = readValue<float>(in, path);
+        }
+        view.state.passes = checkpoint.passesDone;
+    }
+    return checkpoint;
+}
@@ -8,6 +8,8 @@
 #include "MirrorGather.h"
 #include "ProbeGather.h"
 #include "ProbeIndex.h"
+#include "RenderCheckpoint.h"
+#include "StreamingGather.h"
 #include "LightQueue.h"
 #include "Light.h"
 #include "Photon.h"
@@ -17,13 +19,231 @@
 #include "WorkQueue.h"
 #include "Worker.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
 #include <iostream>
 #include <limits>
 #include <stdexcept>
+#include <string>
 #include <thread>
+#include <vector>
+
+// A frame between beginFrame and finishFrame: the photon pass's products and the
+// gather's inputs, owned so nothing of them depends on the caller's scene.
+struct PendingFrame
+{
+    LoadedScene scene;  // the scene as beginFrame saw it (settings frozen)
+    RenderResult result;
+    std::vector<std::shared_ptr<Camera>> cameras;
+    std::vector<std::shared_ptr<Buffer>> splatBuffers;
+    std::shared_ptr<AnimationQuery> animationQuery;
+    std::shared_ptr<DensityGrid> densityGrid;
+    std::shared_ptr<ProbeIndex> probeIndex;
+    std::shared_ptr<BounceStore> bounceStore;
+    std::shared_ptr<StreamingGather> streamingGather;
+    std::unordered_map<const Camera*, std::shared_ptr<ProbeGather::GatherPointStore>>
+        cameraGatherPoints;
+    std::vector<const Camera*> probeCameras;
+    std::unordered_map<const Camera*, ProbeGather::ProgressiveState> progressiveStates;
+    std::unordered_map<const Camera*, std::size_t> progressiveDeposits;
+    size_t effectiveWorkerCount = 1;
+    double probeGatherMinRadius = 0.0;
+};
+
+namespace
+{
+// Take an allocation from one of the RenderContext's pools: an idle entry (one
+// only the pool holds) that `fits` this frame, else a new one from `make`. The
+// pool keeps what it hands out plus the entries earlier frames still hold, and
+// drops its other idle entries — frames begin one at a time, so a spare beyond
+// the one taken is never used. An entry's last other owner may have let go on
+// another thread (the frame pipeline's tail); the fence orders that owner's final
+// writes before this frame's. The caller resets what it gets back.
+template <typename T, typename Fits, typename Make>
+std::shared_ptr<T> takeFromPool(std::vector<std::shared_ptr<T>>& pool, RenderContext& context,
+                                const Fits& fits, const Make& make)
+{
+    std::shared_ptr<T> taken;
+    for (const std::shared_ptr<T>& entry : pool)
+    {
+        if (entry.use_count() == 1 && fits(*entry))
+        {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            taken = entry;
+            break;
+        }
+    }
+    pool.erase(std::remove_if(pool.begin(), pool.end(),
+                              [&](const std::shared_ptr<T>& entry) {
+                                  return entry != taken && entry.use_count() == 1;
+                              }),
+               pool.end());
+    if (taken)
+    {
+        ++context.reused;
+        return taken;
+    }
+    taken = make();
+    pool.push_back(taken);
+    ++context.allocated;
+    return taken;
+}
+
+// ===== Tonemap curve
+//
+// A channel's 16-bit code is min(int(powf(v, 1/gamma) * 65535), 65535) of its
+// exposed value v = L / L_max: three powf per pixel, most of the tonemap's time.
+// The code is a step function of v, so it is fully described by its 65535 steps —
+// thresholds[k] is the smallest float v whose code is k (found once, by bisection
+// over the float bit patterns with that same formula). A coarse interpolation
+// table guesses the code to within a step or so, and a compare or two against the
+// thresholds settles it: the image is the one powf gives, bit for bit.
+//
+// v <= 0 and NaN map to 0 and v >= 1 to 65535. (powf's int cast was undefined
+// there; on x86 it gave 0 for overexposed values past ~1e10 and infinities.)
+constexpr int kMaxCode = 65535;
+
+// Interpolation table: kCurveSteps knots per octave over [2^-kCurveOctaves, 1).
+// Below that the code is 0 (the first step is at ~2^-35).
+constexpr int kCurveOctaves = 37;
+constexpr int kCurveSteps = 128;
+constexpr std::uint32_t kCurveFirstBits = static_cast<std::uint32_t>(127 - kCurveOctaves) << 23;
+constexpr std::uint32_t kOneBits = 127u << 23;
+
+int powCode(float exposed)
+{
+    const float encoded = std::pow(exposed, 1.0f / Color::gamma);
+    return std::min(static_cast<int>(encoded * 65535), kMaxCode);
+}
+
+float fromBits(std::uint32_t bits)
+{
+    float value = 0.0f;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+struct ToneCurve
+{
+    std::vector<float> thresholds;  // kMaxCode + 2: [0] = 0, [kMaxCode + 1] = +inf
+    std::vector<float> knots;       // the curve (as a code) at each interpolation knot
+};
+
+const ToneCurve& toneCurve()
+{
+    static const ToneCurve curve = [] {
+        ToneCurve c;
+        c.thresholds.resize(kMaxCode + 2);
+        c.thresholds[0] = 0.0f;
+        c.thresholds[kMaxCode + 1] = std::numeric_limits<float>::infinity();
+        std::uint32_t low = 0;
+        for (int k = 1; k <= kMaxCode; ++k)
+        {
+            std::uint32_t high = kOneBits;  // powCode(1) == kMaxCode
+            while (low < high)
+            {
+                const std::uint32_t mid = low + (high - low) / 2;
+                if (powCode(fromBits(mid)) >= k)
+                {
+                    high = mid;
+                }
+                else
+                {
+                    low = mid + 1;
+                }
+            }
+            c.thresholds[k] = fromBits(low);
+        }
+        c.knots.resize(kCurveOctaves * kCurveSteps + 1);
+        for (std::uint32_t i = 0; i < c.knots.size(); ++i)
+        {
+            const float knot = fromBits(kCurveFirstBits + (i << 16));  // 7 mantissa bits per octave
+            c.knots[i] = std::pow(knot, 1.0f / Color::gamma) * 65535.0f;
+        }
+        return c;
+    }();
+    return curve;
+}
+
+// The code of each of `count` exposed values. The guesses are branch-free
+// straight-line arithmetic over the row; only the settling compares branch.
+void encodeCodes(const ToneCurve& curve, const float* exposed, int* codes, size_t count)
+{
+    const float* knots = curve.knots.data();
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::uint32_t bits = 0;
+        std::memcpy(&bits, &exposed[i], sizeof(bits));
+        bits = std::clamp(bits, kCurveFirstBits, kOneBits - 1);  // negatives and NaN clamp high; settled below
+        const std::uint32_t offset = bits - kCurveFirstBits;
+        const std::uint32_t knot = offset >> 16;
+        const float t = static_cast<float>(offset & 0xffffu) * (1.0f / 65536.0f);
+        codes[i] = static_cast<int>(knots[knot] + t * (knots[knot + 1] - knots[knot]));
+    }
+    const float* thresholds = curve.thresholds.data();
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float v = exposed[i];
+        if (!(v > 0.0f))
+        {
+            codes[i] = 0;
+            continue;
+        }
+        if (v >= 1.0f)
+        {
+            codes[i] = kMaxCode;
+            continue;
+        }
+        int code = std::clamp(codes[i], 0, kMaxCode);
+        while (v >= thresholds[code + 1])
+        {
+            ++code;
+        }
+        while (v < thresholds[code])
+        {
+            --code;
+        }
+        codes[i] = code;
+    }
+}
+
+// Tonemap a camera's composited buffer into a fresh image at the camera's
+// resolution and record the buffer's mean luminance. Touches only `cr`, so the
+// cameras of a frame can run on separate threads; each may split its rows over
+// `workerCount` more.
+void tonemapCamera(CameraRender& cr, double photonsEmitted, size_t workerCount)
+{
+    const size_t w = cr.camera->width();
+    const size_t h = cr.camera->height();
+    cr.image = std::make_shared<Image>(w, h);
+    cr.image->clear();
+    if (!cr.buffer)
+    {
+        return;
+    }
+    Renderer::tonemapBufferToImage(*cr.buffer, *cr.image, photonsEmitted,
+                                   cr.camera->saturationLuminance(), workerCount);
+
+    double sum = 0.0;
+    for (size_t y = 0; y < h; ++y)
+    {
+        for (size_t x = 0; x < w; ++x)
+        {
+            const Color c = cr.buffer->fetchColor({x, y});
+            sum += (static_cast<double>(c.red) + c.green + c.blue) / 3.0;
+        }
+    }
+    const double pixels = static_cast<double>(w) * static_cast<double>(h);
+    cr.meanLuminance = (pixels > 0.0) ? (sum / pixels) : 0.0;
+}
+}
 
 namespace Renderer
 {
@@ -37,46 +257,76 @@ namespace Renderer
 // divide: the buffer already holds luminance L (cd/m^2). The only job left here is
 // the photographic exposure (L / L_max) and the gamma curve.
 
-void tonemapBufferToImage(const Buffer& buffer, Image& image, double photonsEmitted, double saturationLuminance)
+void tonemapBufferToImage(const Buffer& buffer, Image& image, double photonsEmitted,
+                          double saturationLuminance, size_t workerCount)
 {
     (void)photonsEmitted;  // 1/N is applied upstream in the gather now.
 
     const size_t width = image.width();
     const size_t height = image.height();
+    if (width == 0 || height == 0)
+    {
+        return;
+    }
 
     // pixel = L / L_max. Guard a degenerate L_max.
     const double invLmax = (saturationLuminance > 0.0) ? (1.0 / saturationLuminance) : 0.0;
-
-    Pixel workingPixel;
-
-    for (size_t y = 0; y < height; ++y)
-    {
-        for (size_t x = 0; x < width; ++x)
+    const ToneCurve& curve = toneCurve();
+
+    // Rows are independent, so bands of them go to separate threads. Each row is
+    // exposed into a scratch line, encoded in one pass, then written flipped.
+    const auto tonemapRows = [&](size_t firstRow, size_t endRow) {
+        std::vector<float> exposed(width * 3);
+        std::vector<int> codes(width * 3);
+        for (size_t y = firstRow; y < endRow; ++y)
         {
-            const Color color = buffer.fetchColor({x, y});
-
-            // The buffer already holds physical luminance (gather applied 1/N and
-            // the real per-pixel footprint). Apply only the photographic exposure.
-            const double exposedR = color.red * invLmax;
-            const double exposedG = color.green * invLmax;
-            const double exposedB = color.blue * invLmax;
-
-            // Existing gamma / sRGB-ish tonemap, then clamp to 16-bit.
-            const float gammaRed = std::pow(static_cast<float>(exposedR), 1.0f / Color::gamma);
-            const float gammaGreen = std::pow(static_cast<float>(exposedG), 1.0f / Color::gamma);
-            const float gammaBlue = std::pow(static_cast<float>(exposedB), 1.0f / Color::gamma);
-
-            workingPixel.red = std::min(static_cast<int>(gammaRed * 65535), 65535);
-            workingPixel.green = std::min(static_cast<int>(gammaGreen * 65535), 65535);
-            workingPixel.blue = std::min(static_cast<int>(gammaBlue * 65535), 65535);
-
-            image.setPixel((width - 1) - x, (height - 1) - y, workingPixel);
+            for (size_t x = 0; x < width; ++x)
+            {
+                // The buffer already holds physical luminance (gather applied 1/N
+                // and the real per-pixel footprint). Apply only the photographic
+                // exposure.
+                const Color color = buffer.fetchColor({x, y});
+                exposed[x * 3 + 0] = static_cast<float>(color.red * invLmax);
+                exposed[x * 3 + 1] = static_cast<float>(color.green * invLmax);
+                exposed[x * 3 + 2] = static_cast<float>(color.blue * invLmax);
+            }
+            encodeCodes(curve, exposed.data(), codes.data(), exposed.size());
+            for (size_t x = 0; x < width; ++x)
+            {
+                image.setPixel((width - 1) - x, (height - 1) - y,
+                               Pixel(static_cast<png_uint_16>(codes[x * 3 + 0]),
+                                     static_cast<png_uint_16>(codes[x * 3 + 1]),
+                                     static_cast<png_uint_16>(codes[x * 3 + 2])));
+            }
         }
+    };
+
+    // A band of fewer rows than this costs more to start than it saves.
+    constexpr size_t kMinRowsPerThread = 16;
+    const size_t threads =
+        std::clamp<size_t>(std::min(workerCount, height / kMinRowsPerThread), 1, height);
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t < threads; ++t)
+    {
+        pool.emplace_back(tonemapRows, height * t / threads, height * (t + 1) / threads);
+    }
+    tonemapRows(0, height / threads);
+    for (auto& thread : pool)
+    {
+        thread.join();
     }
 }
 
 RenderResult renderFrame(const LoadedScene& scene, ProgressCallback progress,
-                         PreviewCallback preview)
+                         PreviewCallback preview, FrameCache* cache, RenderContext* context)
+{
+    return finishFrame(
+        *beginFrame(scene, std::move(progress), std::move(preview), cache, context));
+}
+
+std::shared_ptr<PendingFrame> beginFrame(const LoadedScene& scene, ProgressCallback progress,
+                                         PreviewCallback preview, FrameCache* cache,
+                                         RenderContext* context)
 {
     const RenderSettings& settings = scene.settings;
 
@@ -86,9 +336,12 @@ RenderResult renderFrame(const LoadedScene& scene, ProgressCallback progress,
     // runs single-threaded, so the whole frame is a single fixed RNG-draw + buffer-add
     // sequence -> bitwise-reproducible run to run (the owner's single-thread decision;
     // NOT per-worker seeding). `effectiveWorkerCount` collapses to 1 in that mode and
-    // is the configured count otherwise. `seedActive`/`baseSeed` carry the fixed seed;
-    // in deterministic mode a seed is always fixed (defaulting to 0 if none was given),
-    // so the mode is reproducible even without an explicit $seed.
+    // is the configured count otherwise. The probe pass is the exception: it draws
+    // from per-TILE seeded streams and merges tiles in order, so its records are the
+    // same at any thread count and it always runs on the configured workers.
+    // `seedActive`/`baseSeed` carry the fixed seed; in deterministic mode a seed is
+    // always fixed (defaulting to 0 if none was given), so the mode is reproducible
+    // even without an explicit $seed.
     const bool deterministic = settings.deterministic;
     const size_t effectiveWorkerCount = deterministic ? 1 : settings.workerCount;
     const bool seedActive = deterministic || (settings.seed != RenderSettings::kUnseeded);
@@ -99,6 +352,43 @@ RenderResult renderFrame(const LoadedScene& scene, ProgressCallback progress,
     const long long probeSeed =
         seedActive ? static_cast<long long>(baseSeed) + 0x9E3779B9LL : -1;
 
+    // Photon shard (RenderSettings::shardIndex / shardCount): this process emits
+    // photons [begin, end) of each light's $photonsPerLight, at the whole frame's
+    // per-photon flux. The probe pass is not sharded: with a $seed every shard
+    // traces the same records, and each gathers its own photons' deposits.
+    if (settings.shardCount == 0 || settings.shardIndex >= settings.shardCount)
+    {
+        std::string message = "Renderer: shard ";
+        message += std::to_string(settings.shardIndex);
+        message += " is not one of ";
+        message += std::to_string(settings.shardCount);
+        throw std::runtime_error(message);
+    }
+    if (settings.shardCount > 1 && settings.useProbeGather && settings.progressivePasses > 1)
+    {
+        throw std::runtime_error("Renderer: a progressive render ($progressivePasses > 1) "
+                                 "cannot be sharded; its radius update does not sum");
+    }
+    // Checkpoints (RenderSettings::checkpointPasses) stop and resume a progressive
+    // frame between passes. The statistics saved belong to this frame's records, so
+    // a resumed frame must trace the very same ones: that takes a seed, and a probe
+    // pass of its own — records the previous frame left in the FrameCache would not
+    // be there in a process that starts at this frame.
+    const bool checkpointing = settings.checkpointPasses > 0 && !settings.checkpointPath.empty() &&
+                               settings.useProbeGather && settings.progressivePasses > 1;
+    if (checkpointing)
+    {
+        if (!seedActive)
+        {
+            throw std::runtime_error("Renderer: $checkpointPasses needs a $seed (or $deterministic) "
+                                     "so a resumed frame traces the same probe records");
+        }
+        cache = nullptr;
+    }
+    const size_t shardPhotons =
+        (settings.shardIndex + 1) * settings.photonsPerLight / settings.shardCount -
+        settings.shardIndex * settings.photonsPerLight / settings.shardCount;
+
     // Wave 6: the shared photon pass starts here. Time it so the per-camera gather
     // cost (Milestone 2) can be reported separately from the one-time lighting solve.
     const std::chrono::time_point photonPassStart = std::chrono::system_clock::now();
@@ -110,8 +400,29 @@ RenderResult renderFrame(const LoadedScene& scene, ProgressCallback progress,
     std::shared_ptr<Buffer> buffer = result.buffer;
     std::shared_ptr<Image> image = result.image;
 
-    std::shared_ptr<LightQueue> lightQueue = std::make_shared<LightQueue>();
-    std::shared_ptr<WorkQueue<Photon>> photonQueue = std::make_shared<WorkQueue<Photon>>(settings.photonQueueSize);
+    // The queues come from the context when it has them free: the photon queue's
+    // slots are the frame's largest page-touch after the bounce store.
+    std::shared_ptr<LightQueue> lightQueue;
+    std::shared_ptr<WorkQueue<Photon>> photonQueue;
+    if (context)
+    {
+        lightQueue = takeFromPool(
+            context->lightQueues, *context, [](const LightQueue&) { return true; },
+            []() { return std::make_shared<LightQueue>(); });
+        lightQueue->reset();
+        photonQueue = takeFromPool(
+            context->photonQueues, *context,
+            [&](const WorkQueue<Photon>& queue) {
+                return queue.capacity() == settings.photonQueueSize;
+            },
+            [&]() { return std::make_shared<WorkQueue<Photon>>(settings.photonQueueSize); });
+        photonQueue->reset();
+    }
+    else
+    {
+        lightQueue = std::make_shared<LightQueue>();
+        photonQueue = std::make_shared<WorkQueue<Photon>>(settings.photonQueueSize);
+    }
 
     // Continuous-time animation oracle. The scene loader builds a
     // KeyframedAnimationQuery from per-object $animation blocks; if no object is
@@ -207,7 +518,26 @@ RenderResult renderFrame(const LoadedScene& scene, ProgressCallback progress,
         {
             continue;
         }
-        auto camBuffer = std::make_shared<Buffer>(cam->width(), cam->height());
+        std::shared_ptr<Buffer> camBuffer;
+        if (context)
+        {
+            // The context pools buffers per camera slot (declaration order).
+            const std::size_t slot = splatBuffers.size();
+            if (context->splatBuffers.size() <= slot)
+            {
+                context->splatBuffers.resize(slot + 1);
+            }
+            camBuffer = takeFromPool(
+                context->splatBuffers[slot], *context,
+                [&](const Buffer& pooled) {
+                    return pooled.width() == cam->width() && pooled.height() == cam->height();
+                },
+                [&]() { return std::make_shared<Buffer>(cam->width(), cam->height()); });
+        }
+        else
+        {
+            camBuffer = std::make_shared<Buffer>(cam->width(), cam->height());
+        }
         camBuffer->clear();
         splatBuffers.push_back(camBuffer);
         splatTargets.push_back(Worker::SplatTarget{
@@ -286,14 +616,29 @@ RenderResult renderFrame(const LoadedScene& scene, ProgressCallback progress,
     std::shared_ptr<ProbeIndex> probeIndex;
     std::shared_ptr<BounceStore> bounceStore;
     ProbeGather::ProbeResult probeResult;       // diagnostic counters (aggregated)
-    std::vector<Vector> probePositions;         // UNION of record positions: the keep-test
     // Per-camera gather-point records (the probe pass is the single camera-side
     // specular tracer; each camera's gather consumes ONLY its own records so cameras
     // never cross-contaminate). Keyed by camera pointer to survive the null/debug
-    // skips below. The keep-test ProbeIndex is built from the UNION of all positions.
-    std::unordered_map<const Camera*, std::vector<ProbeGather::GatherPoint>>
+    // skips below. The keep-test ProbeIndex indexes the UNION of all their positions
+    // in place (no copy), so these stores stay untouched until the photon pass ends.
+    // Shared with the frame cache, which hands them to the next frame's probe pass
+    // while this frame may still be gathering from them (beginFrame/finishFrame).
+    std::unordered_map<const Camera*, std::shared_ptr<ProbeGather::GatherPointStore>>
         cameraGatherPoints;
+    std::vector<const Camera*> probeCameras;  // cameras with records, in scene order
     double probeGatherMinRadius = 0.0;
+    // $streamingGather: the index's sources as camera-record ranges (camera slot =
+    // position in probeCameras), and the gather itself when this frame can use it.
+    std::vector<StreamingGather::Source> streamSources;
+    std::shared_ptr<StreamingGather> streamingGather;
+    if (cache)
+    {
+        if (!cache->primed)
+        {
+            *cache = FrameCache{};
+        }
+        cache->primed = false;
+    }
     if (settings.useProbeGather)
     {
         const std::shared_ptr<Camera>& primaryCam =
@@ -344,7 +689,7 @@ RenderResult renderFrame(const LoadedScene& scene, ProgressCallback progress,
             // shutter / Fresnel-branch samples). The record positions are the probes;
             // the per-camera gather later consumes the full records with no tracing.
             // (cameraTimeSamples drives both the shutter integral here and the gather;
-            // probeTimeSlices is retired — every sample carries its own random time.)
+            // probeTimeSlices now slices the bounce index — every sample carries its own time.)
             ProbeGather::ProbeResult camProbes = ProbeGather::collectGatherPoints(
                 scene.objects, *cam, *scene.materialLibrary,
                 animationQuery.get(),
@@ -352,44 +697,166 @@ RenderResult renderFrame(const LoadedScene& scene, ProgressCallback progress,
                 static_cast<float>(settings.shutterTime),
                 settings.cameraTimeSamples,
                 settings.probeSubSample,
-                probeSeed);
-            // Union the probe POSITIONS for the shared keep-test index; aggregate the
-            // diagnostic counters; keep the full records per-camera for its gather.
-            probePositions.reserve(probePositions.size() + camProbes.points.size());
-            for (const ProbeGather::GatherPoint& gp : camProbes.points)
-            {
-                probePositions.push_back(gp.position);
-            }
+                probeSeed,
+                settings.workerCount,
+                settings.adaptiveCameraSamples,
+                cache ? &cache->cameras[cam.get()] : nullptr);
+            // Aggregate the diagnostic counters; keep the compact records per-camera
+            // for its gather (their positions also feed the shared keep-test index).
             probeResult.cameraRays += camProbes.cameraRays;
             probeResult.deltaExtensions += camProbes.deltaExtensions;
             probeResult.misses += camProbes.misses;
-            cameraGatherPoints.emplace(cam.get(), std::move(camProbes.points));
+            probeResult.reusedDifferentials += camProbes.reusedDifferentials;
+            probeResult.differentialTraces += camProbes.differentialTraces;
+            probeResult.adaptiveStops += camProbes.adaptiveStops;
+            result.probeTilesReused += camProbes.reusedTiles;
+            result.probeTilesTraced += camProbes.retracedTiles;
+            cameraGatherPoints.emplace(
+                cam.get(), std::make_shared<ProbeGather::GatherPointStore>(std::move(camProbes.points)));
+            probeCameras.push_back(cam.get());
         }
         // The probe-index cell size = keepRadius so a keep query touches a 3x3x3
         // neighborhood. The gather's own bounce-index cell size is set later.
-        probeIndex = std::make_shared<ProbeIndex>(
-            probePositions, keepRadius, keepRadius);
-
-        // Size the raw-bounce store from the VISIBLE-SURFACE-AREA proxy (the probe
-        // count) rather than always reserving the full configured capacity: the
-        // keep-test bounds the kept bounces by visible area, so the store only
-        // needs ~ (photons per visible surface region) slots. Reserve a generous
-        // per-probe budget so a bright, heavily-deposited visible surface doesn't
-        // overflow, but cap at the configured ceiling so a pathological probe
-        // count can't request unbounded RAM. This is what turns the "bounded by
-        // visible area" property into an actual smaller ALLOCATION, not just a
-        // smaller used-prefix. (At 36 B/slot the default ceiling is ~1.3 GiB.)
-        constexpr std::size_t kSlotsPerProbe = 256;
-        const std::size_t probeSized =
-            probePositions.empty()
-                ? settings.bounceStoreCapacity
-                : probePositions.size() * kSlotsPerProbe;
-        const std::size_t capacity =
-            std::min(settings.bounceStoreCapacity,
-                     std::max<std::size_t>(1, probeSized));
-        bounceStore = std::make_shared<BounceStore>(capacity);
+        if (!cache)
+        {
+            std::vector<ProbePositions> probeSources;
+            probeSources.reserve(probeCameras.size());
+            for (std::size_t slot = 0; slot < probeCameras.size(); ++slot)
+            {
+                const ProbeGather::GatherPointStore& records =
+                    *cameraGatherPoints.at(probeCameras[slot]);
+                probeSources.push_back(records.positions());
+                streamSources.push_back({&records, 0, slot});
+            }
+            probeIndex = std::make_shared<ProbeIndex>(
+                std::move(probeSources), keepRadius, keepRadius);
+        }
+        else
+        {
+            // FRAME CACHE: one index source per camera TILE, so this frame patches
+            // only the tiles it re-traced (their old positions are still alive in
+            // the cache's previous records) and re-points the carried-over ones at
+            // their copies in this frame's records. Anything else about the index
+            // changing (cameras, keep radius) — or every tile re-traced — rebuilds.
+            std::vector<ProbePositions> probeSources;
+            std::vector<std::size_t> changedSources;
+            for (std::size_t slot = 0; slot < probeCameras.size(); ++slot)
+            {
+                const Camera* cam = probeCameras[slot];
+                const ProbeGather::ProbeReuse& reuse = cache->cameras[cam];
+                const ProbeGather::GatherPointStore& records = *cameraGatherPoints.at(cam);
+                for (const std::size_t tile : reuse.retracedTiles)
+                {
+                    changedSources.push_back(probeSources.size() + tile);
+                }
+                for (std::size_t tile = 0; tile + 1 < reuse.tileBegin.size(); ++tile)
+                {
+                    probeSources.push_back(
+                        records.positions(reuse.tileBegin[tile], reuse.tileBegin[tile + 1]));
+                    streamSources.push_back({&records, reuse.tileBegin[tile], slot});
+                }
+            }
+            const bool patchable = cache->probeIndex && cache->indexCameras == probeCameras &&
+                                   cache->indexKeepRadius == keepRadius &&
+                                   changedSources.size() < probeSources.size();
+            if (patchable)
+            {
+                cache->probeIndex->patch(std::move(probeSources), changedSources);
+            }
+            else
+            {
+                cache->probeIndex = std::make_shared<ProbeIndex>(
+                    std::move(probeSources), keepRadius, keepRadius);
+            }
+            cache->indexCameras = probeCameras;
+            cache->indexKeepRadius = keepRadius;
+            probeIndex = cache->probeIndex;
+        }
+
+        // STREAMING GATHER: a one-shot frame whose every view is matte folds its
+        // deposits into the records during the photon pass (StreamingGather) and
+        // never opens a BounceStore. Any other view falls back to the store.
+        bool streamable = settings.streamingGather && settings.progressivePasses <= 1;
+        for (std::size_t slot = 0; streamable && slot < probeCameras.size(); ++slot)
+        {
+            streamable = StreamingGather::supports(*cameraGatherPoints.at(probeCameras[slot]),
+                                                   *scene.materialLibrary);
+        }
+        if (streamable)
+        {
+            std::vector<const ProbeGather::GatherPointStore*> cameraRecords;
+            cameraRecords.reserve(probeCameras.size());
+            for (const Camera* cam : probeCameras)
+            {
+                cameraRecords.push_back(cameraGatherPoints.at(cam).get());
+            }
+            streamingGather = std::make_shared<StreamingGather>(
+                std::move(cameraRecords), std::move(streamSources), *probeIndex,
+                probeGatherMinRadius, static_cast<float>(settings.shutterTime));
+            result.streamedGather = true;
+            result.streamingGatherBytes = streamingGather->memoryBytes();
+        }
 
         WorkerDebug::resetBounceCounters();
+    }
+
+    // Bounce-index cell size = the gather footprint scale, so a radius-r query
+    // touches a 3x3x3 neighborhood. Reuse the scene-depth footprint. Also the
+    // emitter deposit spacing's scale.
+    const double bounceIndexCell = (sceneDepthFootprint > 0.0) ? sceneDepthFootprint : cellSize;
+    // Time slices per bounce-index cell: with a finite shutter the gather's temporal
+    // window then settles whole slices instead of testing every deposit's time.
+    const std::size_t bounceIndexTimeSlices =
+        (settings.shutterTime > 0.0 && settings.probeTimeSlices > 1)
+            ? static_cast<std::size_t>(settings.probeTimeSlices)
+            : 1;
+
+    // Index one photon pass's store, merging its deposits first if configured
+    // ($depositMergeScale). Deposits merge within 5% of the shutter of each other.
+    const auto indexBounceStore = [&]() {
+        bounceStore->buildIndex(bounceIndexCell, bounceIndexTimeSlices);
+        BounceStore::MergeTolerance tolerance;
+        tolerance.cellSize = settings.depositMergeScale * bounceIndexCell;
+        tolerance.timeTolerance = static_cast<float>(0.05 * settings.shutterTime);
+        const BounceStore::MergeResult merged = bounceStore->mergeDeposits(tolerance);
+        result.depositsBeforeMerge += merged.before;
+        result.depositsAfterMerge += merged.after;
+    };
+
+    // Open a fresh raw-bounce store for one photon pass, with the emitter fixtures'
+    // deposits already in it.
+    const auto openBounceStore = [&]() {
+        // The raw-bounce store commits memory lazily, segment by segment, as
+        // deposits land (BounceStore.h), so it is sized at the configured ceiling
+        // outright. Resident memory tracks the keep-test's kept bounces (visible
+        // surface area); $bounceStoreCapacity only caps how far that may grow. (The
+        // old probe-count * 256 reservation was a guess that either wasted an
+        // untouched allocation or overflowed a brightly-lit visible surface.)
+        // With $bounceStoreResidentMiB set, the tail past that budget spills to a
+        // memory-mapped scratch file instead (BounceStore spill mode).
+        //
+        // A RenderContext keeps the previous frame's store, committed segments and
+        // all, and the new frame resets it rather than faulting in fresh ones.
+        // Spill stores are not kept (BounceStore::reset).
+        const std::size_t capacity = std::max<std::size_t>(1, settings.bounceStoreCapacity);
+        if (settings.bounceStoreResidentMiB > 0)
+        {
+            bounceStore = std::make_shared<BounceStore>(
+                capacity, settings.bounceStoreResidentMiB * 1024 * 1024,
+                std::filesystem::temp_directory_path());
+        }
+        else if (context)
+        {
+            bounceStore = takeFromPool(
+                context->bounceStores, *context,
+                [&](const BounceStore& store) { return store.capacity() == capacity; },
+                [&]() { return std::make_shared<BounceStore>(capacity); });
+            bounceStore->reset();
+        }
+        else
+        {
+            bounceStore = std::make_shared<BounceStore>(capacity);
+        }
 
         // Issue #62 — deposit emitter contributions FIRST, BEFORE the photon pass.
         // The BounceStore drops every append past its capacity ceiling (lock-free
@@ -403,195 +870,335 @@ RenderResult renderFrame(const LoadedScene& scene, ProgressCallback progress,
         // same per-deposit power as before — only the ORDER (and thus which records
         // survive an overflow) changes. buildIndex still runs once after the photon
         // pass drains, indexing the full populated prefix (emitter + photon deposits).
-        if (probeIndex && bounceStore)
+        if (probeIndex && bounceStore && settings.shardIndex == 0)
         {
-            double emitterGatherCell = cellSize;
-            if (sceneDepthFootprint > 0.0)
-            {
-                emitterGatherCell = sceneDepthFootprint;
-            }
-            const double depositSpacing = std::max(emitterGatherCell * 0.5, 1e-6);
+            const double depositSpacing = std::max(bounceIndexCell * 0.5, 1e-6);
             const ProbeGather::EmitterDepositResult emit =
                 ProbeGather::depositEmitters(scene.objects, *probeIndex,
                                              depositSpacing, *bounceStore);
             result.emitterDepositsKept = emit.kept;
         }
-    }
+    };
 
-    std::vector<std::shared_ptr<Worker>> workers{effectiveWorkerCount};
+    // One photon pass: spin up the workers, seed the light queue with every
+    // light's full photon budget, and drain the pipeline into `bounceStore` (probe
+    // mode) or the splat buffers + density grid. `pass` offsets the worker seeds so
+    // each pass of a progressive render traces fresh photons (pass 0 keeps the
+    // one-shot seeds). Returns false if the progress callback asked to abort.
+    const auto runPhotonPass = [&](size_t pass) -> bool {
+        std::vector<std::shared_ptr<Worker>> workers{effectiveWorkerCount};
 
-    size_t workerIndex = 0;
-    for (auto& worker : workers)
-    {
-        worker = std::make_shared<Worker>(workerIndex, settings.fetchSize);
-        worker->camera = scene.camera;
-        worker->objects = scene.objects;
-        worker->photonQueue = photonQueue;
-        worker->materialLibrary = scene.materialLibrary;
-        worker->lightQueue = lightQueue;
-        worker->animationQuery = animationQuery;
-        // Deterministic / seeded mode: give each worker a fixed seed. In the
-        // single-thread deterministic mode there is exactly one worker, so this is a
-        // single reproducible draw sequence (bitwise determinism). In a seeded-but-
-        // threaded run each worker gets baseSeed + index (reproducible per-worker, no
-        // bitwise guarantee across the non-associative atomic buffer adds).
-        if (seedActive)
-        {
-            worker->setSeed(baseSeed + static_cast<std::uint32_t>(workerIndex));
-        }
-        worker->setBounceThreshold(settings.bounceThreshold);
-        worker->setTerminationThreshold(settings.terminationThreshold);
-        worker->setPhotonsPerLight(static_cast<double>(settings.photonsPerLight));
-        worker->setMinSplatRadius(minSplatRadius);
-        worker->setSplatLuminanceClamp(settings.splatLuminanceClamp);
-        if (settings.useProbeGather)
+        size_t workerIndex = 0;
+        for (auto& worker : workers)
         {
-            // Probe mode: keep raw bounces near probes; NO density grid, NO splat.
-            worker->bounceStore = bounceStore;
-            worker->probeIndex = probeIndex;
+            worker = std::make_shared<Worker>(workerIndex, settings.fetchSize);
+            worker->camera = scene.camera;
+            worker->objects = scene.objects;
+            worker->photonQueue = photonQueue;
+            worker->materialLibrary = scene.materialLibrary;
+            worker->lightQueue = lightQueue;
+            worker->animationQuery = animationQuery;
+            // Deterministic / seeded mode: give each worker a fixed seed. In the
+            // single-thread deterministic mode there is exactly one worker, so this is a
+            // single reproducible draw sequence (bitwise determinism). In a seeded-but-
+            // threaded run each worker gets baseSeed + index (reproducible per-worker, no
+            // bitwise guarantee across the non-associative atomic buffer adds).
+            // A photon shard (one pass, see above) takes the seeds of pass
+            // `shardIndex`, so shard 0 keeps the unsharded seeds and no two shards
+            // trace the same photons.
+            if (seedActive)
+            {
+                const size_t seedPass = settings.shardIndex + pass;
+                worker->setSeed(baseSeed + static_cast<std::uint32_t>(
+                                               seedPass * effectiveWorkerCount + workerIndex));
+            }
+            worker->setBounceThreshold(settings.bounceThreshold);
+            worker->setTerminationThreshold(settings.terminationThreshold);
+            worker->setPhotonsPerLight(static_cast<double>(settings.photonsPerLight));
+            worker->setMinSplatRadius(minSplatRadius);
+            worker->setSplatLuminanceClamp(settings.splatLuminanceClamp);
+            if (settings.useProbeGather)
+            {
+                // Probe mode: keep raw bounces near probes; NO density grid, NO splat.
+                worker->bounceStore = bounceStore;
+                worker->probeIndex = probeIndex;
+                worker->streamingGather = streamingGather;
+            }
+            else
+            {
+                worker->densityGrid = densityGrid;
+                worker->setSplatTargets(splatTargets);
+            }
+            ++workerIndex;
         }
-        else
+
+        for (size_t i = 0; i < effectiveWorkerCount; ++i)
         {
-            worker->densityGrid = densityGrid;
-            worker->setSplatTargets(splatTargets);
+            workers[i]->start();
         }
-        ++workerIndex;
-    }
-
-    for (size_t i = 0; i < effectiveWorkerCount; ++i)
-    {
-        workers[i]->start();
-    }
 
-    buffer->clear();
-    image->clear();
+        buffer->clear();
+        image->clear();
 
-    // Seed the light queue. Wave 2: each light registers its total luminous flux
-    // Phi (lumens), computed from its physical intensity (candela) and emission
-    // solid angle. The per-photon carried weight is Phi (count-independent); the
-    // divide by photonsPerLight happens once at conversion below.
-    for (const auto& object : scene.objects)
-    {
-        if (object->hasType<Light>())
+        // Seed the light queue. Wave 2: each light registers its total luminous flux
+        // Phi (lumens), computed from its physical intensity (candela) and emission
+        // solid angle. The per-photon carried weight is Phi (count-independent); the
+        // divide by photonsPerLight happens once at conversion below.
+        for (const auto& object : scene.objects)
         {
-            const double flux = std::static_pointer_cast<Light>(object)->luminousFlux();
-            lightQueue->registerLight(object->name(), settings.photonsPerLight, flux);
+            if (object->hasType<Light>())
+            {
+                const double flux = std::static_pointer_cast<Light>(object)->luminousFlux();
+                lightQueue->registerLight(object->name(), shardPhotons, flux,
+                                          settings.photonsPerLight);
+            }
         }
-    }
-
-    size_t photonsToEmit = lightQueue->remainingPhotons();
-    size_t photonsAllocated = photonQueue->allocated();
 
-    // Progressive preview wiring: the PRIMARY camera's splat buffer (the live
-    // direct-lighting accumulator) and its exposure, plus the total photon budget
-    // so the preview callback can report the emitted fraction for stable-brightness
-    // tonemapping. Captured once; the loop below taps them while photons land.
-    const size_t totalPhotonsToEmit = photonsToEmit;
-    std::shared_ptr<Buffer> previewBuffer = splatBuffers.empty() ? nullptr : splatBuffers.front();
-    std::shared_ptr<Camera> previewCamera =
-        cameras.empty() ? scene.camera : cameras.front();
+        size_t photonsToEmit = lightQueue->remainingPhotons();
+        result.photonsEmitted += photonsToEmit;
+        size_t photonsAllocated = photonQueue->allocated();
+
+        // Progressive preview wiring: the PRIMARY camera's splat buffer (the live
+        // direct-lighting accumulator) and its exposure, plus the total photon budget
+        // so the preview callback can report the emitted fraction for stable-brightness
+        // tonemapping. Captured once; the loop below taps them while photons land.
+        const size_t totalPhotonsToEmit = photonsToEmit;
+        std::shared_ptr<Buffer> previewBuffer = splatBuffers.empty() ? nullptr : splatBuffers.front();
+        std::shared_ptr<Camera> previewCamera =
+            cameras.empty() ? scene.camera : cameras.front();
 
-    std::exception_ptr workerException;
-    bool aborted = false;
-    bool drainStalled = false;
+        std::exception_ptr workerException;
+        bool aborted = false;
+        bool drainStalled = false;
+
+        // Completion test for the single-photon trace-to-completion pipeline: work is
+        // done when the lights owe no more photons AND no photons remain allocated in
+        // the queue. A batch a worker has fetched but not finished tracing keeps the
+        // queue's allocation non-zero (the source slots are released only after the
+        // whole batch is traced to completion), so in-flight bounce work is covered by
+        // photonsAllocated — there is no separate emitter queue or overflow to track.
+        while (photonsAllocated > 0 || photonsToEmit > 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(250));
 
-    // Completion test for the single-photon trace-to-completion pipeline: work is
-    // done when the lights owe no more photons AND no photons remain allocated in
-    // the queue. A batch a worker has fetched but not finished tracing keeps the
-    // queue's allocation non-zero (the source slots are released only after the
-    // whole batch is traced to completion), so in-flight bounce work is covered by
-    // photonsAllocated — there is no separate emitter queue or overflow to track.
-    while (photonsAllocated > 0 || photonsToEmit > 0)
-    {
-        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+            photonsToEmit = lightQueue->remainingPhotons();
+            photonsAllocated = photonQueue->allocated();
 
-        photonsToEmit = lightQueue->remainingPhotons();
-        photonsAllocated = photonQueue->allocated();
+            for (auto& worker : workers)
+            {
+                if (worker->exception())
+                {
+                    workerException = worker->exception();
+                    break;
+                }
+            }
 
-        for (auto& worker : workers)
-        {
-            if (worker->exception())
+            if (workerException)
             {
-                workerException = worker->exception();
                 break;
             }
-        }
 
-        if (workerException)
-        {
-            break;
-        }
+            // Liveness guard (safety net for an abnormal exit, not the normal path).
+            // start() sets m_running synchronously, so every worker is live on the
+            // first iteration; this only fires if EVERY worker has left its exec()
+            // loop while work is still outstanding -- e.g. a future non-exception
+            // return-false/break path. Without it the loop would spin forever with no
+            // worker draining the queue and no exception to surface. The normal case
+            // (at least one worker still running) is completely unaffected.
+            if (photonsAllocated > 0 || photonsToEmit > 0)
+            {
+                bool anyWorkerRunning = false;
+                for (const auto& worker : workers)
+                {
+                    if (worker->running())
+                    {
+                        anyWorkerRunning = true;
+                        break;
+                    }
+                }
 
-        // Liveness guard (safety net for an abnormal exit, not the normal path).
-        // start() sets m_running synchronously, so every worker is live on the
-        // first iteration; this only fires if EVERY worker has left its exec()
-        // loop while work is still outstanding -- e.g. a future non-exception
-        // return-false/break path. Without it the loop would spin forever with no
-        // worker draining the queue and no exception to surface. The normal case
-        // (at least one worker still running) is completely unaffected.
-        if (photonsAllocated > 0 || photonsToEmit > 0)
-        {
-            bool anyWorkerRunning = false;
-            for (const auto& worker : workers)
+                if (!anyWorkerRunning)
+                {
+                    drainStalled = true;
+                    break;
+                }
+            }
+
+            if (progress)
             {
-                if (worker->running())
+                const size_t remainingWork = photonsToEmit + photonsAllocated;
+                if (!progress(remainingWork))
                 {
-                    anyWorkerRunning = true;
+                    aborted = true;
                     break;
                 }
             }
 
-            if (!anyWorkerRunning)
+            // Progressive preview tap: hand the live splat buffer + emitted fraction to
+            // the UI so it can snapshot the converging image. emittedFraction is the
+            // share of the photon budget that has been emitted so far (in (0,1]); the
+            // single-photon buffer is normalized by the TOTAL count, so the consumer
+            // scales by 1/emittedFraction for stable brightness. Reads of the buffer
+            // are atomic per pixel (see PreviewCallback contract).
+            if (preview && previewBuffer && previewCamera)
             {
-                drainStalled = true;
-                break;
+                const size_t emitted =
+                    (totalPhotonsToEmit > photonsToEmit) ? (totalPhotonsToEmit - photonsToEmit) : 0;
+                const double emittedFraction =
+                    (totalPhotonsToEmit > 0)
+                        ? std::max(1e-6, static_cast<double>(emitted) / static_cast<double>(totalPhotonsToEmit))
+                        : 1.0;
+                preview(*previewBuffer, emittedFraction, previewCamera->saturationLuminance());
             }
         }
 
-        if (progress)
+        for (size_t i = 0; i < effectiveWorkerCount; ++i)
         {
-            const size_t remainingWork = photonsToEmit + photonsAllocated;
-            if (!progress(remainingWork))
-            {
-                aborted = true;
-                break;
-            }
+            workers[i]->stop();
         }
 
-        // Progressive preview tap: hand the live splat buffer + emitted fraction to
-        // the UI so it can snapshot the converging image. emittedFraction is the
-        // share of the photon budget that has been emitted so far (in (0,1]); the
-        // single-photon buffer is normalized by the TOTAL count, so the consumer
-        // scales by 1/emittedFraction for stable brightness. Reads of the buffer
-        // are atomic per pixel (see PreviewCallback contract).
-        if (preview && previewBuffer && previewCamera)
+        if (workerException)
         {
-            const size_t emitted =
-                (totalPhotonsToEmit > photonsToEmit) ? (totalPhotonsToEmit - photonsToEmit) : 0;
-            const double emittedFraction =
-                (totalPhotonsToEmit > 0)
-                    ? std::max(1e-6, static_cast<double>(emitted) / static_cast<double>(totalPhotonsToEmit))
-                    : 1.0;
-            preview(*previewBuffer, emittedFraction, previewCamera->saturationLuminance());
+            std::rethrow_exception(workerException);
         }
-    }
 
-    for (size_t i = 0; i < effectiveWorkerCount; ++i)
+        if (drainStalled)
+        {
+            throw std::runtime_error(
+                "Render drain stalled: all workers exited with photon work still "
+                "outstanding. This indicates a worker terminated abnormally without "
+                "surfacing an exception.");
+        }
+
+        return !aborted;
+    };
+
+    // ===== Photon passes =====
+    //
+    // One pass normally. A PROGRESSIVE render ($progressivePasses > 1, probe mode
+    // only) runs that many passes, folds each pass's deposits into per-record
+    // statistics (ProbeGather::accumulateProgressive) and drops the store before
+    // the next pass, so memory stays at one pass's deposits however long it runs.
+    const size_t passes =
+        (settings.useProbeGather && settings.progressivePasses > 1) ? settings.progressivePasses : 1;
+    const bool progressive = passes > 1;
+    std::unordered_map<const Camera*, ProbeGather::ProgressiveState> progressiveStates;
+    std::unordered_map<const Camera*, std::size_t> progressiveDeposits;
+    if (progressive)
     {
-        workers[i]->stop();
+        for (const Camera* cam : probeCameras)
+        {
+            progressiveStates.emplace(
+                cam,
+                ProbeGather::beginProgressive(*cameraGatherPoints.at(cam), probeGatherMinRadius));
+        }
     }
-
-    if (workerException)
+    std::uint64_t droppedDeposits = 0;
+    std::uint64_t attemptedDeposits = 0;
+    bool aborted = false;
+    if (streamingGather && settings.shardIndex == 0)
     {
-        std::rethrow_exception(workerException);
+        // The emitter fixtures' deposits, folded in like any other kept bounce.
+        const double depositSpacing = std::max(bounceIndexCell * 0.5, 1e-6);
+        const ProbeGather::EmitterDepositResult emit = ProbeGather::depositEmitters(
+            scene.objects, *probeIndex, depositSpacing, *streamingGather);
+        result.emitterDepositsKept = emit.kept;
     }
-
-    if (drainStalled)
+    // The checkpoint of this frame: which render it is, and (filled in as the
+    // passes go) how far it got. A resumed frame takes up the saved statistics and
+    // counters and goes on from the first pass the checkpoint had not run.
+    RenderCheckpoint checkpoint;
+    size_t firstPass = 0;
+    if (checkpointing)
+    {
+        checkpoint.frameTime = settings.frameTime;
+        checkpoint.photonsPerLight = settings.photonsPerLight;
+        checkpoint.progressivePasses = passes;
+        checkpoint.progressiveAlpha = settings.progressiveAlpha;
+        checkpoint.seed = baseSeed;
+        checkpoint.views.resize(probeCameras.size());
+        for (size_t v = 0; v < probeCameras.size(); ++v)
+        {
+            checkpoint.views[v].records = cameraGatherPoints.at(probeCameras[v])->size();
+        }
+    }
+    if (checkpointing && settings.resumeFromCheckpoint &&
+        std::filesystem::exists(settings.checkpointPath))
+    {
+        RenderCheckpoint saved = RenderCheckpoint::read(settings.checkpointPath);
+        if (!saved.sameRender(checkpoint))
+        {
+            throw std::runtime_error("Renderer: " + settings.checkpointPath.generic_string() +
+                                     " is the checkpoint of another render");
+        }
+        firstPass = saved.passesDone;
+        result.resumedPasses = saved.passesDone;
+        result.photonsEmitted = saved.photonsEmitted;
+        droppedDeposits = saved.droppedDeposits;
+        attemptedDeposits = saved.attemptedDeposits;
+        for (size_t v = 0; v < probeCameras.size(); ++v)
+        {
+            progressiveStates.at(probeCameras[v]) = std::move(saved.views[v].state);
+            progressiveDeposits[probeCameras[v]] = saved.views[v].deposits;
+        }
+    }
+    for (size_t pass = firstPass; pass < passes && !aborted; ++pass)
     {
-        throw std::runtime_error(
-            "Render drain stalled: all workers exited with photon work still "
-            "outstanding. This indicates a worker terminated abnormally without "
-            "surfacing an exception.");
+        if (settings.useProbeGather && !streamingGather)
+        {
+            bounceStore.reset();  // release the previous pass's deposits first
+            openBounceStore();
+        }
+        aborted = !runPhotonPass(pass);
+        if (bounceStore)
+        {
+            droppedDeposits += bounceStore->droppedCount();
+            attemptedDeposits += bounceStore->attemptedCount();
+        }
+        if (progressive)
+        {
+            indexBounceStore();
+            for (const Camera* cam : probeCameras)
+            {
+                progressiveDeposits[cam] += ProbeGather::accumulateProgressive(
+                    *cameraGatherPoints.at(cam), *bounceStore, *scene.materialLibrary,
+                    effectiveWorkerCount, probeGatherMinRadius,
+                    static_cast<float>(settings.shutterTime), settings.progressiveAlpha,
+                    progressiveStates.at(cam));
+            }
+        }
+        // Lend the statistics to the checkpoint while it is written. Not after an
+        // aborted pass (it stopped part way) nor after the last (the frame is done).
+        if (checkpointing && !aborted && pass + 1 < passes &&
+            (pass + 1) % settings.checkpointPasses == 0)
+        {
+            checkpoint.passesDone = pass + 1;
+            checkpoint.photonsEmitted = result.photonsEmitted;
+            checkpoint.droppedDeposits = droppedDeposits;
+            checkpoint.attemptedDeposits = attemptedDeposits;
+            for (size_t v = 0; v < probeCameras.size(); ++v)
+            {
+                checkpoint.views[v].deposits = progressiveDeposits[probeCameras[v]];
+                checkpoint.views[v].state = std::move(progressiveStates.at(probeCameras[v]));
+            }
+            std::exception_ptr writeError;
+            try
+            {
+                checkpoint.write(settings.checkpointPath);
+            }
+            catch (...)
+            {
+                writeError = std::current_exception();
+            }
+            for (size_t v = 0; v < probeCameras.size(); ++v)
+            {
+                progressiveStates.at(probeCameras[v]) = std::move(checkpoint.views[v].state);
+            }
+            if (writeError)
+            {
+                std::rethrow_exception(writeError);
+            }
+        }
     }
 
     // Even on a caller-requested abort, tonemap whatever has accumulated so the
@@ -599,12 +1206,6 @@ RenderResult renderFrame(const LoadedScene& scene, ProgressCallback progress,
     // this).
     (void)aborted;
 
-    // Storage pivot: the photon pass produced the DIRECT image via the forward
-    // SPLAT (into each camera's splat buffer — no per-photon storage) and filled
-    // the compact DENSITY GRID with non-delta bounce energy for reflections. We
-    // keep exposure parameters for the per-camera tonemap.
-    const double photonsEmitted = static_cast<double>(settings.photonsPerLight);
-
     // Memory evidence: high-water-mark occupancy of the (now sole) photon queue.
     result.peakPhotonQueue = photonQueue->largestAllocated();
 
@@ -617,28 +1218,19 @@ RenderResult renderFrame(const LoadedScene& scene, ProgressCallback progress,
     result.photonPassSeconds =
         std::chrono::duration<double>(photonPassEnd - photonPassStart).count();
 
-    result.cameras.reserve(cameras.size());
-
     // Phase 2a: build the raw-bounce spatial index ONCE after the photon pass
-    // drains (single-threaded). The unified gather queries it per camera.
+    // drains (single-threaded). The unified gather queries it per camera. (A
+    // progressive render indexed and folded each pass's store as it went.)
     if (settings.useProbeGather && bounceStore)
     {
-        const std::shared_ptr<Camera>& primaryCam =
-            cameras.empty() ? scene.camera : cameras.front();
-        // Bounce-index cell size = the gather footprint scale, so a radius-r
-        // query touches a 3x3x3 neighborhood. Reuse the scene-depth footprint.
-        double gatherCell = cellSize;
-        if (sceneDepthFootprint > 0.0)
-        {
-            gatherCell = sceneDepthFootprint;
-        }
-        (void)primaryCam;
-
         // Emitter fixture deposits were appended to the store BEFORE the photon pass
         // (see the depositEmitters call at store allocation, issue #62) so an overflow
         // can never drop them. buildIndex here indexes the full populated prefix
         // (emitter deposits + photon-pass deposits) once the photon pass drains.
-        bounceStore->buildIndex(gatherCell);
+        if (!progressive)
+        {
+            indexBounceStore();
+        }
         result.bounceStore = bounceStore;
 
         // OVERFLOW SIGNALING. The BounceStore drops deposits past its capacity
@@ -650,15 +1242,16 @@ RenderResult renderFrame(const LoadedScene& scene, ProgressCallback progress,
         // sees, plus a counter on RenderResult, plus a debug assert. Do NOT make
         // this conditional on a stdout-logging flag — a wrong image must warn
         // unconditionally.
-        result.bounceStoreDropped = bounceStore->droppedCount();
+        result.bounceStoreDropped = droppedDeposits;
         if (result.bounceStoreDropped > 0)
         {
             std::cerr << "WARNING: BounceStore overflow — dropped "
                       << result.bounceStoreDropped << " of "
-                      << bounceStore->attemptedCount()
+                      << attemptedDeposits
                       << " deposits (capacity " << bounceStore->capacity()
                       << "). The rendered image is missing energy; raise "
-                         "$bounceStoreCapacity or lower the photon budget."
+                         "$bounceStoreCapacity (with $bounceStoreResidentMiB to spill "
+                         "past RAM) or lower the photon budget."
                       << std::endl;
             // In debug builds, make an overflow a hard stop so it cannot be
             // ignored during development. Release builds warn + continue so a
@@ -667,10 +1260,74 @@ RenderResult renderFrame(const LoadedScene& scene, ProgressCallback progress,
         }
     }
 
+    // Hand this frame's records to the cache for the next frame. The cache shares
+    // them, so the next frame's probe pass may read them (and replace the cache's
+    // handle) while this frame is still gathering from them.
+    if (cache)
+    {
+        for (const auto& entry : cameraGatherPoints)
+        {
+            cache->cameras[entry.first].points = entry.second;
+        }
+        cache->primed = true;
+    }
+
+    // Everything the gather reads moves into the pending frame, with a copy of the
+    // scene: its settings are frozen here, so the caller may move frameTime on and
+    // begin the next frame while this one finishes.
+    auto frame = std::make_shared<PendingFrame>();
+    frame->scene = scene;
+    frame->result = std::move(result);
+    frame->cameras = std::move(cameras);
+    frame->splatBuffers = std::move(splatBuffers);
+    frame->animationQuery = std::move(animationQuery);
+    frame->densityGrid = std::move(densityGrid);
+    frame->probeIndex = std::move(probeIndex);
+    frame->bounceStore = std::move(bounceStore);
+    frame->streamingGather = std::move(streamingGather);
+    frame->cameraGatherPoints = std::move(cameraGatherPoints);
+    frame->probeCameras = std::move(probeCameras);
+    frame->progressiveStates = std::move(progressiveStates);
+    frame->progressiveDeposits = std::move(progressiveDeposits);
+    frame->effectiveWorkerCount = effectiveWorkerCount;
+    frame->probeGatherMinRadius = probeGatherMinRadius;
+    return frame;
+}
+
+RenderResult finishFrame(PendingFrame& frame)
+{
+    const LoadedScene& scene = frame.scene;
+    const RenderSettings& settings = scene.settings;
+    RenderResult result = std::move(frame.result);
+    const std::vector<std::shared_ptr<Camera>>& cameras = frame.cameras;
+    const std::vector<std::shared_ptr<Buffer>>& splatBuffers = frame.splatBuffers;
+    const std::shared_ptr<AnimationQuery>& animationQuery = frame.animationQuery;
+    const std::shared_ptr<DensityGrid>& densityGrid = frame.densityGrid;
+    const std::shared_ptr<BounceStore>& bounceStore = frame.bounceStore;
+    const std::shared_ptr<StreamingGather>& streamingGather = frame.streamingGather;
+    const auto& cameraGatherPoints = frame.cameraGatherPoints;
+    const std::vector<const Camera*>& probeCameras = frame.probeCameras;
+    const auto& progressiveStates = frame.progressiveStates;
+    const auto& progressiveDeposits = frame.progressiveDeposits;
+    const size_t effectiveWorkerCount = frame.effectiveWorkerCount;
+    const double probeGatherMinRadius = frame.probeGatherMinRadius;
+
+    // Storage pivot: the photon pass produced the DIRECT image via the forward
+    // SPLAT (into each camera's splat buffer — no per-photon storage) and filled
+    // the compact DENSITY GRID with non-delta bounce energy for reflections. We
+    // keep exposure parameters for the per-camera tonemap.
+    const double photonsEmitted = static_cast<double>(settings.photonsPerLight);
+
+    result.cameras.reserve(cameras.size());
+
+    // One-shot probe gathers are collected here and run together after the loop.
+    std::vector<ProbeGather::CameraGather> combinedGather;
+    std::vector<size_t> combinedCameras;  // their indices in result.cameras
+
     // MULTI-CAMERA: the photon pass / splat / grid above are a SINGLE shared solve.
     // Each camera already has its own splat buffer (direct image). Now composite
     // the MIRROR GATHER into that buffer's black delta pixels — reflected radiance
-    // looked up from the shared density grid — and tonemap into the camera image.
+    // looked up from the shared density grid. The tonemaps follow the loop.
     size_t splatIndex = 0;
     for (const auto& cam : cameras)
     {
@@ -695,7 +1352,7 @@ RenderResult renderFrame(const LoadedScene& scene, ProgressCallback progress,
         const bool debugCamera = (cam->bounceFilter() >= 0) || (cam->lightFilter() >= 0);
 
         const std::chrono::time_point gatherStart = std::chrono::system_clock::now();
-        if (settings.useProbeGather && bounceStore)
+        if (settings.useProbeGather && (bounceStore || streamingGather))
         {
             // Phase 2a UNIFIED GATHER: one path renders both directly-visible
             // diffuse (extension depth 0) AND reflected/refracted diffuse
@@ -707,19 +1364,34 @@ RenderResult renderFrame(const LoadedScene& scene, ProgressCallback progress,
                 // PURE COLLECTION: gather over THIS camera's own records (produced by
                 // the probe pass = the single specular tracer). No ray casting here.
                 const auto recordsIt = cameraGatherPoints.find(cam.get());
-                static const std::vector<ProbeGather::GatherPoint> kNoRecords;
-                const std::vector<ProbeGather::GatherPoint>& camRecords =
-                    (recordsIt != cameraGatherPoints.end()) ? recordsIt->second
+                static const ProbeGather::GatherPointStore kNoRecords;
+                const ProbeGather::GatherPointStore& camRecords =
+                    (recordsIt != cameraGatherPoints.end()) ? *recordsIt->second
                                                             : kNoRecords;
-                cr.probe = ProbeGather::run(
-                    cam,
-                    camRecords,
-                    *bounceStore,
-                    *scene.materialLibrary,
-                    effectiveWorkerCount,
-                    probeGatherMinRadius,
-                    *imageBuffer,
-                    static_cast<float>(settings.shutterTime));
+                const auto stateIt = progressiveStates.find(cam.get());
+                if (streamingGather)
+                {
+                    // Streaming: the photon pass already summed each record's flux.
+                    const std::size_t slot = static_cast<std::size_t>(
+                        std::find(probeCameras.begin(), probeCameras.end(), cam.get()) -
+                        probeCameras.begin());
+                    cr.probe = streamingGather->resolve(slot, cam, *scene.materialLibrary,
+                                                        *imageBuffer);
+                }
+                else if (stateIt != progressiveStates.end())
+                {
+                    // Progressive: the passes already gathered; write the estimate.
+                    cr.probe = ProbeGather::resolveProgressive(cam, camRecords,
+                                                               stateIt->second, *imageBuffer);
+                    cr.probe.depositsAccum = progressiveDeposits.at(cam.get());
+                }
+                else
+                {
+                    // One-shot: queued for the combined gather below.
+                    combinedGather.push_back(
+                        ProbeGather::CameraGather{cam, &camRecords, imageBuffer.get()});
+                    combinedCameras.push_back(result.cameras.size());
+                }
             }
             // Light fixtures are NOT a separate pass in probe mode: each emitter
             // deposited its own surface radiance as raw bounces (depositEmitters
@@ -747,7 +1419,7 @@ RenderResult renderFrame(const LoadedScene& scene, ProgressCallback progress,
             // case in the tracer) and writes it into the pixels the fixture is
             // visible in. Composites into the same buffer; skipped for debug
             // cameras (which isolate deposits, not direct emitter visibility).
-            if (imageBuffer && !debugCamera)
+            if (imageBuffer && !debugCamera && settings.shardIndex == 0)
             {
                 cr.emissive = EmissiveGather::run(
                     scene.objects,
@@ -761,32 +1433,72 @@ RenderResult renderFrame(const LoadedScene& scene, ProgressCallback progress,
 
         cr.gatherSeconds = std::chrono::duration<double>(gatherEnd - gatherStart).count();
         cr.buffer = imageBuffer;
+        result.cameras.push_back(std::move(cr));
+    }
 
-        // Tonemap the composited buffer (direct splat + mirror reflections) through
-        // THIS camera's exposure into a fresh image at the camera's resolution.
-        cr.image = std::make_shared<Image>(cam->width(), cam->height());
-        cr.image->clear();
-        if (imageBuffer)
+    // The one-shot probe gathers, all cameras at once over the shared store: their
+    // tiles share one thread set, so many small cameras fill it as one large one
+    // would. Each camera's gather time is the combined gather's.
+    if (!combinedGather.empty())
+    {
+        const std::chrono::time_point gatherStart = std::chrono::system_clock::now();
+        const std::vector<ProbeGather::Result> gathered = ProbeGather::runCameras(
+            combinedGather, *bounceStore, *scene.materialLibrary, effectiveWorkerCount,
+            probeGatherMinRadius, static_cast<float>(settings.shutterTime),
+            settings.gatherSpatialOrder);
+        const double gatherSeconds =
+            std::chrono::duration<double>(std::chrono::system_clock::now() - gatherStart).count();
+        for (size_t k = 0; k < combinedCameras.size(); ++k)
         {
-            tonemapBufferToImage(*imageBuffer, *cr.image, photonsEmitted,
-                                 cam->saturationLuminance());
+            CameraRender& cr = result.cameras[combinedCameras[k]];
+            cr.probe = gathered[k];
+            cr.gatherSeconds += gatherSeconds;
+        }
+    }
 
-            double sum = 0.0;
-            const size_t w = cam->width();
-            const size_t h = cam->height();
-            for (size_t y = 0; y < h; ++y)
+    // Tonemap each composited buffer (direct splat + mirror reflections, or the
+    // probe gather) through ITS camera's exposure into a fresh image at the
+    // camera's resolution, and take its mean luminance. The cameras are independent
+    // tasks on up to `effectiveWorkerCount` threads; with fewer cameras than that,
+    // each splits its rows over the spare threads.
+    {
+        const size_t threads =
+            std::min(std::max<size_t>(1, effectiveWorkerCount), result.cameras.size());
+        const size_t rowThreads =
+            std::max<size_t>(1, effectiveWorkerCount / std::max<size_t>(1, threads));
+        std::atomic<size_t> nextCamera{0};
+        std::vector<std::exception_ptr> errors(result.cameras.size());
+        const auto tonemapCameras = [&]() {
+            for (size_t c = nextCamera.fetch_add(1); c < result.cameras.size();
+                 c = nextCamera.fetch_add(1))
             {
-                for (size_t x = 0; x < w; ++x)
+                try
                 {
-                    const Color c = imageBuffer->fetchColor({x, y});
-                    sum += (static_cast<double>(c.red) + c.green + c.blue) / 3.0;
+                    tonemapCamera(result.cameras[c], photonsEmitted, rowThreads);
+                }
+                catch (...)
+                {
+                    errors[c] = std::current_exception();
                 }
             }
-            const double pixels = static_cast<double>(w) * static_cast<double>(h);
-            cr.meanLuminance = (pixels > 0.0) ? (sum / pixels) : 0.0;
+        };
+        std::vector<std::thread> pool;
+        for (size_t t = 1; t < threads; ++t)
+        {
+            pool.emplace_back(tonemapCameras);
+        }
+        tonemapCameras();
+        for (auto& thread : pool)
+        {
+            thread.join();
+        }
+        for (const std::exception_ptr& error : errors)
+        {
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
         }
-
-        result.cameras.push_back(std::move(cr));
     }
 
     // Back-compat: surface the PRIMARY (first) camera's buffer/image + mirror
@@ -808,4 +1520,38 @@ RenderResult renderFrame(const LoadedScene& scene, ProgressCallback progress,
     return result;
 }
 
+std::size_t pendingFrameBytes(const PendingFrame& frame)
+{
+    // Each camera's splat buffer, and the image its tonemap will add.
+    std::size_t bytes = 0;
+    for (const auto& cam : frame.cameras)
+    {
+        if (cam)
+        {
+            bytes += cam->width() * cam->height() * (3 * sizeof(std::atomic<float>) + sizeof(Pixel));
+        }
+    }
+    for (const auto& entry : frame.cameraGatherPoints)
+    {
+        bytes += entry.second->memoryBytes();
+    }
+    for (const auto& entry : frame.progressiveStates)
+    {
+        bytes += entry.second.memoryBytes();
+    }
+    if (frame.bounceStore)
+    {
+        bytes += frame.bounceStore->memoryBytes();
+    }
+    if (frame.streamingGather)
+    {
+        bytes += frame.streamingGather->memoryBytes();
+    }
+    if (frame.densityGrid)
+    {
+        bytes += frame.densityGrid->memoryBytes();
+    }
+    return bytes;
+}
+
 }
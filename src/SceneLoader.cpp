@@ -844,12 +844,55 @@ LoadedScene loadFromFile(const std::filesystem::path& scenePath, bool logToStdou
         // store capacity, keep-radius scale, and probe sub-sample are tunables.
         setFromJsonIfPresent(settings.useProbeGather, renderConfiguration, "$probeGather", logToStdout);
         setFromJsonIfPresent(settings.bounceStoreCapacity, renderConfiguration, "$bounceStoreCapacity", logToStdout);
+        setFromJsonIfPresent(settings.bounceStoreResidentMiB, renderConfiguration, "$bounceStoreResidentMiB", logToStdout);
+        setFromJsonIfPresent(settings.depositMergeScale, renderConfiguration, "$depositMergeScale", logToStdout);
         setFromJsonIfPresent(settings.probeKeepRadiusScale, renderConfiguration, "$probeKeepRadiusScale", logToStdout);
         setFromJsonIfPresent(settings.probeSubSample, renderConfiguration, "$probeSubSample", logToStdout);
-        // Animation temporal-coverage tunables (probe time slices + camera motion-
+        setFromJsonIfPresent(settings.gatherSpatialOrder, renderConfiguration, "$gatherSpatialOrder", logToStdout);
+        // Animation temporal tunables (deposit-index time slices + camera motion-
         // blur samples). Ignored when shutterTime == 0 (static baseline).
         setFromJsonIfPresent(settings.probeTimeSlices, renderConfiguration, "$probeTimeSlices", logToStdout);
         setFromJsonIfPresent(settings.cameraTimeSamples, renderConfiguration, "$cameraTimeSamples", logToStdout);
+        setFromJsonIfPresent(settings.adaptiveCameraSamples, renderConfiguration, "$adaptiveCameraSamples", logToStdout);
+        setFromJsonIfPresent(settings.probeFrameReuse, renderConfiguration, "$probeFrameReuse", logToStdout);
+        // Progressive (SPPM) gather: photon passes folded into per-record radius /
+        // flux statistics, one pass's deposits in memory at a time.
+        setFromJsonIfPresent(settings.progressivePasses, renderConfiguration, "$progressivePasses", logToStdout);
+        setFromJsonIfPresent(settings.progressiveAlpha, renderConfiguration, "$progressiveAlpha", logToStdout);
+        if (settings.progressiveAlpha <= 0.0 || settings.progressiveAlpha > 1.0)
+        {
+            throw std::runtime_error("$progressiveAlpha must be in (0, 1]");
+        }
+        // Checkpoint a progressive frame every this many passes (`--resume`).
+        setFromJsonIfPresent(settings.checkpointPasses, renderConfiguration, "$checkpointPasses", logToStdout);
+        // Streaming gather: matte views fold deposits into their records during
+        // the photon pass instead of storing them.
+        setFromJsonIfPresent(settings.streamingGather, renderConfiguration, "$streamingGather", logToStdout);
+        // Frame pipeline: animation frames in flight at once, and their memory cap.
+        setFromJsonIfPresent(settings.pipelineDepth, renderConfiguration, "$pipelineDepth", logToStdout);
+        setFromJsonIfPresent(settings.pipelineMemoryMiB, renderConfiguration, "$pipelineMemoryMiB", logToStdout);
+        // Float output: every camera's radiance buffer as an EXR beside the PNG.
+        setFromJsonIfPresent(settings.exrOutput, renderConfiguration, "$exrOutput", logToStdout);
+        setFromJsonIfPresent(settings.exrHalf, renderConfiguration, "$exrHalf", logToStdout);
+        std::string exrCompression;
+        setFromJsonIfPresent(exrCompression, renderConfiguration, "$exrCompression", logToStdout);
+        if (exrCompression == "none")
+        {
+            settings.exrCompression = ExrCompression::None;
+        }
+        else if (exrCompression == "zips")
+        {
+            settings.exrCompression = ExrCompression::Zips;
+        }
+        else if (exrCompression.empty() || exrCompression == "zip")
+        {
+            settings.exrCompression = ExrCompression::Zip;
+        }
+        else
+        {
+            throw std::runtime_error("Unknown $exrCompression \"" + exrCompression +
+                                     "\" (expected none | zips | zip)");
+        }
 
         // Deterministic test mode: $seed plumbs a fixed RNG seed (replacing the
         // random_device default); $deterministic forces the single-thread,
@@ -41,6 +41,12 @@ double SphereVolume::radius() const
     return m_sphere.radius;
 }
 
+std::optional<Bounds> SphereVolume::localBounds() const
+{
+    const Vector extent{m_sphere.radius, m_sphere.radius, m_sphere.radius};
+    return Bounds{m_sphere.center - extent, m_sphere.center + extent};
+}
+
 std::optional<Hit> SphereVolume::castTransformedRay(const Ray& ray, std::vector<Hit>& /*castBuffer*/) const
 {
     return rayIntersectsSphere(ray, m_sphere);
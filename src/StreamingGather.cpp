@@ -0,0 +1,240 @@
+#include "StreamingGather.h"
+
+#include "LambertianMaterial.h"
+#include "UnitVector.h"
+#include "Utility.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+
+constexpr std::size_t kEmitterMaterial = ProbeGather::testing::kEmitterMaterial;
+
+// The gather's filter constants (ProbeGather.cpp, sumFootprintFlux): normal
+// agreement at cos 60° and a tangent-plane band of 2r.
+constexpr double kNormalAgree = 0.5;
+constexpr double kPlaneBandScale = 2.0;
+constexpr double kSelfHitThreshold = std::numeric_limits<double>::epsilon();
+
+}  // namespace
+
+StreamingGather::StreamingGather(std::vector<const ProbeGather::GatherPointStore*> cameraRecords,
+                                 std::vector<Source> sources,
+                                 const ProbeIndex& index,
+                                 double minGatherRadius,
+                                 float shutterTime)
+    : m_index(index)
+    , m_sources(std::move(sources))
+    , m_timeHalfWindow(std::max(0.0f, shutterTime))
+{
+    m_cameras.resize(cameraRecords.size());
+    for (std::size_t c = 0; c < cameraRecords.size(); ++c)
+    {
+        CameraState& state = m_cameras[c];
+        state.records = cameraRecords[c];
+        const std::size_t count = state.records ? state.records->size() : 0;
+        state.targets.resize(count);
+        state.flux = std::make_unique<std::atomic<float>[]>(count * 3);
+        for (std::size_t i = 0; i < count * 3; ++i)
+        {
+            state.flux[i].store(0.0f, std::memory_order_relaxed);
+        }
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const ProbeGather::GatherPoint gp = (*state.records)[i];
+            Target& target = state.targets[i];
+            target.nx = static_cast<float>(gp.normal.x);
+            target.ny = static_cast<float>(gp.normal.y);
+            target.nz = static_cast<float>(gp.normal.z);
+            target.radius = static_cast<float>(
+                Utility::flooredSplatRadius(gp.footprintRadius, minGatherRadius));
+            target.time = gp.sampleTime;
+            target.emitter = (gp.materialIndex == kEmitterMaterial);
+            m_searchRadius = std::max(m_searchRadius, static_cast<double>(target.radius));
+        }
+    }
+
+    for (const Source& source : m_sources)
+    {
+        if (source.camera >= m_cameras.size() || !m_cameras[source.camera].records)
+        {
+            throw std::runtime_error("StreamingGather: source names an unknown camera");
+        }
+    }
+}
+
+bool StreamingGather::supports(const ProbeGather::GatherPointStore& records,
+                               const MaterialLibrary& materials)
+{
+    // Resolve each material index once: a scene has a handful of materials and a
+    // frame millions of records.
+    std::vector<signed char> matte;
+    for (std::size_t i = 0; i < records.size(); ++i)
+    {
+        const std::size_t material = records[i].materialIndex;
+        if (material == kEmitterMaterial)
+        {
+            continue;
+        }
+        if (material >= matte.size())
+        {
+            matte.resize(material + 1, -1);
+        }
+        if (matte[material] < 0)
+        {
+            const std::shared_ptr<Material> resolved = materials.fetchByIndex(material);
+            matte[material] =
+                (dynamic_cast<const LambertianMaterial*>(resolved.get()) != nullptr) ? 1 : 0;
+        }
+        if (matte[material] == 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool StreamingGather::deposit(const RawBounce& bounce,
+                              std::vector<ProbeIndex::ProbeRef>& scratch) noexcept
+{
+    const Vector position = bounce.position();
+    m_index.collectWithin(position, m_searchRadius, scratch);
+
+    // The deposit's unit normal, for the normal-agreement test.
+    const Vector dn = bounce.normal();
+    const double dnLen = dn.magnitude();
+    const bool hasNormal = dnLen > kSelfHitThreshold;
+    const Vector depositNormal = hasNormal ? dn / dnLen : dn;
+    const bool timeless = (bounce.time == RawBounce::kTimelessDeposit);
+
+    bool taken = false;
+    for (const ProbeIndex::ProbeRef& ref : scratch)
+    {
+        const Source& source = m_sources[ref.source];
+        CameraState& camera = m_cameras[source.camera];
+        const std::size_t i = source.begin + ref.index;
+        const Target& target = camera.targets[i];
+
+        const Vector offset = position - camera.records->position(i);
+        const double r = target.radius;
+        if (Vector::dot(offset, offset) > r * r)
+        {
+            continue;
+        }
+        if (!timeless && std::abs(bounce.time - target.time) > m_timeHalfWindow)
+        {
+            continue;
+        }
+
+        const Vector normal{target.nx, target.ny, target.nz};
+        if (target.emitter)
+        {
+            if (Vector::dot(dn, normal) < kNormalAgree)
+            {
+                continue;
+            }
+        }
+        else
+        {
+            if (hasNormal && Vector::dot(depositNormal, normal) < kNormalAgree)
+            {
+                continue;
+            }
+            if (std::abs(Vector::dot(offset, normal)) > kPlaneBandScale * r)
+            {
+                continue;
+            }
+            // f(wi, wo) of a Lambertian is zero for light arriving from below.
+            if (Vector::dot(-bounce.incoming(), normal) <= 0.0)
+            {
+                continue;
+            }
+        }
+
+        std::atomic<float>* flux = &camera.flux[i * 3];
+        flux[0].fetch_add(bounce.power.red, std::memory_order_relaxed);
+        flux[1].fetch_add(bounce.power.green, std::memory_order_relaxed);
+        flux[2].fetch_add(bounce.power.blue, std::memory_order_relaxed);
+        taken = true;
+    }
+    if (taken)
+    {
+        m_deposits.fetch_add(1, std::memory_order_relaxed);
+    }
+    return taken;
+}
+
+ProbeGather::Result StreamingGather::resolve(std::size_t camera,
+                                             const std::shared_ptr<Camera>& view,
+                                             const MaterialLibrary& materials,
+                                             Buffer& buffer) const
+{
+    ProbeGather::Result result;
+    if (!view || camera >= m_cameras.size() || !m_cameras[camera].records)
+    {
+        return result;
+    }
+    const CameraState& state = m_cameras[camera];
+    const ProbeGather::GatherPointStore& records = *state.records;
+    result.pixelsHit = records.size();
+
+    // The gather's normalization: splat parity 4/pi over the disc area.
+    const double kSplatParity = 4.0 / Utility::pi;
+    for (std::size_t i = 0; i < records.size(); ++i)
+    {
+        const Color flux{state.flux[i * 3].load(std::memory_order_relaxed),
+                         state.flux[i * 3 + 1].load(std::memory_order_relaxed),
+                         state.flux[i * 3 + 2].load(std::memory_order_relaxed)};
+        const double r = state.targets[i].radius;
+        if (r <= 0.0 || (flux.red == 0.0f && flux.green == 0.0f && flux.blue == 0.0f))
+        {
+            continue;
+        }
+        const ProbeGather::GatherPoint gp = records[i];
+        if (Vector::dot(gp.viewDir, gp.normal) <= 0.0)
+        {
+            continue;  // surface faces away from the viewer
+        }
+
+        // f is constant over the upper hemisphere: evaluate it once with wi = n.
+        Color f{1.0f, 1.0f, 1.0f};
+        if (!state.targets[i].emitter)
+        {
+            const std::shared_ptr<Material> material = materials.fetchByIndex(gp.materialIndex);
+            if (!material)
+            {
+                continue;
+            }
+            const UnitVector normal = UnitVector::alreadyNormalized(gp.normal);
+            f = material->evaluate(gp.normal, gp.viewDir, normal);
+        }
+
+        const float scale = static_cast<float>(kSplatParity / (Utility::pi * r * r));
+        const Color contribution = gp.specularThroughput * (f * flux * scale) * gp.sampleWeight;
+        buffer.addColor(gp.pixel, contribution);
+
+        ++result.pixelsGathered;
+        const double peak = std::max({static_cast<double>(contribution.red),
+                                      static_cast<double>(contribution.green),
+                                      static_cast<double>(contribution.blue)});
+        result.maxRadiance = std::max(result.maxRadiance, peak);
+        result.sumRadiance += 0.2126 * contribution.red + 0.7152 * contribution.green +
+                              0.0722 * contribution.blue;
+    }
+    return result;
+}
+
+std::size_t StreamingGather::memoryBytes() const noexcept
+{
+    std::size_t bytes = 0;
+    for (const CameraState& state : m_cameras)
+    {
+        const std::size_t count = state.targets.size();
+        bytes += count * (sizeof(Target) + 3 * sizeof(std::atomic<float>));
+    }
+    return bytes;
+}
@@ -111,6 +111,12 @@ std::shared_ptr<typename Tree<T>::Node> Tree<T>::root() noexcept
     return m_root;
 }
 
+template<typename T>
+Bounds Tree<T>::bounds() const noexcept
+{
+    return m_root ? m_root->bounds : Bounds{};
+}
+
 template<typename T>
 size_t Tree<T>::size() const noexcept
 {
@@ -390,6 +396,7 @@ template size_t Tree<Triangle>::Node::nodeCount() const noexcept;
 template size_t Tree<Triangle>::Node::nodeDepth() const noexcept;
 template Tree<Triangle>::Tree(const std::vector<Triangle>& objects, size_t pageSize);
 template std::shared_ptr<typename Tree<Triangle>::Node> Tree<Triangle>::root() noexcept;
+template Bounds Tree<Triangle>::bounds() const noexcept;
 template size_t Tree<Triangle>::size() const noexcept;
 template size_t Tree<Triangle>::nodeCount() const noexcept;
 template size_t Tree<Triangle>::nodeDepth() const noexcept;
@@ -2,6 +2,9 @@
 
 #include "AnimationQuery.h"
 
+#include <algorithm>
+#include <array>
+
 Volume::Volume()
     : Object()
     , m_materialIndex(-1)
@@ -48,6 +51,65 @@ std::optional<Hit> Volume::castRayAt(const Ray& ray, std::vector<Hit>& castBuffe
     return hit;
 }
 
+std::optional<Bounds> Volume::localBounds() const
+{
+    return std::nullopt;
+}
+
+std::optional<Bounds> Volume::sweptBounds(float begin, float end, const AnimationQuery* animation) const
+{
+    const std::optional<Bounds> local = localBounds();
+    if (!local)
+    {
+        return std::nullopt;
+    }
+
+    const Vector lo = local->minimum();
+    const Vector hi = local->maximum();
+    const std::array<Vector, 8> corners{
+        Vector{lo.x, lo.y, lo.z}, Vector{hi.x, lo.y, lo.z},
+        Vector{lo.x, hi.y, lo.z}, Vector{hi.x, hi.y, lo.z},
+        Vector{lo.x, lo.y, hi.z}, Vector{hi.x, lo.y, hi.z},
+        Vector{lo.x, hi.y, hi.z}, Vector{hi.x, hi.y, hi.z},
+    };
+
+    // Sixteen poses across the interval (one for an instant). The pad is the
+    // largest distance any corner moved between two consecutive poses, which
+    // covers the arc a rotating corner bulges out by between them.
+    constexpr int kSweepSamples = 16;
+    const int samples = (end > begin) ? kSweepSamples : 1;
+    std::optional<Bounds> swept;
+    std::array<Vector, 8> previous{};
+    double pad = 0.0;
+    for (int s = 0; s < samples; ++s)
+    {
+        const float time = (samples > 1)
+            ? begin + (end - begin) * static_cast<float>(s) / static_cast<float>(samples - 1)
+            : begin;
+        const Transform pose = resolveTransformAt(time, animation);
+        for (size_t c = 0; c < corners.size(); ++c)
+        {
+            const Vector world = pose.position + (pose.rotation * corners[c]);
+            if (s > 0)
+            {
+                pad = std::max(pad, (world - previous[c]).magnitude());
+            }
+            previous[c] = world;
+            if (swept)
+            {
+                *swept += Bounds{world};
+            }
+            else
+            {
+                swept = Bounds{world};
+            }
+        }
+    }
+
+    const Vector padding{pad, pad, pad};
+    return Bounds{swept->minimum() - padding, swept->maximum() + padding};
+}
+
 std::optional<Hit> Volume::castTransformedRay(const Ray& /*ray*/, std::vector<Hit>& /*castBuffer*/) const
 {
     // Base no-op: concrete volumes (PlaneVolume, SphereVolume, MeshVolume) override.
@@ -94,6 +94,22 @@ WorkQueue<T>::WorkQueue(size_t size)
 {
 }
 
+template<typename T>
+void WorkQueue<T>::reset()
+{
+    std::scoped_lock<std::mutex> lock(m_mutex);
+
+    m_initializing.clear();
+    m_processing.clear();
+    m_memoryHead = 0;
+    m_memoryTail = 0;
+    m_readyHead = 0;
+    m_readyTail = 0;
+    m_allocated = 0;
+    m_available = 0;
+    m_largestAllocated = 0;
+}
+
 template<typename T>
 typename WorkQueue<T>::Block WorkQueue<T>::initialize(size_t count)
 {
@@ -249,6 +265,7 @@ template Photon& WorkQueue<Photon>::Block::at(size_t accessIndex);
 template size_t WorkQueue<Photon>::Block::size() const;
 template std::vector<Photon> WorkQueue<Photon>::Block::toVector() const;
 template WorkQueue<Photon>::WorkQueue(size_t size);
+template void WorkQueue<Photon>::reset();
 template typename WorkQueue<Photon>::Block WorkQueue<Photon>::initialize(size_t count);
 template void WorkQueue<Photon>::ready(Block block);
 template typename WorkQueue<Photon>::Block WorkQueue<Photon>::fetch(size_t count);
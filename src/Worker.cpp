@@ -575,7 +575,7 @@ bool Worker::processPhotons()
             PhotonHit photonHit = m_volumeHitBuffer[minIndex];
             std::shared_ptr<Material> material = materialLibrary->fetchByIndex(photonHit.hit.material);
 
-            if (bounceStore && probeIndex)
+            if ((bounceStore || streamingGather) && probeIndex)
             {
                 // Phase 2a PROBE-GUIDED RAW STORAGE. A non-delta bounce is the
                 // diffuse/glossy radiance the camera can gather (directly or via a
@@ -596,7 +596,14 @@ bool Worker::processPhotons()
                                                photonHit.hit.normal,
                                                photonHit.photon.time,
                                                photonHit.photon.color};
-                        bounceStore->append(record);
+                        if (streamingGather)
+                        {
+                            streamingGather->deposit(record, m_probeRefs);
+                        }
+                        else
+                        {
+                            bounceStore->append(record);
+                        }
                         g_bounceKept.fetch_add(1, std::memory_order_relaxed);
                     }
                     else
@@ -4,10 +4,23 @@
 // here now live in the library (SceneLoader + Renderer) so the GUI editor can
 // drive the same code path. This file is now a thin CLI wrapper: parse args,
 // load the scene, render each frame, write PNGs, print timing.
+//
+//   ray-tracer <scene.json>                    render every frame to PNG
+//   ray-tracer <scene.json> --shard <i>/<N>    render photon shard i of N of every
+//                                              frame to a .rtpart partial frame
+//   ray-tracer merge <out> <partial>...        sum one frame's partials to <out>: a
+//                                              PNG, or the radiance as an .exr
+//
+// `--resume` continues an interrupted run: frames already written are skipped and
+// a progressive frame picks up from its last checkpoint ($checkpointPasses).
 
 #include "BounceStore.h"
+#include "Camera.h"
+#include "ExrWriter.h"
+#include "FramePipeline.h"
 #include "Image.h"
 #include "MirrorGather.h"
+#include "PartialFrame.h"
 #include "PngWriter.h"
 #include "Renderer.h"
 #include "SceneLoader.h"
@@ -17,7 +30,85 @@
 #include <exception>
 #include <filesystem>
 #include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <vector>
+
+namespace
+{
+
+// "<i>/<N>" with i < N.
+bool parseShard(const std::string& text, size_t& index, size_t& count)
+{
+    const size_t slash = text.find('/');
+    if (slash == std::string::npos || slash == 0 || slash + 1 == text.size())
+    {
+        return false;
+    }
+    try
+    {
+        size_t used = 0;
+        index = std::stoul(text.substr(0, slash), &used);
+        if (used != slash)
+        {
+            return false;
+        }
+        count = std::stoul(text.substr(slash + 1), &used);
+        if (used != text.size() - slash - 1)
+        {
+            return false;
+        }
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+    return count > 0 && index < count;
+}
+
+// `ray-tracer merge`: sum a frame's photon shards and tonemap the primary
+// camera's view, as the unsharded render would have written it — or, to an
+// .exr output, write its summed radiance as it is.
+int mergePartials(const std::filesystem::path& outputPath,
+                  const std::vector<std::filesystem::path>& partialPaths)
+{
+    try
+    {
+        std::vector<PartialFrame> shards;
+        for (const std::filesystem::path& path : partialPaths)
+        {
+            shards.push_back(PartialFrame::read(path));
+        }
+        const PartialFrame whole = PartialFrame::merge(shards);
+        if (whole.views.empty())
+        {
+            throw std::runtime_error("merge: the partial frames hold no camera");
+        }
+        if (outputPath.extension() == ".exr")
+        {
+            ExrWriter::Options exr;
+            exr.saturationLuminance = whole.views.front().saturationLuminance;
+            ExrWriter::writeBuffer(outputPath, *whole.buffer(0), exr);
+        }
+        else if (!PngWriter::writeImage(outputPath, *whole.image(0), outputPath.stem().string()))
+        {
+            throw std::runtime_error("merge: cannot write " + outputPath.generic_string());
+        }
+        std::cout << "Merged " << shards.size() << " shards of frame " << whole.frame
+                  << " (" << whole.photonsEmitted << " photons) into "
+                  << outputPath.generic_string() << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cout << "ERROR: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+}  // namespace
 
 int main(int argc, char** argv)
 {
@@ -28,10 +119,40 @@ int main(int argc, char** argv)
         std::cout << "Please provide a project file to process" << std::endl;
         return 1;
     }
-    else if (argc > 2)
+    if (std::string(argv[1]) == "merge")
     {
-        std::cout << "Too many arguments, only 1 required" << std::endl;
-        return 1;
+        if (argc < 4)
+        {
+            std::cout << "Usage: ray-tracer merge <output.png|.exr> <partial.rtpart>..." << std::endl;
+            return 1;
+        }
+        return mergePartials(argv[2], std::vector<std::filesystem::path>(argv + 3, argv + argc));
+    }
+
+    size_t shardIndex = 0;
+    size_t shardCount = 1;
+    bool resume = false;
+    for (int arg = 2; arg < argc; ++arg)
+    {
+        const std::string option = argv[arg];
+        if (option == "--shard" && arg + 1 < argc)
+        {
+            if (!parseShard(argv[++arg], shardIndex, shardCount))
+            {
+                std::cout << "Invalid shard " << argv[arg] << ", expected <i>/<N> with i < N"
+                          << std::endl;
+                return 1;
+            }
+        }
+        else if (option == "--resume")
+        {
+            resume = true;
+        }
+        else
+        {
+            std::cout << "Usage: ray-tracer <scene.json> [--shard <i>/<N>] [--resume]" << std::endl;
+            return 1;
+        }
     }
 
     std::filesystem::path projectFilePath = argv[1];
@@ -44,6 +165,8 @@ int main(int argc, char** argv)
     try
     {
         LoadedScene scene = SceneLoader::loadFromFile(projectFilePath, /*logToStdout=*/true);
+        scene.settings.shardIndex = shardIndex;
+        scene.settings.shardCount = shardCount;
 
         const size_t startFrame = scene.settings.startFrame;
         const size_t endFrame = scene.settings.endFrame;
@@ -54,88 +177,254 @@ int main(int argc, char** argv)
         std::cout << "Rendering image at " << scene.settings.imageWidth << " px by "
                   << scene.settings.imageHeight << " px" << std::endl;
 
-        for (size_t frame = startFrame; frame <= endFrame; ++frame)
+        // Probe-pass state carried between frames: a still camera re-traces only
+        // the screen tiles that can see something animated.
+        FrameCache frameCache;
+        // The photon queue, bounce store and splat buffers, reset in place from
+        // frame to frame instead of reallocated and faulted in again.
+        RenderContext renderContext;
+
+        // One frame between its first stage (on this thread) and its tail (gather,
+        // tonemap, PNG — on the pipeline's tail thread when frames overlap).
+        struct FrameJob
         {
-            std::cout << "---" << std::endl;
-            std::cout << "Rendering frame " << frame + 1 << " / " << frameCount << std::endl;
-
-            const std::chrono::time_point renderStart = std::chrono::system_clock::now();
-
-            // Map this frame index to TIME so the keyframed scene is sampled at the
-            // right instant: the shutter opens at frameOffset + frame/frameRate and
-            // the Renderer integrates over [t_open, t_open + shutterTime). This is
-            // the single point that turns a frame number into a scene time; a static
-            // scene with shutterTime 0 ignores it (all photons share one instant and
-            // there are no animated transforms).
-            const double frameRate = (scene.settings.frameRate > 0.0) ? scene.settings.frameRate : 24.0;
-            scene.settings.frameTime =
-                scene.settings.frameOffset + static_cast<double>(frame) / frameRate;
-
-            std::cout << "Frame time t=" << scene.settings.frameTime << "s"
-                      << " shutter=" << scene.settings.shutterTime << "s" << std::endl;
-
-            RenderResult render = Renderer::renderFrame(scene);
-
-            const std::chrono::time_point renderEnd = std::chrono::system_clock::now();
-            const std::chrono::microseconds renderDuration =
-                std::chrono::duration_cast<std::chrono::microseconds>(renderEnd - renderStart);
-
-            // Storage pivot: mirror-gather diagnostics for the primary camera. The
-            // direct image comes from the forward splat; reflections come from the
-            // density grid. Reports how many delta (mirror) pixels reflected the
-            // grid vs stayed black.
-            const MirrorGather::Result& m = render.mirror;
-            std::cout << "Mirror: delta-pixels=" << m.pixelsDelta
-                      << " reflected=" << m.pixelsReflected
-                      << " black=" << m.pixelsBlack
-                      << std::endl;
-
-            // Phase 2a probe-guided gather diagnostics: the keep-test cull (the
-            // memory-bound proof) and the raw-bounce store occupancy. bounceKept
-            // = non-delta bounces stored (a probe was near); bounceCulled = those
-            // discarded (no probe near → never camera-reachable). A large cull
-            // fraction with store size ≪ total bounces is the evidence that memory
-            // is bounded by visible-surface-area, not photon count.
-            if (render.bounceStore)
-            {
-                const size_t kept = WorkerDebug::bounceKept();
-                const size_t culled = WorkerDebug::bounceCulled();
-                const size_t total = kept + culled;
-                const double cullPct =
-                    (total > 0) ? (100.0 * static_cast<double>(culled) /
-                                   static_cast<double>(total))
-                                : 0.0;
-                std::cout << "Probe gather: kept=" << kept << " culled=" << culled
-                          << " (" << cullPct << "% culled)"
-                          << " storeSize=" << render.bounceStore->size()
-                          << " storeMiB="
-                          << (render.bounceStore->memoryBytes() / (1024 * 1024))
-                          << (render.bounceStore->budgetHit() ? " [BUDGET HIT]" : "")
-                          << std::endl;
+            size_t frame = 0;
+            std::chrono::time_point<std::chrono::system_clock> renderStart;
+            std::chrono::microseconds renderDuration{0};
+            std::shared_ptr<PendingFrame> pending;
+            RenderResult render;
+            size_t bounceKept = 0;
+            size_t bounceCulled = 0;
+            std::filesystem::path outputPath;
+            std::filesystem::path checkpointPath;  // progressive frames ($checkpointPasses)
+        };
+
+        // $pipelineDepth > 1 overlaps frame N's tail with frame N + 1's probe and
+        // photon passes (FramePipeline); 1 renders the frames one after another.
+        FramePipeline::Limits limits;
+        limits.depth = scene.settings.pipelineDepth;
+        limits.memoryBudget = scene.settings.pipelineMemoryMiB * 1024 * 1024;
+
+        const FramePipeline::Stats pipeline = FramePipeline::run(
+            startFrame, endFrame, limits, [&](size_t frame) {
+                std::cout << "---" << std::endl;
+                std::cout << "Rendering frame " << frame + 1 << " / " << frameCount << std::endl;
 
-                // Overflow is also reported as a loud stderr warning from the
-                // Renderer; surface the dropped-deposit counter here too so the
-                // CLI summary shows it. Nonzero = image is missing energy.
-                if (render.bounceStoreDropped > 0)
+                auto job = std::make_shared<FrameJob>();
+                job->frame = frame;
+                job->renderStart = std::chrono::system_clock::now();
+
+                // A shard writes its float buffers for `ray-tracer merge` to sum;
+                // its own image holds only its share of the photons.
+                std::string fileName = scene.renderName + "." + std::to_string(frame);
+                if (scene.settings.shardCount > 1)
+                {
+                    fileName += ".shard-" + std::to_string(scene.settings.shardIndex) + "-of-" +
+                                std::to_string(scene.settings.shardCount) + ".rtpart";
+                }
+                else
+                {
+                    fileName += ".png";
+                }
+                job->outputPath = scene.renderPath / fileName;
+                job->checkpointPath =
+                    scene.renderPath / (scene.renderName + "." + std::to_string(frame) + ".checkpoint");
+
+                // --resume: a frame is finished once its output is in place (it is
+                // renamed there whole) and its checkpoint is gone.
+                if (resume && std::filesystem::exists(job->outputPath) &&
+                    !std::filesystem::exists(job->checkpointPath))
                 {
-                    std::cout << "Probe gather: DROPPED " << render.bounceStoreDropped
-                              << " deposits (BounceStore overflow — image is missing "
-                                 "energy; raise $bounceStoreCapacity)"
+                    std::cout << "Skipping frame " << frame + 1 << ": "
+                              << job->outputPath.generic_string() << " is already written"
                               << std::endl;
+                    FramePipeline::Tail done;
+                    done.gather = []() {};
+                    done.output = []() {};
+                    return done;
                 }
-            }
 
-            std::string fileName = scene.renderName + "." + std::to_string(frame) + ".png";
-            std::filesystem::path outputPath = scene.renderPath / fileName;
-            PngWriter::writeImage(outputPath, *render.image, scene.renderName);
+                // Map this frame index to TIME so the keyframed scene is sampled at the
+                // right instant: the shutter opens at frameOffset + frame/frameRate and
+                // the Renderer integrates over [t_open, t_open + shutterTime). This is
+                // the single point that turns a frame number into a scene time; a static
+                // scene with shutterTime 0 ignores it (all photons share one instant and
+                // there are no animated transforms). beginFrame copies the settings, so
+                // the next frame may move frameTime on while this one finishes.
+                const double frameRate =
+                    (scene.settings.frameRate > 0.0) ? scene.settings.frameRate : 24.0;
+                scene.settings.frameTime =
+                    scene.settings.frameOffset + static_cast<double>(frame) / frameRate;
 
-            std::cout << "Wrote " << outputPath.generic_string() << std::endl;
-            std::cout << "Render time:" << std::endl;
-            std::cout << "|- total:        " << renderDuration.count() / 1000 << " ms" << std::endl;
-            if (pixelCount > 0)
-            {
-                std::cout << "|- average / px: " << renderDuration.count() / pixelCount << " us" << std::endl;
-            }
+                std::cout << "Frame time t=" << scene.settings.frameTime << "s"
+                          << " shutter=" << scene.settings.shutterTime << "s" << std::endl;
+                scene.settings.checkpointPath = job->checkpointPath;
+                scene.settings.resumeFromCheckpoint = resume;
+
+                job->pending = Renderer::beginFrame(
+                    scene, nullptr, nullptr, scene.settings.probeFrameReuse ? &frameCache : nullptr,
+                    &renderContext);
+                // The keep-test counters belong to this frame's photon pass: read them
+                // before the next frame's pass resets them.
+                job->bounceKept = WorkerDebug::bounceKept();
+                job->bounceCulled = WorkerDebug::bounceCulled();
+
+                FramePipeline::Tail tail;
+                tail.bytes = Renderer::pendingFrameBytes(*job->pending);
+                tail.gather = [job]() {
+                    job->render = Renderer::finishFrame(*job->pending);
+                    job->pending.reset();
+                    job->renderDuration = std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::system_clock::now() - job->renderStart);
+                };
+                tail.output = [job, &scene, frameCount, pixelCount]() {
+                    const RenderResult& render = job->render;
+                    // Built up and printed at once: with frames overlapping, the next
+                    // frame's progress lines print from the other thread meanwhile.
+                    std::ostringstream report;
+                    report << "Finished frame " << job->frame + 1 << " / " << frameCount
+                           << std::endl;
+
+                    // Storage pivot: mirror-gather diagnostics for the primary camera. The
+                    // direct image comes from the forward splat; reflections come from the
+                    // density grid. Reports how many delta (mirror) pixels reflected the
+                    // grid vs stayed black.
+                    const MirrorGather::Result& m = render.mirror;
+                    report << "Mirror: delta-pixels=" << m.pixelsDelta
+                           << " reflected=" << m.pixelsReflected
+                           << " black=" << m.pixelsBlack
+                           << std::endl;
+
+                    // Phase 2a probe-guided gather diagnostics: the keep-test cull (the
+                    // memory-bound proof) and the raw-bounce store occupancy. bounceKept
+                    // = non-delta bounces stored (a probe was near); bounceCulled = those
+                    // discarded (no probe near → never camera-reachable). A large cull
+                    // fraction with store size ≪ total bounces is the evidence that memory
+                    // is bounded by visible-surface-area, not photon count.
+                    if (render.bounceStore)
+                    {
+                        const size_t kept = job->bounceKept;
+                        const size_t culled = job->bounceCulled;
+                        const size_t total = kept + culled;
+                        const double cullPct =
+                            (total > 0) ? (100.0 * static_cast<double>(culled) /
+                                           static_cast<double>(total))
+                                        : 0.0;
+                        if (scene.settings.probeFrameReuse)
+                        {
+                            report << "Probe pass: tiles reused=" << render.probeTilesReused
+                                   << " traced=" << render.probeTilesTraced << std::endl;
+                        }
+                        report << "Probe gather: kept=" << kept << " culled=" << culled
+                               << " (" << cullPct << "% culled)"
+                               << " storeSize=" << render.bounceStore->size()
+                               << " storeMiB="
+                               << (render.bounceStore->memoryBytes() / (1024 * 1024))
+                               << (render.bounceStore->spillEnabled()
+                                       ? " spillMiB=" + std::to_string(render.bounceStore->spilledBytes() /
+                                                                       (1024 * 1024))
+                                       : std::string{})
+                               << (render.bounceStore->budgetHit() ? " [BUDGET HIT]" : "")
+                               << std::endl;
+                        if (scene.settings.depositMergeScale > 0.0 && render.depositsAfterMerge > 0)
+                        {
+                            report << "Probe gather: merged " << render.depositsBeforeMerge << " -> "
+                                   << render.depositsAfterMerge << " deposits ("
+                                   << static_cast<double>(render.depositsBeforeMerge) /
+                                          static_cast<double>(render.depositsAfterMerge)
+                                   << "x)" << std::endl;
+                        }
+
+                        // Overflow is also reported as a loud stderr warning from the
+                        // Renderer; surface the dropped-deposit counter here too so the
+                        // CLI summary shows it. Nonzero = image is missing energy.
+                        if (render.bounceStoreDropped > 0)
+                        {
+                            report << "Probe gather: DROPPED " << render.bounceStoreDropped
+                                   << " deposits (BounceStore overflow — image is missing "
+                                      "energy; raise $bounceStoreCapacity)"
+                                   << std::endl;
+                        }
+                    }
+
+                    // Written beside the output and renamed over it, so a run killed
+                    // mid-write never leaves a partial file for --resume to skip.
+                    std::filesystem::path writtenPath = job->outputPath;
+                    writtenPath += ".tmp";
+                    if (scene.settings.shardCount > 1)
+                    {
+                        PartialFrame::fromRender(render, scene.settings, job->frame).write(writtenPath);
+                        report << "Shard " << scene.settings.shardIndex << " / "
+                               << scene.settings.shardCount << ": emitted "
+                               << render.photonsEmitted << " photons" << std::endl;
+                    }
+                    else if (!PngWriter::writeImage(writtenPath, *render.image, scene.renderName))
+                    {
+                        throw std::runtime_error("cannot write " + writtenPath.generic_string());
+                    }
+                    // $exrOutput: every camera's radiance buffer, before the exposure
+                    // and gamma the PNG bakes in. The primary camera's EXR sits beside
+                    // the PNG; the others add their $outputName (or index).
+                    if (scene.settings.exrOutput && scene.settings.shardCount == 1)
+                    {
+                        for (size_t c = 0; c < render.cameras.size(); ++c)
+                        {
+                            const CameraRender& cr = render.cameras[c];
+                            if (!cr.buffer)
+                            {
+                                continue;
+                            }
+                            std::string exrName = scene.renderName + "." + std::to_string(job->frame);
+                            if (c > 0)
+                            {
+                                exrName += "." + (cr.outputName.empty() ? "camera" + std::to_string(c)
+                                                                        : cr.outputName);
+                            }
+                            exrName += ".exr";
+                            ExrWriter::Options exr;
+                            exr.halfFloat = scene.settings.exrHalf;
+                            exr.compression = scene.settings.exrCompression;
+                            exr.saturationLuminance = cr.camera->saturationLuminance();
+                            const std::filesystem::path exrPath = scene.renderPath / exrName;
+                            std::filesystem::path exrWritten = exrPath;
+                            exrWritten += ".tmp";
+                            ExrWriter::writeBuffer(exrWritten, *cr.buffer, exr);
+                            std::filesystem::rename(exrWritten, exrPath);
+                            report << "Wrote " << exrPath.generic_string() << std::endl;
+                        }
+                    }
+                    std::filesystem::rename(writtenPath, job->outputPath);
+                    std::filesystem::remove(job->checkpointPath);
+                    if (render.resumedPasses > 0)
+                    {
+                        report << "Resumed from " << job->checkpointPath.generic_string()
+                               << " after " << render.resumedPasses << " passes" << std::endl;
+                    }
+                    report << "Wrote " << job->outputPath.generic_string() << std::endl;
+                    report << "Render time:" << std::endl;
+                    report << "|- total:        " << job->renderDuration.count() / 1000 << " ms"
+                           << std::endl;
+                    if (pixelCount > 0)
+                    {
+                        report << "|- average / px: " << job->renderDuration.count() / pixelCount
+                               << " us" << std::endl;
+                    }
+                    std::cout << report.str() << std::flush;
+                };
+                return tail;
+            });
+
+        if (limits.depth > 1)
+        {
+            std::cout << "---" << std::endl;
+            std::cout << "Frame pipeline: depth=" << limits.depth
+                      << " peak frames in flight=" << pipeline.peakFrames
+                      << " peakMiB=" << pipeline.peakBytes / (1024 * 1024) << std::endl;
+        }
+        if (endFrame > startFrame)
+        {
+            std::cout << "Render context: reused=" << renderContext.reused
+                      << " allocated=" << renderContext.allocated << std::endl;
         }
     }
     catch (const std::exception& e)
@@ -2,7 +2,9 @@
 #include <catch2/catch_approx.hpp>
 
 #include "AnimationQuery.h"
+#include "Buffer.h"
 #include "Image.h"
+#include "ProbeGather.h"
 #include "Quaternion.h"
 #include "Ray.h"
 #include "Renderer.h"
@@ -15,6 +17,7 @@
 #include <cstdio>
 #include <filesystem>
 #include <fstream>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -241,3 +244,147 @@ TEST_CASE("Probe gather renders a translated-at-t=1 object at its moved position
     // a regression to a time-blind camera ray (time=0, zero shift) fails hard.
     REQUIRE(std::abs(centroidT1 - centroidT0) > 20.0);
 }
+
+// ===== Test 3: adaptive camera sampling leaves a moving occluder's mean alone =====
+//
+// Over a one-second shutter the Mover sweeps 70 units across the back wall, so a
+// pixel along its path is covered for only part of the shutter. An adaptive early
+// stop would keep whatever the pilot's sample times happened to see there — often
+// all wall — and bias the blurred occluder's mean coverage downward. With any
+// animated object in view the probe pass must therefore never stop a shutter pixel
+// early: the records, and so the mean, are identical with and without adaptive
+// sampling. The same shutter over the scene held static (no animation query) still
+// stops, so the budget saving survives where nothing can move.
+TEST_CASE("Adaptive camera sampling does not bias a moving occluder's motion blur",
+          "[animation][motionblur][ProbeGather]")
+{
+    const std::string path = writeMovingScene();
+    LoadedScene scene = SceneLoader::loadFromFile(path, /*logToStdout=*/false);
+    std::remove(path.c_str());
+
+    const auto probe = [&scene](const AnimationQuery* animation, bool adaptive) {
+        return ProbeGather::collectGatherPoints(scene.objects, *scene.camera,
+                                                *scene.materialLibrary, animation,
+                                                /*frameTime=*/0.0f, /*shutterTime=*/1.0f,
+                                                /*cameraSamples=*/16, 1, /*seed=*/11, 2,
+                                                adaptive);
+    };
+    // Mean over the frame of each pixel's weight on the Mover (records in front of
+    // the back wall, whose near face is at z = 120): its blurred coverage.
+    const auto moverCoverage = [&scene](const ProbeGather::ProbeResult& probes) {
+        double covered = 0.0;
+        for (size_t i = 0; i < probes.points.size(); ++i)
+        {
+            const ProbeGather::GatherPoint gp = probes.points[i];
+            if (gp.position.z < 100.0)
+            {
+                covered += gp.sampleWeight;
+            }
+        }
+        return covered / static_cast<double>(scene.camera->width() * scene.camera->height());
+    };
+
+    REQUIRE(scene.animation);
+    const ProbeGather::ProbeResult fixed = probe(scene.animation.get(), false);
+    const ProbeGather::ProbeResult adaptive = probe(scene.animation.get(), true);
+
+    const double fixedMean = moverCoverage(fixed);
+    const double adaptiveMean = moverCoverage(adaptive);
+    INFO("mover coverage: fixed=" << fixedMean << " adaptive=" << adaptiveMean);
+    REQUIRE(fixedMean > 0.0);
+    REQUIRE(adaptive.adaptiveStops == 0);
+    REQUIRE(adaptive.cameraRays == fixed.cameraRays);
+    REQUIRE(adaptive.points.size() == fixed.points.size());
+    REQUIRE(adaptiveMean == fixedMean);
+
+    // Control: the same shutter with nothing animated may stop converged pixels.
+    const ProbeGather::ProbeResult still = probe(nullptr, true);
+    REQUIRE(still.adaptiveStops > 0);
+    REQUIRE(still.cameraRays < fixed.cameraRays);
+}
+
+// ===== Test 4: probe-pass reuse across frames re-traces only what can change =====
+//
+// The camera holds still while the sphere moves, so between two frames only the
+// screen tiles whose rays the sphere's swept bounds reach need tracing again; the
+// rest carry their records over (ProbeGather::ProbeReuse). Carried-over records
+// must be exactly what a fresh trace of the new frame produces — same seed, same
+// static geometry, sample time moved to the new frame — so the reused pass is
+// compared record for record against a fresh one.
+TEST_CASE("Probe-pass reuse re-traces only the tiles a moving object can reach",
+          "[animation][ProbeGather][ProbeReuse]")
+{
+    const std::string path = writeMovingScene();
+    LoadedScene scene = SceneLoader::loadFromFile(path, /*logToStdout=*/false);
+    std::remove(path.c_str());
+    REQUIRE(scene.camera);
+
+    const long long seed = 5;
+    const auto collect = [&](float frameTime, ProbeGather::ProbeReuse* reuse) {
+        return ProbeGather::collectGatherPoints(scene.objects, *scene.camera, *scene.materialLibrary,
+                                                scene.animation.get(), frameTime, 0.0f, 1, 1, seed,
+                                                2, true, reuse);
+    };
+
+    ProbeGather::ProbeReuse reuse;
+    ProbeGather::ProbeResult first = collect(0.0f, &reuse);
+    const size_t tileCount = first.retracedTiles;
+    REQUIRE(first.reusedTiles == 0);
+    REQUIRE(tileCount == 36);  // 96x96 in 16x16 tiles
+    reuse.points = std::make_shared<ProbeGather::GatherPointStore>(std::move(first.points));
+
+    // One eighth of a second later the sphere has moved 8.75 units right.
+    const ProbeGather::ProbeResult reused = collect(0.125f, &reuse);
+    const ProbeGather::ProbeResult fresh = collect(0.125f, nullptr);
+    INFO("reused tiles=" << reused.reusedTiles << " traced=" << reused.retracedTiles);
+    REQUIRE(reused.reusedTiles + reused.retracedTiles == tileCount);
+    REQUIRE(reused.retracedTiles > 0);
+    REQUIRE(reused.reusedTiles >= tileCount / 3);
+    REQUIRE(reuse.retracedTiles.size() == reused.retracedTiles);
+    REQUIRE(reused.cameraRays < fresh.cameraRays);
+
+    REQUIRE(reused.points.size() == fresh.points.size());
+    for (size_t i = 0; i < fresh.points.size(); ++i)
+    {
+        const ProbeGather::GatherPoint a = reused.points[i];
+        const ProbeGather::GatherPoint b = fresh.points[i];
+        INFO("record " << i);
+        REQUIRE(a.pixel.x == b.pixel.x);
+        REQUIRE(a.pixel.y == b.pixel.y);
+        REQUIRE(a.position.x == b.position.x);
+        REQUIRE(a.position.y == b.position.y);
+        REQUIRE(a.position.z == b.position.z);
+        REQUIRE(a.materialIndex == b.materialIndex);
+        REQUIRE(a.footprintRadius == b.footprintRadius);
+        REQUIRE(a.sampleTime == b.sampleTime);
+        REQUIRE(a.sampleWeight == b.sampleWeight);
+    }
+
+    // A whole deterministic frame through Renderer's FrameCache (index patched in
+    // place) renders bit-for-bit what an uncached render of that frame does.
+    scene.settings.deterministic = true;
+    scene.settings.photonsPerLight = 300000;
+    FrameCache cache;
+    scene.settings.frameTime = 0.0;
+    const RenderResult cachedFirst = Renderer::renderFrame(scene, nullptr, nullptr, &cache);
+    REQUIRE(cachedFirst.probeTilesReused == 0);
+    scene.settings.frameTime = 0.125;
+    const RenderResult cachedSecond = Renderer::renderFrame(scene, nullptr, nullptr, &cache);
+    const RenderResult uncached = Renderer::renderFrame(scene);
+    REQUIRE(cachedSecond.probeTilesReused > 0);
+    REQUIRE(cachedSecond.probeTilesReused + cachedSecond.probeTilesTraced == tileCount);
+    const Buffer& a = *cachedSecond.buffer;
+    const Buffer& b = *uncached.buffer;
+    for (size_t y = 0; y < 96; ++y)
+    {
+        for (size_t x = 0; x < 96; ++x)
+        {
+            const Color ca = a.fetchColor({x, y});
+            const Color cb = b.fetchColor({x, y});
+            INFO("pixel (" << x << "," << y << ")");
+            REQUIRE(ca.red == cb.red);
+            REQUIRE(ca.green == cb.green);
+            REQUIRE(ca.blue == cb.blue);
+        }
+    }
+}
@@ -2,8 +2,13 @@
 
 #include "BounceStore.h"
 #include "Color.h"
+#include "RandomGenerator.h"
 #include "Vector.h"
 
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <stdexcept>
 #include <thread>
 #include <vector>
 
@@ -93,3 +98,237 @@ TEST_CASE("BounceStore overflow count is correct under concurrent appends", "[Bo
     REQUIRE(store.budgetHit());
     REQUIRE(store.droppedCount() == expectedAttempts - kCapacity);
 }
+
+// ===== Lazy segment commit =====
+//
+// The store is a table of fixed-size segments committed on first write, so a
+// large capacity costs nothing until deposits land, and records that straddle a
+// segment boundary read back intact through operator[].
+
+TEST_CASE("BounceStore commits segments lazily as deposits land", "[BounceStore]")
+{
+    constexpr std::size_t kSegment = BounceStore::kSegmentRecords;
+    BounceStore store(/*capacity=*/kSegment * 64);
+
+    // A huge ceiling with no deposits commits nothing.
+    REQUIRE(store.committedSegments() == 0);
+    REQUIRE(store.memoryBytes() < kSegment * sizeof(RawBounce));
+
+    // Write one segment plus one record: exactly two segments are committed.
+    for (std::size_t i = 0; i < kSegment + 1; ++i)
+    {
+        REQUIRE(store.append(RawBounce{Vector{static_cast<double>(i), 0.0, 0.0},
+                                       Vector{0.0, 0.0, 1.0}, Color{1.0f, 1.0f, 1.0f}}));
+    }
+    REQUIRE(store.committedSegments() == 2);
+    REQUIRE(store.memoryBytes() >= 2 * kSegment * sizeof(RawBounce));
+    REQUIRE(store.memoryBytes() < 3 * kSegment * sizeof(RawBounce));
+
+    // Records on both sides of the boundary read back in slot order.
+    REQUIRE(store[kSegment - 1].px == static_cast<float>(kSegment - 1));
+    REQUIRE(store[kSegment].px == static_cast<float>(kSegment));
+}
+
+TEST_CASE("BounceStore concurrent appends across segment boundaries lose nothing", "[BounceStore]")
+{
+    // Many writers racing into fresh segments: exactly one commit wins per
+    // segment and every claimed slot is written exactly once.
+    constexpr std::size_t kSegment = BounceStore::kSegmentRecords;
+    constexpr int kThreads = 8;
+    constexpr std::size_t kPerThread = kSegment / 2;  // 4 segments total
+
+    BounceStore store(kSegment * 16);
+
+    std::vector<std::thread> workers;
+    workers.reserve(kThreads);
+    for (int t = 0; t < kThreads; ++t)
+    {
+        workers.emplace_back([&store, t]() {
+            for (std::size_t i = 0; i < kPerThread; ++i)
+            {
+                store.append(RawBounce{Vector{0.0, 0.0, 0.0}, Vector{0.0, 0.0, 1.0},
+                                       Color{static_cast<float>(t + 1), 0.0f, 0.0f}});
+            }
+        });
+    }
+    for (auto& w : workers)
+    {
+        w.join();
+    }
+
+    REQUIRE(store.size() == kThreads * kPerThread);
+    REQUIRE(store.committedSegments() == 4);
+
+    // Every thread's records are all present (no slot lost or overwritten).
+    double sum = 0.0;
+    for (std::size_t i = 0; i < store.size(); ++i)
+    {
+        sum += static_cast<double>(store[i].power.red);
+    }
+    const double expected = static_cast<double>(kPerThread) * (kThreads * (kThreads + 1) / 2);
+    REQUIRE(sum == expected);
+}
+
+// ===== Out-of-core spill + cell-ordered index =====
+//
+// With a resident budget of one segment, every later segment lives in the
+// memory-mapped scratch file. Records must read back identically whichever side
+// of the budget they landed on, and buildIndex must leave each cell as one
+// contiguous run of slots while radiusSearch stays exact.
+
+#if RAY_TRACER_HAS_BOUNCE_SPILL
+TEST_CASE("BounceStore spills segments past the resident budget to a scratch file", "[BounceStore]")
+{
+    constexpr std::size_t kSegment = BounceStore::kSegmentRecords;
+    BounceStore store(/*capacity=*/kSegment * 4,
+                      /*residentBytes=*/kSegment * sizeof(RawBounce),
+                      std::filesystem::temp_directory_path());
+    REQUIRE(store.spillEnabled());
+
+    // Three segments' worth: one resident, two spilled and sealed (the 4th is
+    // never touched).
+    const std::size_t count = kSegment * 3;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        store.append(RawBounce{Vector{static_cast<double>(i % 1000), 0.0, 0.0},
+                               Vector{0.0, 0.0, 1.0}, Color{1.0f, 1.0f, 1.0f}});
+    }
+    REQUIRE(store.size() == count);
+    REQUIRE(store.committedSegments() == 1);
+    REQUIRE(store.spilledSegments() == 2);
+    REQUIRE(store.memoryBytes() < 2 * kSegment * sizeof(RawBounce));
+
+    // Sealed, released spilled pages still read back from the file.
+    const std::size_t probe = kSegment * 2 + 7;
+    REQUIRE(store[probe].px == static_cast<float>(probe % 1000));
+
+    // Cell-ordered rebuild: a unit-cell query at x = 500 sees exactly the
+    // records with px in [499.5, 500.5] — i.e. px == 500 — and they form one
+    // contiguous run.
+    store.buildIndex(/*cellSize=*/1.0);
+    const std::vector<std::size_t> hits = store.radiusSearch(Vector{500.0, 0.0, 0.0}, 0.5);
+
+    // The spilled rebuild is a copy into a fresh scratch file: the resident
+    // segment is released, and every record survives it.
+    REQUIRE(store.size() == count);
+    REQUIRE(store.committedSegments() == 0);
+    double pxSum = 0.0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        pxSum += static_cast<double>(store[i].px);
+    }
+    double expectedSum = 0.0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        expectedSum += static_cast<double>(i % 1000);
+    }
+    REQUIRE(pxSum == expectedSum);
+
+    const std::size_t perValue = count / 1000 + ((count % 1000) > 500 ? 1 : 0);
+    REQUIRE(hits.size() == perValue);
+    for (std::size_t k = 1; k < hits.size(); ++k)
+    {
+        REQUIRE(hits[k] == hits[k - 1] + 1);
+    }
+    for (const std::size_t index : hits)
+    {
+        REQUIRE(store[index].px == 500.0f);
+    }
+}
+#else
+TEST_CASE("BounceStore spill mode is rejected where the platform cannot map a scratch file", "[BounceStore]")
+{
+    constexpr std::size_t kSegment = BounceStore::kSegmentRecords;
+    REQUIRE_THROWS_AS(BounceStore(kSegment * 4, kSegment * sizeof(RawBounce),
+                                  std::filesystem::temp_directory_path()),
+                      std::runtime_error);
+}
+#endif
+
+// ===== Time-sliced index =====
+//
+// With time slices the index orders each cell's run by deposit time, and the
+// time-windowed search settles whole slices. It must still return exactly the
+// records a per-record radius + temporal-window test accepts, for narrow, wide
+// and zero windows, with timeless deposits mixed in — resident and spilled alike.
+
+namespace
+{
+void requireTimedSearchMatchesBruteForce(BounceStore& store)
+{
+    RandomGenerator random(31u);
+    const std::size_t count = 20000;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const float time = (i % 20 == 0) ? RawBounce::kTimelessDeposit
+                                         : static_cast<float>(2.0 + random.value(0.04));
+        store.append(RawBounce{Vector{random.value(10.0), random.value(10.0), 0.0},
+                               Vector{0.0, 0.0, -1.0}, Vector{0.0, 0.0, 1.0}, time,
+                               Color{1.0f, 1.0f, 1.0f}});
+    }
+    store.buildIndex(/*cellSize=*/0.5, /*timeSlices=*/5);
+    REQUIRE(store.timeBins() == 6);
+
+    for (int q = 0; q < 300; ++q)
+    {
+        const Vector p{random.value(10.0), random.value(10.0), 0.0};
+        const double r = 0.2 + random.value(0.6);
+        const float time = static_cast<float>(2.0 + random.value(0.04));
+        const float windows[] = {0.0f, 0.003f, static_cast<float>(random.value(0.02)), 0.04f};
+        const float window = windows[q % 4];
+
+        std::vector<std::size_t> found = store.radiusSearch(p, r, time, window);
+        std::sort(found.begin(), found.end());
+        std::vector<std::size_t> expected;
+        for (std::size_t i = 0; i < store.size(); ++i)
+        {
+            const RawBounce& rec = store[i];
+            const double dx = rec.px - p.x;
+            const double dy = rec.py - p.y;
+            const double dz = rec.pz - p.z;
+            const bool inTime = rec.time == RawBounce::kTimelessDeposit ||
+                                !(std::abs(rec.time - time) > window);
+            if (inTime && dx * dx + dy * dy + dz * dz <= r * r)
+            {
+                expected.push_back(i);
+            }
+        }
+        REQUIRE(found == expected);
+    }
+
+    // An unsliced rebuild answers the same queries.
+    const std::vector<std::size_t> sliced = store.radiusSearch(Vector{5.0, 5.0, 0.0}, 1.0, 2.02f, 0.01f);
+    store.buildIndex(/*cellSize=*/0.5);
+    REQUIRE(store.timeBins() == 1);
+    REQUIRE(store.radiusSearch(Vector{5.0, 5.0, 0.0}, 1.0, 2.02f, 0.01f).size() == sliced.size());
+}
+}  // namespace
+
+TEST_CASE("BounceStore time-sliced search matches a per-record window test", "[BounceStore]")
+{
+    BounceStore store(40000);
+    requireTimedSearchMatchesBruteForce(store);
+}
+
+#if RAY_TRACER_HAS_BOUNCE_SPILL
+TEST_CASE("BounceStore time-sliced search matches a per-record window test when spilled", "[BounceStore]")
+{
+    BounceStore store(BounceStore::kSegmentRecords * 2, sizeof(RawBounce),
+                      std::filesystem::temp_directory_path());
+    requireTimedSearchMatchesBruteForce(store);
+}
+#endif
+
+TEST_CASE("BounceStore ignores time slices when every deposit shares one time", "[BounceStore]")
+{
+    BounceStore store(100);
+    for (int i = 0; i < 100; ++i)
+    {
+        store.append(RawBounce{Vector{i * 0.1, 0.0, 0.0}, Vector{0.0, 0.0, -1.0},
+                               Vector{0.0, 0.0, 1.0}, 1.0f, Color{1.0f, 1.0f, 1.0f}});
+    }
+    store.buildIndex(/*cellSize=*/1.0, /*timeSlices=*/8);
+    REQUIRE(store.timeBins() == 1);
+    REQUIRE(store.radiusSearch(Vector{5.0, 0.0, 0.0}, 0.55, 1.0f, 0.0f).size() == 11);
+    REQUIRE(store.radiusSearch(Vector{5.0, 0.0, 0.0}, 0.55, 1.5f, 0.1f).empty());
+}
@@ -0,0 +1,198 @@
+#include <catch2/catch_all.hpp>
+
+#include "BounceStore.h"
+#include "Color.h"
+#include "RandomGenerator.h"
+#include "RenderFixture.h"
+#include "Vector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// Deposit merging
+// ============================================================================
+//
+// BounceStore::mergeDeposits folds agreeing deposits in a small sub-cell into one
+// power-weighted deposit. It must conserve power, never merge across a normal,
+// direction or time disagreement, leave the index answering radius searches over
+// the merged records, and — on a lit scene — shrink the store while moving the
+// image far less than reseeding the photons does.
+
+namespace
+{
+Color totalPower(const BounceStore& store)
+{
+    Color sum{0.0f, 0.0f, 0.0f};
+    for (std::size_t i = 0; i < store.size(); ++i)
+    {
+        sum += store[i].power;
+    }
+    return sum;
+}
+
+std::string mergeScene(double mergeScale, int seed)
+{
+    return R"JSON({
+  "$materials": { "Matte": { "$type": "Diffuse", "$color": [0.7] } },
+  "$workerConfiguration": { "$workerCount": 1, "$fetchSize": 20000, "$photonQueueSize": 2000000 },
+  "$renderConfiguration": {
+    "$width": 32, "$height": 32, "$photonsPerLight": 1000000,
+    "$bounceThreshold": 2, "$terminationThreshold": 0.01,
+    "$deterministic": true, "$seed": )JSON" +
+           std::to_string(seed) + R"JSON(, "$depositMergeScale": )JSON" + std::to_string(mergeScale) +
+           R"JSON(
+  },
+  "$scene": {
+    "Camera": { "$type": "Camera", "$verticalFieldOfView": 60.0,
+      "$position": [0.0, 0.0, -200.0],
+      "$rotation": { "$type": "PitchYawRollDegrees", "$value": [0.0, 0.0, 0.0] } },
+    "Light": { "$type": "OmniLight", "$position": [0.0, 80.0, -60.0],
+      "$color": [1.0, 1.0, 1.0], "$brightness": 50000 },
+    "Sphere": { "$type": "SphereVolume", "$material": "Matte",
+      "$center": [0.0, 0.0, 20.0], "$radius": 40.0 },
+    "BackWall": { "$type": "SphereVolume", "$material": "Matte",
+      "$center": [0.0, 0.0, 400.0], "$radius": 300.0 }
+  }
+})JSON";
+}
+}  // namespace
+
+TEST_CASE("Deposit merge folds agreeing deposits and conserves power", "[BounceStore][merge]")
+{
+    BounceStore store(1000);
+    RandomGenerator random(3u);
+    // 400 deposits in one 0.1-wide sub-cell with one normal and direction, plus 100
+    // from a perpendicular wall in the same sub-cell.
+    for (int i = 0; i < 500; ++i)
+    {
+        const bool wall = i >= 400;
+        store.append(RawBounce{Vector{0.02 + random.value(0.06), 0.02 + random.value(0.06), 0.05},
+                               wall ? Vector{1.0, 0.0, 0.0} : Vector{0.0, 0.0, -1.0},
+                               wall ? Vector{-1.0, 0.0, 0.0} : Vector{0.0, 0.0, 1.0},
+                               RawBounce::kTimelessDeposit, Color{0.5f, 0.25f, 0.125f}});
+    }
+    store.buildIndex(/*cellSize=*/1.0);
+    const Color before = totalPower(store);
+
+    BounceStore::MergeTolerance tolerance;
+    tolerance.cellSize = 0.1;
+    const BounceStore::MergeResult merged = store.mergeDeposits(tolerance);
+    REQUIRE(merged.before == 500);
+    REQUIRE(merged.after == 2);
+    REQUIRE(merged.ratio() == Catch::Approx(250.0));
+    REQUIRE(store.size() == 2);
+
+    const Color after = totalPower(store);
+    REQUIRE(after.red == Catch::Approx(before.red).epsilon(1e-5));
+    REQUIRE(after.blue == Catch::Approx(before.blue).epsilon(1e-5));
+    for (std::size_t i = 0; i < store.size(); ++i)
+    {
+        // Each representative kept its group's normal and lies inside the sub-cell.
+        const Vector n = store[i].normal();
+        REQUIRE((std::abs(n.z - 1.0) < 1e-6 || std::abs(n.x + 1.0) < 1e-6));
+        REQUIRE(store[i].px > 0.02f);
+        REQUIRE(store[i].px < 0.08f);
+        REQUIRE(store[i].time == RawBounce::kTimelessDeposit);
+    }
+}
+
+TEST_CASE("Deposit merge keeps deposits apart across sub-cells, directions and times",
+          "[BounceStore][merge]")
+{
+    BounceStore store(100);
+    const Color power{1.0f, 1.0f, 1.0f};
+    const Vector down{0.0, 0.0, -1.0};
+    const Vector up{0.0, 0.0, 1.0};
+    store.append(RawBounce{Vector{0.05, 0.05, 0.0}, down, up, 1.0f, power});
+    store.append(RawBounce{Vector{0.06, 0.05, 0.0}, down, up, 1.0f, power});     // merges
+    store.append(RawBounce{Vector{0.15, 0.05, 0.0}, down, up, 1.0f, power});     // next sub-cell
+    store.append(RawBounce{Vector{0.05, 0.06, 0.0}, Vector{0.8, 0.0, -0.6}, up, 1.0f, power});  // direction
+    store.append(RawBounce{Vector{0.05, 0.04, 0.0}, down, up, 1.5f, power});     // time
+    store.append(RawBounce{Vector{0.04, 0.05, 0.0}, down, up, RawBounce::kTimelessDeposit, power});
+    store.buildIndex(/*cellSize=*/1.0, /*timeSlices=*/4);
+
+    BounceStore::MergeTolerance tolerance;
+    tolerance.cellSize = 0.1;
+    tolerance.timeTolerance = 0.1f;
+    const BounceStore::MergeResult merged = store.mergeDeposits(tolerance);
+    REQUIRE(merged.after == 5);
+
+    // The compacted index still finds every representative, with its time slicing.
+    const std::vector<std::size_t> all = store.radiusSearch(Vector{0.1, 0.05, 0.0}, 0.2);
+    REQUIRE(all.size() == 5);
+    REQUIRE(store.radiusSearch(Vector{0.1, 0.05, 0.0}, 0.2, 1.0f, 0.1f).size() == 4);
+}
+
+TEST_CASE("Deposit merge leaves radius searches exact over the merged records",
+          "[BounceStore][merge]")
+{
+    BounceStore store(BounceStore::kSegmentRecords * 3);
+    RandomGenerator random(8u);
+    const std::size_t count = BounceStore::kSegmentRecords * 2 + 100;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const float time = static_cast<float>(random.value(0.04));
+        store.append(RawBounce{Vector{random.value(4.0), random.value(4.0), 0.0},
+                               Vector{random.value(0.2) - 0.1, random.value(0.2) - 0.1, -1.0},
+                               Vector{0.0, 0.0, 1.0}, time, Color{1.0f, 1.0f, 1.0f}});
+    }
+    store.buildIndex(/*cellSize=*/0.5, /*timeSlices=*/3);
+    const std::size_t segmentsBefore = store.committedSegments();
+
+    BounceStore::MergeTolerance tolerance;
+    tolerance.cellSize = 0.1;
+    tolerance.timeTolerance = 0.02f;
+    const BounceStore::MergeResult merged = store.mergeDeposits(tolerance);
+    INFO("before=" << merged.before << " after=" << merged.after);
+    REQUIRE(merged.after < merged.before / 10);
+    REQUIRE(store.committedSegments() < segmentsBefore);
+
+    for (int q = 0; q < 200; ++q)
+    {
+        const Vector p{random.value(4.0), random.value(4.0), 0.0};
+        const double r = 0.1 + random.value(0.5);
+        std::vector<std::size_t> found = store.radiusSearch(p, r, 0.02f, 0.01f);
+        std::sort(found.begin(), found.end());
+        std::vector<std::size_t> expected;
+        for (std::size_t i = 0; i < store.size(); ++i)
+        {
+            const RawBounce& rec = store[i];
+            const double dx = rec.px - p.x;
+            const double dy = rec.py - p.y;
+            if (!(std::abs(rec.time - 0.02f) > 0.01f) && dx * dx + dy * dy <= r * r)
+            {
+                expected.push_back(i);
+            }
+        }
+        REQUIRE(found == expected);
+    }
+}
+
+TEST_CASE("Deposit merge render: compression and image deviation on a lit scene",
+          "[BounceStore][merge][render]")
+{
+    // The same photons with and without merging, against a second seed's render:
+    // merging must move the image well under the Monte-Carlo noise it trades for.
+    rt_test::RenderScene reference{mergeScene(0.0, 7)};
+    rt_test::RenderScene reseeded{mergeScene(0.0, 8)};
+    rt_test::RenderScene merged{mergeScene(0.25, 7)};
+
+    REQUIRE(reference.result.depositsAfterMerge == reference.result.depositsBeforeMerge);
+    REQUIRE(merged.result.depositsAfterMerge > 0);
+    const double ratio = static_cast<double>(merged.result.depositsBeforeMerge) /
+                         static_cast<double>(merged.result.depositsAfterMerge);
+
+    const double mean = reference.meanLuminance();
+    REQUIRE(mean > 0.0);
+    const double noise = rt_test::rmse(reference.buffer(), reseeded.buffer(), 32, 32) / mean;
+    const double deviation = rt_test::rmse(reference.buffer(), merged.buffer(), 32, 32) / mean;
+    const double meanShift = std::abs(merged.meanLuminance() - mean) / mean;
+    INFO("compression=" << ratio << "x relative rmse=" << deviation << " (reseed " << noise
+                        << ") mean shift=" << meanShift);
+    REQUIRE(ratio > 1.5);
+    REQUIRE(deviation < 0.5 * noise);
+    REQUIRE(meanShift < 0.01);
+}
@@ -4,6 +4,7 @@
 #include "Camera.h"
 #include "Image.h"
 #include "PixelCoords.h"
+#include "ProbeGather.h"
 #include "Quaternion.h"
 #include "RandomGenerator.h"
 #include "Ray.h"
@@ -503,3 +504,63 @@ TEST_CASE("DOF: zero-aperture reallens render matches the pinhole render within
     // multiplicative slack above the floor for run-to-run variance.
     REQUIRE(parityDiff < std::max(0.75, noiseFloor * 1.5));
 }
+
+TEST_CASE("DOF: adaptive camera sampling stops converged pixels after the pilot",
+          "[dof][camera][ProbeGather]")
+{
+    // With a real aperture every pixel has a 16-sample budget. The pilot of an
+    // in-focus pixel lands on one point of the focus-plane sphere and a background
+    // pixel misses every time, so both stop after the pilot; a pixel on an
+    // off-focus sphere spreads across its surface and keeps the full budget.
+    // Either way each pixel's sample weights still sum to exactly one.
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "rt_dof_adaptive.json";
+    {
+        std::ofstream out(path);
+        out << sceneJson(/*reallens=*/true, 8.0, 0.0);
+    }
+    LoadedScene scene = SceneLoader::loadFromFile(path.string(), /*logToStdout=*/false);
+    std::remove(path.string().c_str());
+
+    const auto probe = [&scene](bool adaptive) {
+        return ProbeGather::collectGatherPoints(scene.objects, *scene.camera,
+                                                *scene.materialLibrary, scene.animation.get(),
+                                                0.0f, 0.0f, 1, 1, /*seed=*/5, 1, adaptive);
+    };
+    const ProbeGather::ProbeResult fixed = probe(false);
+    const ProbeGather::ProbeResult adaptive = probe(true);
+
+    const size_t pixels = static_cast<size_t>(kImageDim) * kImageDim;
+    REQUIRE(fixed.adaptiveStops == 0);
+    REQUIRE(fixed.cameraRays == 16 * pixels);
+    INFO("adaptive rays = " << adaptive.cameraRays << " stops = " << adaptive.adaptiveStops);
+    REQUIRE(adaptive.adaptiveStops > pixels / 2);
+    REQUIRE(adaptive.cameraRays < fixed.cameraRays * 3 / 4);
+
+    std::vector<double> weight(pixels, 0.0);
+    std::vector<int> records(pixels, 0);
+    for (size_t i = 0; i < adaptive.points.size(); ++i)
+    {
+        const ProbeGather::GatherPoint gp = adaptive.points[i];
+        const size_t index = gp.pixel.y * kImageDim + gp.pixel.x;
+        weight[index] += gp.sampleWeight;
+        ++records[index];
+    }
+    for (size_t i = 0; i < pixels; ++i)
+    {
+        if (records[i] > 0)
+        {
+            REQUIRE(weight[i] == Approx(1.0).margin(1e-5));
+        }
+    }
+
+    // Centre of the in-focus Mid sphere: the pilot only. Centre of the off-focus
+    // Near sphere: the full budget.
+    const size_t row = static_cast<size_t>(projectY());
+    const auto recordsAt = [&](const SphereSpec& sphere) {
+        const size_t column = static_cast<size_t>(projectX(worldX(sphere.screenFracX, sphere.depth), sphere.depth));
+        return records[row * kImageDim + column];
+    };
+    REQUIRE(recordsAt(kSpheres[1]) == 8);
+    REQUIRE(recordsAt(kSpheres[0]) == 16);
+}
@@ -0,0 +1,248 @@
+#include <catch2/catch_all.hpp>
+
+#include "Buffer.h"
+#include "Color.h"
+#include "ExrWriter.h"
+
+#include <zlib.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// EXR writer
+// ============================================================================
+//
+// The float output must hold the buffer's radiance exactly (float) or to half
+// precision, in the PNG's orientation, under every compression. The test reads
+// the file back with a small scanline decoder of its own: the layout checks
+// would be circular if they reused the writer's code.
+
+namespace
+{
+std::uint32_t u32(const std::vector<unsigned char>& bytes, std::size_t at)
+{
+    return static_cast<std::uint32_t>(bytes[at]) | (static_cast<std::uint32_t>(bytes[at + 1]) << 8) |
+           (static_cast<std::uint32_t>(bytes[at + 2]) << 16) |
+           (static_cast<std::uint32_t>(bytes[at + 3]) << 24);
+}
+
+float halfToFloat(std::uint16_t half)
+{
+    const int exponent = (half >> 10) & 0x1f;
+    const int mantissa = half & 0x3ff;
+    const float sign = (half & 0x8000) ? -1.0f : 1.0f;
+    if (exponent == 0)
+    {
+        return sign * std::ldexp(static_cast<float>(mantissa), -24);
+    }
+    if (exponent == 31)
+    {
+        return mantissa ? NAN : sign * INFINITY;
+    }
+    return sign * std::ldexp(static_cast<float>(mantissa + 1024), exponent - 25);
+}
+
+struct DecodedExr
+{
+    std::size_t width = 0;
+    std::size_t height = 0;
+    int compression = -1;
+    int pixelType = -1;
+    float saturationLuminance = 0.0f;
+    std::vector<Color> pixels;  // row-major, top row first
+};
+
+DecodedExr decode(const std::filesystem::path& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    const std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(in)),
+                                           std::istreambuf_iterator<char>());
+    REQUIRE(u32(bytes, 0) == 20000630u);
+    REQUIRE(u32(bytes, 4) == 2u);
+
+    DecodedExr exr;
+    std::size_t at = 8;
+    while (bytes[at] != 0)
+    {
+        const std::string name(reinterpret_cast<const char*>(&bytes[at]));
+        at += name.size() + 1;
+        const std::string type(reinterpret_cast<const char*>(&bytes[at]));
+        at += type.size() + 1;
+        const std::uint32_t size = u32(bytes, at);
+        at += 4;
+        if (name == "channels")
+        {
+            REQUIRE(std::string(reinterpret_cast<const char*>(&bytes[at])) == "B");
+            exr.pixelType = static_cast<int>(u32(bytes, at + 2));
+        }
+        else if (name == "compression")
+        {
+            exr.compression = bytes[at];
+        }
+        else if (name == "dataWindow")
+        {
+            exr.width = u32(bytes, at + 8) + 1;
+            exr.height = u32(bytes, at + 12) + 1;
+        }
+        else if (name == "saturationLuminance")
+        {
+            const std::uint32_t bits = u32(bytes, at);
+            std::memcpy(&exr.saturationLuminance, &bits, sizeof(bits));
+        }
+        at += size;
+    }
+    ++at;
+
+    const std::size_t linesPerBlock = (exr.compression == 3) ? 16 : 1;
+    const std::size_t blocks = (exr.height + linesPerBlock - 1) / linesPerBlock;
+    const std::size_t valueBytes = (exr.pixelType == 1) ? 2 : 4;
+    exr.pixels.resize(exr.width * exr.height);
+    for (std::size_t block = 0; block < blocks; ++block)
+    {
+        const std::size_t offset = u32(bytes, at + block * 8);  // files here stay < 4 GiB
+        const std::size_t firstLine = u32(bytes, offset);
+        REQUIRE(firstLine == block * linesPerBlock);
+        const std::size_t stored = u32(bytes, offset + 4);
+        const std::size_t lines = std::min(linesPerBlock, exr.height - firstLine);
+        std::vector<unsigned char> raw(lines * exr.width * 3 * valueBytes);
+        const unsigned char* data = &bytes[offset + 8];
+        if (stored == raw.size())
+        {
+            raw.assign(data, data + stored);
+        }
+        else
+        {
+            std::vector<unsigned char> predicted(raw.size());
+            uLongf size = static_cast<uLongf>(predicted.size());
+            REQUIRE(uncompress(predicted.data(), &size, data, static_cast<uLong>(stored)) == Z_OK);
+            REQUIRE(size == predicted.size());
+            for (std::size_t i = 1; i < predicted.size(); ++i)
+            {
+                predicted[i] = static_cast<unsigned char>(predicted[i - 1] + predicted[i] - 128);
+            }
+            const std::size_t half = (predicted.size() + 1) / 2;
+            for (std::size_t i = 0; i < raw.size(); ++i)
+            {
+                raw[i] = (i % 2 == 0) ? predicted[i / 2] : predicted[half + i / 2];
+            }
+        }
+        for (std::size_t line = 0; line < lines; ++line)
+        {
+            for (std::size_t channel = 0; channel < 3; ++channel)  // B, G, R
+            {
+                for (std::size_t x = 0; x < exr.width; ++x)
+                {
+                    const std::size_t i = ((line * 3 + channel) * exr.width + x) * valueBytes;
+                    float value = 0.0f;
+                    if (valueBytes == 2)
+                    {
+                        value = halfToFloat(static_cast<std::uint16_t>(raw[i] | (raw[i + 1] << 8)));
+                    }
+                    else
+                    {
+                        const std::uint32_t bits = u32(raw, i);
+                        std::memcpy(&value, &bits, sizeof(bits));
+                    }
+                    Color& pixel = exr.pixels[(firstLine + line) * exr.width + x];
+                    (channel == 0 ? pixel.blue : channel == 1 ? pixel.green : pixel.red) = value;
+                }
+            }
+        }
+    }
+    return exr;
+}
+
+Buffer gradientBuffer(std::size_t width, std::size_t height)
+{
+    Buffer buffer(width, height);
+    for (std::size_t y = 0; y < height; ++y)
+    {
+        for (std::size_t x = 0; x < width; ++x)
+        {
+            const float v = static_cast<float>(x + 1) * 0.37f + static_cast<float>(y) * 11.5f;
+            buffer.addColor({x, y}, Color{v, v * 0.5f, 1000.0f - v});
+        }
+    }
+    return buffer;
+}
+}  // namespace
+
+TEST_CASE("EXR writer: half conversion rounds to nearest even", "[exr]")
+{
+    REQUIRE(ExrWriter::toHalf(0.0f) == 0x0000);
+    REQUIRE(ExrWriter::toHalf(-0.0f) == 0x8000);
+    REQUIRE(ExrWriter::toHalf(1.0f) == 0x3c00);
+    REQUIRE(ExrWriter::toHalf(-2.0f) == 0xc000);
+    REQUIRE(ExrWriter::toHalf(0.1f) == 0x2e66);
+    REQUIRE(ExrWriter::toHalf(65504.0f) == 0x7bff);
+    REQUIRE(ExrWriter::toHalf(65520.0f) == 0x7c00);  // rounds up past the largest half
+    REQUIRE(ExrWriter::toHalf(INFINITY) == 0x7c00);
+    REQUIRE((ExrWriter::toHalf(NAN) & 0x7fff) > 0x7c00);
+    REQUIRE(ExrWriter::toHalf(std::ldexp(1.0f, -24)) == 0x0001);  // smallest subnormal
+    REQUIRE(ExrWriter::toHalf(std::ldexp(1.0f, -25)) == 0x0000);  // a tie, to even
+    REQUIRE(ExrWriter::toHalf(std::ldexp(3.0f, -25)) == 0x0002);  // a tie, to even
+    REQUIRE(ExrWriter::toHalf(1.0f + std::ldexp(1.0f, -11)) == 0x3c00);
+    REQUIRE(ExrWriter::toHalf(1.0f + std::ldexp(3.0f, -11)) == 0x3c02);
+}
+
+TEST_CASE("EXR writer: every compression holds the buffer in the PNG's orientation", "[exr]")
+{
+    // 37 rows: ZIP's sixteen-line blocks end on a short one.
+    constexpr std::size_t kWidth = 23;
+    constexpr std::size_t kHeight = 37;
+    const Buffer buffer = gradientBuffer(kWidth, kHeight);
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "rt_exr_writer.exr";
+
+    for (const ExrCompression compression :
+         {ExrCompression::None, ExrCompression::Zips, ExrCompression::Zip})
+    {
+        for (const bool halfFloat : {false, true})
+        {
+            INFO("compression " << static_cast<int>(compression) << " half " << halfFloat);
+            ExrWriter::Options options;
+            options.compression = compression;
+            options.halfFloat = halfFloat;
+            options.saturationLuminance = 250.0;
+            ExrWriter::writeBuffer(path, buffer, options);
+
+            const DecodedExr exr = decode(path);
+            REQUIRE(exr.width == kWidth);
+            REQUIRE(exr.height == kHeight);
+            REQUIRE(exr.compression == static_cast<int>(compression));
+            REQUIRE(exr.pixelType == (halfFloat ? 1 : 2));
+            REQUIRE(exr.saturationLuminance == 250.0f);
+            for (std::size_t row = 0; row < kHeight; ++row)
+            {
+                for (std::size_t col = 0; col < kWidth; ++col)
+                {
+                    // tonemapBufferToImage puts buffer (x, y) at (w-1-x, h-1-y).
+                    const Color expected =
+                        buffer.fetchColor({kWidth - 1 - col, kHeight - 1 - row});
+                    const Color& got = exr.pixels[row * kWidth + col];
+                    const float tolerance = halfFloat ? 1.0f / 1024.0f : 0.0f;
+                    REQUIRE(std::abs(got.red - expected.red) <= tolerance * std::abs(expected.red));
+                    REQUIRE(std::abs(got.green - expected.green) <=
+                            tolerance * std::abs(expected.green));
+                    REQUIRE(std::abs(got.blue - expected.blue) <= tolerance * std::abs(expected.blue));
+                }
+            }
+        }
+    }
+
+    // Compression pays on a smooth image.
+    ExrWriter::Options options;
+    options.compression = ExrCompression::None;
+    ExrWriter::writeBuffer(path, buffer, options);
+    const auto plainSize = std::filesystem::file_size(path);
+    options.compression = ExrCompression::Zip;
+    ExrWriter::writeBuffer(path, buffer, options);
+    REQUIRE(std::filesystem::file_size(path) < plainSize);
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,292 @@
+#include <catch2/catch_all.hpp>
+
+#include "FramePipeline.h"
+#include "RenderFixture.h"
+#include "Renderer.h"
+#include "SceneLoader.h"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+// Frame pipeline
+// ============================================================================
+//
+// FramePipeline overlaps one frame's tail (gather, tonemap, PNG) with the next
+// frames' first stages. The scheduler must keep the tails in frame order, hold
+// the frames in flight to the depth and the memory budget, and stop at the first
+// failure. Renderer::beginFrame / finishFrame must let a frame begin while the
+// previous one is still pending — sharing the frame cache — and still render each
+// frame exactly as renderFrame does.
+
+namespace
+{
+// Records what ran, in order, from whichever thread ran it.
+struct EventLog
+{
+    std::mutex mutex;
+    std::vector<std::string> events;
+
+    // "b3" = frame 3 began, "g3" = gathered, "o3" = output.
+    void add(char stage, std::size_t frame)
+    {
+        std::string event(1, stage);
+        event += std::to_string(frame);
+        std::lock_guard<std::mutex> lock(mutex);
+        events.push_back(std::move(event));
+    }
+};
+
+FramePipeline::Tail loggedTail(EventLog& log, std::size_t frame, std::size_t bytes)
+{
+    FramePipeline::Tail tail;
+    tail.bytes = bytes;
+    tail.gather = [&log, frame]() { log.add('g', frame); };
+    tail.output = [&log, frame]() { log.add('o', frame); };
+    return tail;
+}
+
+std::string turntableScene()
+{
+    return R"JSON({
+  "$materials": { "Matte": { "$type": "Diffuse", "$color": [0.7] } },
+  "$workerConfiguration": { "$workerCount": 2, "$fetchSize": 20000, "$photonQueueSize": 2000000 },
+  "$renderConfiguration": {
+    "$width": 48, "$height": 48, "$photonsPerLight": 100000,
+    "$bounceThreshold": 2, "$terminationThreshold": 0.01,
+    "$deterministic": true, "$seed": 3
+  },
+  "$scene": {
+    "Camera": { "$type": "Camera", "$verticalFieldOfView": 60.0,
+      "$position": [0.0, 0.0, -200.0],
+      "$rotation": { "$type": "PitchYawRollDegrees", "$value": [0.0, 0.0, 0.0] } },
+    "Light": { "$type": "OmniLight", "$position": [0.0, 0.0, -130.0],
+      "$color": [1.0, 1.0, 1.0], "$brightness": 300000 },
+    "Mover": { "$type": "SphereVolume", "$material": "Matte",
+      "$center": [-35.0, 0.0, -30.0], "$radius": 26.0,
+      "$animation": { "$position": [
+        { "t": 0.0, "value": [-35.0, 0.0, -30.0] },
+        { "t": 1.0, "value": [ 35.0, 0.0, -30.0] } ] } },
+    "BackWall": { "$type": "SphereVolume", "$material": "Matte",
+      "$center": [0.0, 0.0, 500.0], "$radius": 380.0 }
+  }
+})JSON";
+}
+
+LoadedScene loadScene(const std::string& json)
+{
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "rt_frame_pipeline_scene.json";
+    {
+        std::ofstream out(path);
+        out << json;
+    }
+    LoadedScene scene = SceneLoader::loadFromFile(path.string(), /*logToStdout=*/false);
+    std::filesystem::remove(path);
+    return scene;
+}
+}  // namespace
+
+TEST_CASE("Frame pipeline: depth 1 runs each frame's stages in turn", "[pipeline]")
+{
+    EventLog log;
+    const FramePipeline::Stats stats =
+        FramePipeline::run(2, 4, FramePipeline::Limits{}, [&](std::size_t frame) {
+            log.add('b', frame);
+            return loggedTail(log, frame, 10);
+        });
+    REQUIRE(log.events ==
+            std::vector<std::string>{"b2", "g2", "o2", "b3", "g3", "o3", "b4", "g4", "o4"});
+    REQUIRE(stats.peakFrames == 1);
+    REQUIRE(stats.peakBytes == 10);
+}
+
+TEST_CASE("Frame pipeline: the next frame begins while the last one's tail runs", "[pipeline]")
+{
+    // Frame 0's gather waits for frame 1 to begin: only an overlapping pipeline
+    // gets past it.
+    EventLog log;
+    std::atomic<bool> secondBegun{false};
+    FramePipeline::Limits limits;
+    limits.depth = 2;
+    const FramePipeline::Stats stats = FramePipeline::run(0, 5, limits, [&](std::size_t frame) {
+        log.add('b', frame);
+        if (frame == 1)
+        {
+            secondBegun = true;
+        }
+        FramePipeline::Tail tail = loggedTail(log, frame, 10);
+        if (frame == 0)
+        {
+            tail.gather = [&]() {
+                while (!secondBegun)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                log.add('g', 0);
+            };
+        }
+        return tail;
+    });
+
+    REQUIRE(stats.peakFrames == 2);
+    // Tails in frame order, each gather before its output.
+    std::vector<std::string> tails;
+    for (const std::string& event : log.events)
+    {
+        if (event[0] != 'b')
+        {
+            tails.push_back(event);
+        }
+    }
+    REQUIRE(tails == std::vector<std::string>{"g0", "o0", "g1", "o1", "g2", "o2", "g3", "o3",
+                                              "g4", "o4", "g5", "o5"});
+}
+
+TEST_CASE("Frame pipeline: frames in flight stay within the depth and the memory budget",
+          "[pipeline]")
+{
+    const auto runWith = [](std::size_t depth, std::size_t budget, std::size_t frameBytes) {
+        EventLog log;
+        FramePipeline::Limits limits;
+        limits.depth = depth;
+        limits.memoryBudget = budget;
+        return FramePipeline::run(0, 11, limits, [&](std::size_t frame) {
+            FramePipeline::Tail tail = loggedTail(log, frame, frameBytes);
+            // A slow tail, so the first stages catch up with it.
+            tail.gather = []() { std::this_thread::sleep_for(std::chrono::milliseconds(5)); };
+            return tail;
+        });
+    };
+
+    const FramePipeline::Stats deep = runWith(3, 0, 10);
+    REQUIRE(deep.peakFrames == 3);
+    REQUIRE(deep.peakBytes == 30);
+
+    // 25 bytes hold two 10-byte frames, so the depth of 3 is never reached.
+    const FramePipeline::Stats budgeted = runWith(3, 25, 10);
+    REQUIRE(budgeted.peakFrames == 2);
+    REQUIRE(budgeted.peakBytes <= 25);
+
+    // A frame larger than the whole budget still renders, alone.
+    const FramePipeline::Stats oversized = runWith(3, 25, 100);
+    REQUIRE(oversized.peakFrames == 1);
+}
+
+TEST_CASE("Frame pipeline: a failing frame stops the run after the frames before it",
+          "[pipeline]")
+{
+    FramePipeline::Limits limits;
+    limits.depth = 3;
+
+    EventLog tailLog;
+    REQUIRE_THROWS_AS(FramePipeline::run(0, 9, limits,
+                                         [&](std::size_t frame) {
+                                             FramePipeline::Tail tail =
+                                                 loggedTail(tailLog, frame, 1);
+                                             if (frame == 2)
+                                             {
+                                                 tail.output = []() {
+                                                     throw std::runtime_error("disk full");
+                                                 };
+                                             }
+                                             return tail;
+                                         }),
+                      std::runtime_error);
+    // Frames 0 and 1 were written; nothing after frame 2 was.
+    std::vector<std::string> outputs;
+    for (const std::string& event : tailLog.events)
+    {
+        if (event[0] == 'o')
+        {
+            outputs.push_back(event);
+        }
+    }
+    REQUIRE(outputs == std::vector<std::string>{"o0", "o1"});
+
+    EventLog beginLog;
+    REQUIRE_THROWS_AS(FramePipeline::run(0, 9, limits,
+                                         [&](std::size_t frame) {
+                                             if (frame == 4)
+                                             {
+                                                 throw std::runtime_error("bad scene");
+                                             }
+                                             return loggedTail(beginLog, frame, 1);
+                                         }),
+                      std::runtime_error);
+    REQUIRE(beginLog.events.size() == 8);  // frames 0-3 gathered and written
+    REQUIRE(beginLog.events.back() == "o3");
+}
+
+TEST_CASE("Frame pipeline render: overlapped frames match sequential renders",
+          "[pipeline][render]")
+{
+    LoadedScene scene = loadScene(turntableScene());
+    const std::vector<double> times{0.0, 0.125, 0.25};
+
+    // Sequential reference, with the frame cache carrying records frame to frame.
+    std::vector<RenderResult> sequential;
+    {
+        FrameCache cache;
+        for (const double time : times)
+        {
+            scene.settings.frameTime = time;
+            sequential.push_back(Renderer::renderFrame(scene, nullptr, nullptr, &cache));
+        }
+    }
+    REQUIRE(sequential.back().probeTilesReused > 0);
+
+    // Every frame begun before any finishes: each later beginFrame reads and
+    // replaces the cache's records while the earlier frames still hold theirs.
+    {
+        FrameCache cache;
+        std::vector<std::shared_ptr<PendingFrame>> pending;
+        for (const double time : times)
+        {
+            scene.settings.frameTime = time;
+            pending.push_back(Renderer::beginFrame(scene, nullptr, nullptr, &cache));
+            REQUIRE(Renderer::pendingFrameBytes(*pending.back()) > 48 * 48 * 12);
+        }
+        for (std::size_t i = 0; i < times.size(); ++i)
+        {
+            const RenderResult finished = Renderer::finishFrame(*pending[i]);
+            INFO("frame " << i);
+            REQUIRE(finished.probeTilesReused == sequential[i].probeTilesReused);
+            REQUIRE(rt_test::buffersBitwiseEqual(*finished.buffer, *sequential[i].buffer, 48, 48));
+        }
+    }
+
+    // The same through the pipeline's tail thread.
+    {
+        FrameCache cache;
+        std::vector<RenderResult> pipelined(times.size());
+        FramePipeline::Limits limits;
+        limits.depth = 3;
+        FramePipeline::run(0, times.size() - 1, limits, [&](std::size_t frame) {
+            scene.settings.frameTime = times[frame];
+            std::shared_ptr<PendingFrame> frameState =
+                Renderer::beginFrame(scene, nullptr, nullptr, &cache);
+            FramePipeline::Tail tail;
+            tail.bytes = Renderer::pendingFrameBytes(*frameState);
+            tail.gather = [&pipelined, frame, frameState]() {
+                pipelined[frame] = Renderer::finishFrame(*frameState);
+            };
+            tail.output = []() {};
+            return tail;
+        });
+        for (std::size_t i = 0; i < times.size(); ++i)
+        {
+            INFO("frame " << i);
+            REQUIRE(rt_test::buffersBitwiseEqual(*pipelined[i].buffer, *sequential[i].buffer, 48, 48));
+        }
+    }
+}
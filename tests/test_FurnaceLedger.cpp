@@ -39,7 +39,7 @@ TEST_CASE("T1 FurnaceLedger: total deposited power matches the truncated geometr
     p.albedo = 0.5;
     p.bounceThreshold = 4;
     p.brightnessCd = 100.0;
-    p.photonsPerLight = 80000;  // 80k * (B+1=5) = 400k deposits < 48*48*256 capacity
+    p.photonsPerLight = 80000;  // 80k * (B+1=5) = 400k deposits, far under the $bounceStoreCapacity ceiling
     p.half = 100.0;
 
     WorkerDebug::resetBounceCounters();
@@ -0,0 +1,234 @@
+#include <catch2/catch_all.hpp>
+
+#include "BounceStore.h"
+#include "Buffer.h"
+#include "Camera.h"
+#include "LambertianMaterial.h"
+#include "MaterialLibrary.h"
+#include "ProbeGather.h"
+#include "RandomGenerator.h"
+#include "RenderFixture.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+// Gather record order (tile-owned, spatially sorted, dynamically scheduled)
+// ============================================================================
+//
+// ProbeGather::run hands a camera's records to threads as whole screen tiles from
+// a shared cursor; the owning thread sums the tile's pixels in a plain-float
+// accumulator and flushes each pixel to the Buffer once. Inside a tile, records run
+// in Morton order of their world position. That is a SCHEDULING change only:
+// every record still adds the same contribution to the same pixel, so the image
+// must match the probe-pass-order gather up to float summation order. Rendered
+// deterministically (one worker, seeded) so the photon set — and thus the
+// BounceStore — is identical across the two runs; the mirror sphere interleaves
+// reflected records with direct ones, which is exactly the case the sort reorders.
+
+namespace
+{
+std::string orderScene(bool spatialOrder)
+{
+    std::string s = R"JSON({
+  "$materials": {
+    "Matte": { "$type": "Diffuse", "$color": [0.7] },
+    "MirrorMat": { "$type": "Mirror", "$color": [0.95, 0.95, 0.95] }
+  },
+  "$workerConfiguration": { "$workerCount": 1, "$fetchSize": 20000, "$photonQueueSize": 2000000 },
+  "$renderConfiguration": {
+    "$width": 40, "$height": 40, "$photonsPerLight": 200000,
+    "$bounceThreshold": 2, "$terminationThreshold": 0.01,
+    "$deterministic": true, "$seed": 19, "$gatherSpatialOrder": )JSON";
+    s += spatialOrder ? "true" : "false";
+    s += R"JSON(
+  },
+  "$scene": {
+    "Camera": { "$type": "Camera", "$verticalFieldOfView": 60.0,
+      "$position": [0.0, 0.0, -200.0],
+      "$rotation": { "$type": "PitchYawRollDegrees", "$value": [0.0, 0.0, 0.0] } },
+    "Light": { "$type": "OmniLight", "$position": [0.0, 80.0, -60.0],
+      "$color": [1.0, 1.0, 1.0], "$brightness": 50000 },
+    "Ball": { "$type": "SphereVolume", "$material": "MirrorMat",
+      "$center": [-30.0, 0.0, 0.0], "$radius": 30.0 },
+    "Sphere": { "$type": "SphereVolume", "$material": "Matte",
+      "$center": [35.0, 0.0, 20.0], "$radius": 30.0 },
+    "BackWall": { "$type": "SphereVolume", "$material": "Matte",
+      "$center": [0.0, 0.0, 400.0], "$radius": 300.0 }
+  }
+})JSON";
+    return s;
+}
+}  // namespace
+
+TEST_CASE("Gather order: Morton-sorted tiled gather matches probe-pass order",
+          "[ProbeGather][GatherOrder]")
+{
+    rt_test::RenderScene sorted{orderScene(true)};
+    rt_test::RenderScene unsorted{orderScene(false)};
+
+    // Same photon pass => same deposits.
+    REQUIRE(sorted.result.bounceStore->size() == unsorted.result.bounceStore->size());
+
+    const double mean = sorted.meanLuminance();
+    REQUIRE(mean > 0.0);
+
+    // Only the float summation order differs: the images agree to rounding.
+    const double error =
+        rt_test::rmse(sorted.buffer(), unsorted.buffer(), sorted.width(), sorted.height());
+    INFO("mean=" << mean << " rmse=" << error);
+    REQUIRE(error <= mean * 1e-5);
+
+    // And the sorted, tiled gather is itself bitwise-reproducible in
+    // deterministic mode (one worker drains the tiles in order).
+    const RenderResult again = sorted.renderAgain();
+    REQUIRE(rt_test::buffersBitwiseEqual(sorted.buffer(), *again.buffer, sorted.width(),
+                                         sorted.height()));
+}
+
+TEST_CASE("Gather order: tile ownership makes the gather independent of worker count",
+          "[ProbeGather][GatherOrder]")
+{
+    // Every pixel belongs to exactly one tile, a tile to exactly one thread, and
+    // each tile's records run in a fixed order, so each pixel's sum is formed the
+    // same way no matter how many workers split the tiles: the gather itself (for
+    // a fixed BounceStore) is bitwise-identical across worker counts. Many samples
+    // per pixel stand in for glass/DOF pixels, the old CAS-contention case.
+    auto materials = std::make_shared<MaterialLibrary>();
+    materials->add(std::make_shared<LambertianMaterial>("diffuse", Color{0.8f, 0.8f, 0.8f}));
+    const size_t matIndex = materials->indexForName("diffuse");
+
+    constexpr size_t kWidth = 40;
+    constexpr size_t kHeight = 24;
+    auto camera = std::make_shared<Camera>(kWidth, kHeight, 60.0);
+
+    RandomGenerator random(77u);
+    BounceStore store(20000);
+    for (int i = 0; i < 20000; ++i)
+    {
+        store.append(RawBounce{Vector{random.value(40.0), random.value(24.0), 0.0},
+                               Vector{0.0, 0.0, -1.0}, Vector{0.0, 0.0, 1.0},
+                               RawBounce::kTimelessDeposit,
+                               Color{random.value(1.0f) > 0.5 ? 1.0f : 0.5f, 0.3f, 0.1f}});
+    }
+    store.buildIndex(1.0);
+
+    ProbeGather::GatherPointStore points(kWidth);
+    for (size_t y = 0; y < kHeight; ++y)
+    {
+        for (size_t x = 0; x < kWidth; ++x)
+        {
+            for (int sample = 0; sample < 16; ++sample)
+            {
+                ProbeGather::GatherPoint gp;
+                gp.pixel = {x, y};
+                gp.position = Vector{x + random.value(1.0), y + random.value(1.0), 0.0};
+                gp.normal = Vector{0.0, 0.0, 1.0};
+                gp.viewDir = Vector{0.0, 0.0, 1.0};
+                gp.materialIndex = matIndex;
+                gp.footprintRadius = 0.75;
+                gp.sampleWeight = 1.0f / 16.0f;
+                points.push_back(gp);
+            }
+        }
+    }
+
+    Buffer single(kWidth, kHeight);
+    Buffer several(kWidth, kHeight);
+    const ProbeGather::Result a =
+        ProbeGather::run(camera, points, store, *materials, 1, 0.0, single);
+    const ProbeGather::Result b =
+        ProbeGather::run(camera, points, store, *materials, 6, 0.0, several);
+
+    REQUIRE(a.pixelsGathered == points.size());
+    REQUIRE(b.pixelsGathered == points.size());
+    REQUIRE(rt_test::meanLuminance(single, kWidth, kHeight) > 0.0);
+    REQUIRE(rt_test::buffersBitwiseEqual(single, several, kWidth, kHeight));
+}
+
+TEST_CASE("Gather order: a combined multi-camera gather gives each camera its own gather",
+          "[ProbeGather][GatherOrder][MultiCamera]")
+{
+    // runCameras puts every camera's tiles in one queue; each tile still belongs to
+    // one camera and one thread, so every camera's image and counters must be what
+    // its own run() gives it. Witness cameras of different sizes, one with no
+    // records at all.
+    auto materials = std::make_shared<MaterialLibrary>();
+    materials->add(std::make_shared<LambertianMaterial>("diffuse", Color{0.6f, 0.7f, 0.8f}));
+    const size_t matIndex = materials->indexForName("diffuse");
+
+    RandomGenerator random(31u);
+    BounceStore store(30000);
+    for (int i = 0; i < 30000; ++i)
+    {
+        store.append(RawBounce{Vector{random.value(48.0), random.value(32.0), 0.0},
+                               Vector{0.0, 0.0, -1.0}, Vector{0.0, 0.0, 1.0},
+                               RawBounce::kTimelessDeposit, Color{0.9f, 0.5f, 0.2f}});
+    }
+    store.buildIndex(1.0);
+
+    const std::vector<std::pair<size_t, size_t>> sizes{{48, 32}, {9, 7}, {20, 20}, {17, 5}};
+    std::vector<std::shared_ptr<Camera>> cameras;
+    std::vector<ProbeGather::GatherPointStore> points;
+    for (size_t c = 0; c < sizes.size(); ++c)
+    {
+        const auto [w, h] = sizes[c];
+        cameras.push_back(std::make_shared<Camera>(w, h, 60.0));
+        points.emplace_back(w);
+        if (c == 2)
+        {
+            continue;  // a camera whose records all missed
+        }
+        for (size_t y = 0; y < h; ++y)
+        {
+            for (size_t x = 0; x < w; ++x)
+            {
+                for (int sample = 0; sample < 3; ++sample)
+                {
+                    ProbeGather::GatherPoint gp;
+                    gp.pixel = {x, y};
+                    gp.position = Vector{random.value(48.0), random.value(32.0), 0.0};
+                    gp.normal = Vector{0.0, 0.0, 1.0};
+                    gp.viewDir = Vector{0.0, 0.0, 1.0};
+                    gp.materialIndex = matIndex;
+                    gp.footprintRadius = 0.5 + random.value(1.0);
+                    gp.sampleWeight = 1.0f / 3.0f;
+                    points.back().push_back(gp);
+                }
+            }
+        }
+    }
+
+    std::vector<Buffer> own;
+    std::vector<Buffer> combined;
+    for (const auto& [w, h] : sizes)
+    {
+        own.emplace_back(w, h);
+        combined.emplace_back(w, h);
+    }
+    std::vector<ProbeGather::Result> ownResults;
+    std::vector<ProbeGather::CameraGather> jobs;
+    for (size_t c = 0; c < sizes.size(); ++c)
+    {
+        ownResults.push_back(
+            ProbeGather::run(cameras[c], points[c], store, *materials, 1, 0.0, own[c]));
+        jobs.push_back(ProbeGather::CameraGather{cameras[c], &points[c], &combined[c]});
+    }
+    const std::vector<ProbeGather::Result> results =
+        ProbeGather::runCameras(jobs, store, *materials, 6, 0.0);
+
+    REQUIRE(results.size() == sizes.size());
+    for (size_t c = 0; c < sizes.size(); ++c)
+    {
+        INFO("camera " << c);
+        REQUIRE(results[c].pixelsHit == ownResults[c].pixelsHit);
+        REQUIRE(results[c].pixelsGathered == ownResults[c].pixelsGathered);
+        REQUIRE(results[c].depositsAccum == ownResults[c].depositsAccum);
+        REQUIRE(rt_test::buffersBitwiseEqual(own[c], combined[c], sizes[c].first,
+                                             sizes[c].second));
+    }
+    REQUIRE(results[0].pixelsGathered > 0);
+    REQUIRE(results[2].pixelsHit == 0);
+}
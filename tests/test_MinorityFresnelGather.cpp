@@ -1,6 +1,7 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include "Image.h"
+#include "ProbeGather.h"
 #include "Renderer.h"
 #include "SceneLoader.h"
 
@@ -138,3 +139,51 @@ TEST_CASE("A surface seen only via the minority Fresnel branch of glass is gathe
     REQUIRE(r > 1.3 * g);
     REQUIRE(r > 1.3 * b);
 }
+
+// The glass sphere's pixels fan into kCameraSamplesPerPixel Fresnel picks that all
+// share the same camera segment. The probe pass casts that segment ONCE and starts
+// every pick's extension from the hit in hand; re-casting it per pick must give the
+// very same records (same RNG draws, same hits) at the cost of one extra
+// first-segment intersection per extension sample.
+TEST_CASE("Glass extension samples start from the known first hit without changing records",
+          "[ProbeGather][glass]")
+{
+    const std::string path = writeMinorityFresnelScene();
+    LoadedScene scene = SceneLoader::loadFromFile(path, /*logToStdout=*/false);
+    std::remove(path.c_str());
+
+    const auto probe = [&scene](bool reuseFirstHit) {
+        return ProbeGather::collectGatherPoints(scene.objects, *scene.camera,
+                                                *scene.materialLibrary, scene.animation.get(),
+                                                0.0f, 0.0f, 1, 1, 23, 2,
+                                                /*adaptiveSamples=*/false, /*reuse=*/nullptr,
+                                                reuseFirstHit);
+    };
+    const ProbeGather::ProbeResult known = probe(true);
+    const ProbeGather::ProbeResult recast = probe(false);
+
+    INFO("first-segment casts: known=" << known.firstSegmentCasts
+         << " recast=" << recast.firstSegmentCasts
+         << " | extensions=" << known.deltaExtensions);
+    REQUIRE(known.deltaExtensions > 0);
+    REQUIRE(known.firstSegmentCasts == known.cameraRays);
+    REQUIRE(recast.firstSegmentCasts == recast.cameraRays + recast.deltaExtensions);
+    REQUIRE(known.firstSegmentCasts < recast.firstSegmentCasts);
+
+    REQUIRE(recast.points.size() == known.points.size());
+    for (std::size_t i = 0; i < known.points.size(); ++i)
+    {
+        const ProbeGather::GatherPoint a = known.points[i];
+        const ProbeGather::GatherPoint b = recast.points[i];
+        REQUIRE(a.pixel.x == b.pixel.x);
+        REQUIRE(a.pixel.y == b.pixel.y);
+        REQUIRE(a.position.x == b.position.x);
+        REQUIRE(a.position.y == b.position.y);
+        REQUIRE(a.position.z == b.position.z);
+        REQUIRE(a.materialIndex == b.materialIndex);
+        REQUIRE(a.specularThroughput.red == b.specularThroughput.red);
+        REQUIRE(a.unfoldedPathLength == b.unfoldedPathLength);
+        REQUIRE(a.footprintRadius == b.footprintRadius);
+        REQUIRE(a.sampleWeight == b.sampleWeight);
+    }
+}
@@ -5,11 +5,15 @@
 #include "Hit.h"
 #include "ProbeGather.h"
 #include "RenderFixture.h"
+#include "SceneLoader.h"
 #include "StatAssert.h"
 #include "Vector.h"
 
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -360,3 +364,49 @@ TEST_CASE("#63 reflected footprint: the reflected feature is sharper than the pr
     // and a "fix" that blurred the direct path to match would trip this.
     REQUIRE(directSpread < 90.0);
 }
+
+// ----------------------------------------------------------------------------
+// #63 — the probe pass reuses the left neighbour's chain for the differential
+// ----------------------------------------------------------------------------
+//
+// With one fixed primary ray per pixel, a mirror record's adjacent reflected hit
+// is the endpoint the LEFT neighbour's own chain already reached; only the tile's
+// left-edge pixels (and neighbours on a different surface) re-trace. On the mirror
+// box nearly every mirror record must reuse, and because tile edges — not thread
+// boundaries — decide where reuse stops, the records (footprints included) stay
+// bitwise-identical across probe-pass worker counts.
+TEST_CASE("#63 reflected footprint: mirror differentials reuse the left neighbour's chain",
+          "[MirrorDirectParity][ReflectedFootprint][T4]")
+{
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "rt_mirror_differential_reuse.json";
+    {
+        std::ofstream out(path);
+        out << reflectedSharpnessScene();
+    }
+    LoadedScene scene = SceneLoader::loadFromFile(path.string(), /*logToStdout=*/false);
+    std::remove(path.string().c_str());
+
+    const auto probe = [&scene](size_t workerCount) {
+        return ProbeGather::collectGatherPoints(scene.objects, *scene.camera,
+                                                *scene.materialLibrary, scene.animation.get(),
+                                                0.0f, 0.0f, 1, 1, 9, workerCount);
+    };
+    const ProbeGather::ProbeResult single = probe(1);
+    const ProbeGather::ProbeResult several = probe(4);
+
+    INFO("reused = " << single.reusedDifferentials
+         << " | re-traced = " << single.differentialTraces);
+    REQUIRE(single.reusedDifferentials > 0);
+    // One re-trace per tile row at most along the mirror, plus the silhouette.
+    REQUIRE(single.differentialTraces * 4 < single.reusedDifferentials);
+
+    REQUIRE(several.reusedDifferentials == single.reusedDifferentials);
+    REQUIRE(several.points.size() == single.points.size());
+    for (size_t i = 0; i < single.points.size(); ++i)
+    {
+        REQUIRE(several.points[i].pixel.x == single.points[i].pixel.x);
+        REQUIRE(several.points[i].pixel.y == single.points[i].pixel.y);
+        REQUIRE(several.points[i].footprintRadius == single.points[i].footprintRadius);
+    }
+}
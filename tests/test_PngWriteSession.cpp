@@ -223,3 +223,88 @@ TEST_CASE("PngWriteSession rgba8 round-trips to a valid 8-bit RGBA PNG",
     REQUIRE(hdr.bitDepth == 8);
     REQUIRE(hdr.colorType == 6);  // PNG_COLOR_TYPE_RGBA
 }
+
+namespace
+{
+
+// Decode a 16-bit RGB PNG with libpng's own reader into native-endian values.
+// Returns false on any libpng error (e.g. a corrupt zlib stream or CRC).
+bool readRgb16(const std::filesystem::path& path, uint32_t& width, uint32_t& height,
+               std::vector<png_uint_16>& pixels)
+{
+    FILE* file = fopen(path.string().c_str(), "rb");
+    if (file == nullptr) return false;
+    png_structp png = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+    png_infop info = png_create_info_struct(png);
+    std::vector<png_bytep> rows;
+    if (setjmp(png_jmpbuf(png)))
+    {
+        png_destroy_read_struct(&png, &info, nullptr);
+        fclose(file);
+        return false;
+    }
+    png_init_io(png, file);
+    png_read_info(png, info);
+    width = png_get_image_width(png, info);
+    height = png_get_image_height(png, info);
+    if (png_get_bit_depth(png, info) != 16 || png_get_color_type(png, info) != PNG_COLOR_TYPE_RGB)
+    {
+        png_error(png, "not RGB16");
+    }
+    png_set_swap(png);  // the file is big-endian; hand back native values
+    pixels.assign(static_cast<size_t>(width) * height * 3U, 0);
+    rows.resize(height);
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        rows[y] = reinterpret_cast<png_bytep>(pixels.data() + static_cast<size_t>(y) * width * 3U);
+    }
+    png_read_image(png, rows.data());
+    png_read_end(png, nullptr);
+    png_destroy_read_struct(&png, &info, nullptr);
+    fclose(file);
+    return true;
+}
+
+}  // namespace
+
+// writeRgb16 deflates strips of rows on separate threads and joins the streams
+// into one zlib stream; libpng's reader must get every pixel back. 1000 x 400
+// makes three strips of ~1 MiB, the last a short one, and the mix of a smooth
+// ramp and noise exercises every row filter.
+TEST_CASE("PngWriteSession rgb16 strips decode to the original pixels",
+          "[PngWriteSession]")
+{
+    for (const uint32_t h : {400U, 1U})
+    {
+        const uint32_t w = 1000;
+        std::vector<png_uint_16> px(static_cast<size_t>(w) * h * 3U);
+        uint32_t noise = 12345;
+        for (uint32_t y = 0; y < h; ++y)
+        {
+            for (uint32_t x = 0; x < w; ++x)
+            {
+                noise = noise * 1664525U + 1013904223U;
+                const size_t base = (static_cast<size_t>(y) * w + x) * 3U;
+                px[base + 0] = static_cast<png_uint_16>(x * 65);
+                px[base + 1] = static_cast<png_uint_16>(y * 163 + x);
+                px[base + 2] = static_cast<png_uint_16>((y % 3 == 0) ? (noise >> 16) : x * y);
+            }
+        }
+
+        const auto path = tempPath("rt_pws_rgb16_strips.png");
+        {
+            PngWriteSession s(path);
+            REQUIRE(s.valid());
+            REQUIRE(s.writeRgb16(w, h, px.data(), "strips"));
+        }
+
+        uint32_t readWidth = 0;
+        uint32_t readHeight = 0;
+        std::vector<png_uint_16> back;
+        REQUIRE(readRgb16(path, readWidth, readHeight, back));
+        std::filesystem::remove(path);
+        REQUIRE(readWidth == w);
+        REQUIRE(readHeight == h);
+        REQUIRE(back == px);
+    }
+}
@@ -2,14 +2,24 @@
 
 #include "AreaLight.h"
 #include "BounceStore.h"
+#include "Camera.h"
 #include "Color.h"
+#include "LambertianMaterial.h"
+#include "MaterialLibrary.h"
 #include "ProbeGather.h"
 #include "ProbeIndex.h"
 #include "Quaternion.h"
+#include "RandomGenerator.h"
+#include "SphereVolume.h"
 #include "Utility.h"
 #include "Vector.h"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -52,6 +62,253 @@ TEST_CASE("ProbeIndex with no probes culls everything", "[ProbeGather][ProbeInde
     REQUIRE_FALSE(index.anyWithinKeepRadius(Vector{0.0, 0.0, 0.0}));
 }
 
+TEST_CASE("ProbeIndex occupancy keep-test agrees with a brute-force scan", "[ProbeGather][ProbeIndex]")
+{
+    // The keep-test answers most points from the dilated occupancy table
+    // ("definitely culled" / "definitely kept") and only scans probes in the
+    // boundary shell. It must give EXACTLY the brute-force answer everywhere —
+    // including points placed right at the keep radius of some probe, at
+    // negative coordinates (floor division), and far from every probe.
+    RandomGenerator random(1234u);
+    const double keepRadius = 0.3;
+
+    std::vector<Vector> probes;
+    for (int i = 0; i < 400; ++i)
+    {
+        // A tilted, slightly noisy surface patch straddling the origin.
+        const double u = random.value(8.0) - 4.0;
+        const double v = random.value(8.0) - 4.0;
+        const double y = 0.25 * u - 0.5 * v + random.value(0.02);
+        // Probe positions are held as floats; keep the brute force on the same set.
+        probes.push_back(Vector{static_cast<float>(u), static_cast<float>(y), static_cast<float>(v)});
+    }
+    ProbeIndex index(probes, keepRadius, keepRadius);
+    REQUIRE(index.occupancyCellCount() > 0);
+
+    const auto bruteForce = [&](const Vector& p) {
+        for (const Vector& probe : probes)
+        {
+            const double dx = probe.x - p.x;
+            const double dy = probe.y - p.y;
+            const double dz = probe.z - p.z;
+            if (dx * dx + dy * dy + dz * dz <= keepRadius * keepRadius)
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    std::size_t kept = 0;
+    std::size_t culled = 0;
+    for (int i = 0; i < 20000; ++i)
+    {
+        Vector p;
+        if (i % 2 == 0)
+        {
+            // Near the boundary of a random probe's keep sphere.
+            const Vector& probe = probes[static_cast<std::size_t>(random.value(static_cast<double>(probes.size()))) % probes.size()];
+            const Vector dir = Vector{random.value(2.0) - 1.0, random.value(2.0) - 1.0, random.value(2.0) - 1.0}.normalized();
+            p = probe + dir * (keepRadius * (0.9 + random.value(0.2)));
+        }
+        else
+        {
+            p = Vector{random.value(10.0) - 5.0, random.value(4.0) - 2.0, random.value(10.0) - 5.0};
+        }
+        const bool expected = bruteForce(p);
+        REQUIRE(index.anyWithinKeepRadius(p) == expected);
+        (expected ? kept : culled) += 1;
+    }
+    // Both outcomes were actually exercised.
+    REQUIRE(kept > 1000);
+    REQUIRE(culled > 1000);
+}
+
+TEST_CASE("ProbeIndex collectWithin returns exactly the probes inside the radius", "[ProbeGather][ProbeIndex]")
+{
+    // Two sources, so the returned refs must carry the source and the index within it.
+    RandomGenerator random(77u);
+    std::vector<float> xs, ys, zs;
+    for (int i = 0; i < 600; ++i)
+    {
+        xs.push_back(static_cast<float>(random.value(6.0) - 3.0));
+        ys.push_back(static_cast<float>(random.value(6.0) - 3.0));
+        zs.push_back(static_cast<float>(random.value(1.0)));
+    }
+    ProbeIndex index({ProbePositions{xs.data(), ys.data(), zs.data(), 250},
+                      ProbePositions{xs.data() + 250, ys.data() + 250, zs.data() + 250, 350}},
+                     0.4, 0.4);
+
+    std::vector<ProbeIndex::ProbeRef> found;
+    for (int q = 0; q < 200; ++q)
+    {
+        const Vector p{random.value(6.0) - 3.0, random.value(6.0) - 3.0, random.value(1.0)};
+        const double r = 0.1 + random.value(0.8);  // below and above the cell size
+        index.collectWithin(p, r, found);
+
+        std::vector<std::size_t> got;
+        for (const ProbeIndex::ProbeRef& ref : found)
+        {
+            REQUIRE(ref.source < 2);
+            got.push_back(ref.source * 250 + ref.index);
+        }
+        std::vector<std::size_t> expected;
+        for (std::size_t i = 0; i < xs.size(); ++i)
+        {
+            const double dx = xs[i] - p.x;
+            const double dy = ys[i] - p.y;
+            const double dz = zs[i] - p.z;
+            if (dx * dx + dy * dy + dz * dz <= r * r)
+            {
+                expected.push_back(i);
+            }
+        }
+        std::sort(got.begin(), got.end());
+        REQUIRE(got == expected);
+    }
+}
+
+// ===== GatherPointStore: compact per-camera records =====
+
+TEST_CASE("GatherPointStore round-trips records through the packed columns", "[ProbeGather][GatherPointStore]")
+{
+    RandomGenerator random(42u);
+    ProbeGather::GatherPointStore store(64);
+    std::vector<ProbeGather::GatherPoint> expected;
+    for (int i = 0; i < 2000; ++i)
+    {
+        ProbeGather::GatherPoint gp;
+        gp.pixel = {static_cast<size_t>(random.value(64.0)) % 64, static_cast<size_t>(random.value(48.0)) % 48};
+        gp.position = Vector{random.value(200.0) - 100.0, random.value(200.0) - 100.0, random.value(200.0) - 100.0};
+        gp.normal = Vector{random.value(2.0) - 1.0, random.value(2.0) - 1.0, random.value(2.0) - 1.0}.normalized();
+        gp.viewDir = Vector{random.value(2.0) - 1.0, random.value(2.0) - 1.0, random.value(2.0) - 1.0}.normalized();
+        gp.materialIndex = (i % 7 == 0) ? ProbeGather::testing::kEmitterMaterial : static_cast<size_t>(i % 5);
+        gp.specularThroughput = Color{0.9f, 0.5f, 0.25f};
+        gp.unfoldedPathLength = random.value(500.0);
+        gp.footprintRadius = random.value(2.0);
+        gp.sampleTime = static_cast<float>(random.value(1.0));
+        gp.sampleWeight = 1.0f / 16.0f;
+        store.push_back(gp);
+        expected.push_back(gp);
+    }
+    REQUIRE(store.size() == expected.size());
+    // Well under half the unpacked record size.
+    REQUIRE(store.memoryBytes() < store.size() * sizeof(ProbeGather::GatherPoint) / 2);
+
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        const ProbeGather::GatherPoint gp = store[i];
+        const ProbeGather::GatherPoint& want = expected[i];
+        REQUIRE(gp.pixel.x == want.pixel.x);
+        REQUIRE(gp.pixel.y == want.pixel.y);
+        REQUIRE(gp.materialIndex == want.materialIndex);
+        REQUIRE((gp.position - want.position).magnitude() < 1e-4);
+        // Octahedral 16-bit packing: unit length, within ~1e-4 of the input.
+        REQUIRE(gp.normal.magnitude() == Catch::Approx(1.0).margin(1e-9));
+        REQUIRE(Vector::dot(gp.normal, want.normal) > 1.0 - 1e-8);
+        REQUIRE(Vector::dot(gp.viewDir, want.viewDir) > 1.0 - 1e-8);
+        REQUIRE(gp.footprintRadius == Catch::Approx(want.footprintRadius).epsilon(1e-6));
+        REQUIRE(gp.sampleTime == want.sampleTime);
+        REQUIRE(gp.sampleWeight == want.sampleWeight);
+    }
+
+    // Indices that do not fit their packed widths are rejected, not truncated.
+    ProbeGather::GatherPoint wide;
+    wide.pixel = {64, 0};
+    REQUIRE_THROWS_AS(store.push_back(wide), std::runtime_error);
+    ProbeGather::GatherPoint manyMaterials;
+    manyMaterials.materialIndex = 70000;
+    REQUIRE_THROWS_AS(store.push_back(manyMaterials), std::runtime_error);
+}
+
+TEST_CASE("collectGatherPoints rethrows a worker's record error on the calling thread",
+          "[ProbeGather][GatherPointStore]")
+{
+    // The sphere's material index does not fit the store's 16-bit material column,
+    // so every probe-pass tile that sees it throws from GatherPointStore::push_back
+    // on a worker thread. That must surface here as the exception, not terminate.
+    MaterialLibrary materials;
+    while (materials.size() <= 70000)
+    {
+        materials.add(std::make_shared<LambertianMaterial>("m" + std::to_string(materials.size())));
+    }
+    auto camera = std::make_shared<Camera>(48, 48, 60.0);
+    std::vector<std::shared_ptr<Object>> objects;
+    objects.push_back(std::make_shared<SphereVolume>(/*materialIndex=*/70000,
+                                                     Vector{0.0, 0.0, 50.0}, /*radius=*/20.0));
+
+    REQUIRE_THROWS_AS(ProbeGather::collectGatherPoints(objects, *camera, materials, nullptr,
+                                                       0.0f, 0.0f, 1, 1, 5, /*workerCount=*/4),
+                      std::runtime_error);
+}
+
+TEST_CASE("ProbeIndex reads GatherPointStore positions in place", "[ProbeGather][ProbeIndex][GatherPointStore]")
+{
+    // Two cameras' record stores indexed together without copying: a point near
+    // either camera's records is kept, a point away from both is culled.
+    ProbeGather::GatherPointStore first(8);
+    ProbeGather::GatherPointStore second(8);
+    ProbeGather::GatherPoint gp;
+    gp.normal = Vector{0.0, 1.0, 0.0};
+    gp.viewDir = Vector{0.0, 1.0, 0.0};
+    gp.position = Vector{0.0, 0.0, 0.0};
+    first.push_back(gp);
+    gp.position = Vector{100.0, 0.0, 0.0};
+    second.push_back(gp);
+
+    ProbeIndex index(std::vector<ProbePositions>{first.positions(), second.positions()}, 2.0, 2.0);
+    REQUIRE(index.probeCount() == 2);
+    REQUIRE(index.anyWithinKeepRadius(Vector{1.0, 0.0, 0.0}));
+    REQUIRE(index.anyWithinKeepRadius(Vector{101.0, 0.5, 0.0}));
+    REQUIRE_FALSE(index.anyWithinKeepRadius(Vector{50.0, 0.0, 0.0}));
+    REQUIRE(index.anyWithin(Vector{98.5, 0.0, 0.0}, 1.6));
+}
+
+TEST_CASE("ProbeIndex patch replaces only the changed sources", "[ProbeGather][ProbeIndex]")
+{
+    // Three sources (tiles); a later frame re-traced the middle one. The kept
+    // sources move to new storage with the same positions, the changed one holds
+    // new probes. The patched index must answer exactly like a fresh build.
+    RandomGenerator generator(11);
+    const auto cloud = [&generator](double centerX, size_t count) {
+        std::vector<float> x, y, z;
+        for (size_t i = 0; i < count; ++i)
+        {
+            x.push_back(static_cast<float>(centerX + generator.value(10.0)));
+            y.push_back(static_cast<float>(generator.value(10.0)));
+            z.push_back(static_cast<float>(generator.value(10.0)));
+        }
+        return std::array<std::vector<float>, 3>{x, y, z};
+    };
+    const auto view = [](const std::array<std::vector<float>, 3>& c) {
+        return ProbePositions{c[0].data(), c[1].data(), c[2].data(), c[0].size()};
+    };
+
+    const auto left = cloud(0.0, 200);
+    const auto oldMiddle = cloud(40.0, 150);
+    const auto right = cloud(80.0, 200);
+    ProbeIndex patched(std::vector<ProbePositions>{view(left), view(oldMiddle), view(right)}, 2.0, 2.0);
+
+    const auto leftCopy = left;
+    const auto newMiddle = cloud(55.0, 90);
+    const auto rightCopy = right;
+    patched.patch(std::vector<ProbePositions>{view(leftCopy), view(newMiddle), view(rightCopy)}, {1});
+
+    const ProbeIndex fresh(std::vector<ProbePositions>{view(leftCopy), view(newMiddle), view(rightCopy)}, 2.0, 2.0);
+    REQUIRE(patched.probeCount() == fresh.probeCount());
+    REQUIRE(patched.cellCount() == fresh.cellCount());
+    REQUIRE(patched.occupancyCellCount() == fresh.occupancyCellCount());
+    for (int i = 0; i < 4000; ++i)
+    {
+        const Vector p{generator.value(100.0) - 5.0, generator.value(20.0) - 5.0, generator.value(20.0) - 5.0};
+        INFO("p=(" << p.x << "," << p.y << "," << p.z << ")");
+        REQUIRE(patched.anyWithinKeepRadius(p) == fresh.anyWithinKeepRadius(p));
+        REQUIRE(patched.anyWithin(p, 1.0) == fresh.anyWithin(p, 1.0));
+    }
+
+    REQUIRE_THROWS_AS(patched.patch(std::vector<ProbePositions>{view(leftCopy)}, {}), std::runtime_error);
+}
+
 // ===== BounceStore: lock-free append + post-pass radius search =====
 
 TEST_CASE("BounceStore appends raw bounces and respects the capacity budget", "[ProbeGather][BounceStore]")
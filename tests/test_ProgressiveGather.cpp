@@ -0,0 +1,188 @@
+#include <catch2/catch_all.hpp>
+
+#include "BounceStore.h"
+#include "Buffer.h"
+#include "Camera.h"
+#include "LambertianMaterial.h"
+#include "MaterialLibrary.h"
+#include "ProbeGather.h"
+#include "RandomGenerator.h"
+#include "RenderFixture.h"
+
+#include <cmath>
+#include <memory>
+#include <string>
+
+// ============================================================================
+// Progressive (SPPM) gather
+// ============================================================================
+//
+// A progressive render folds each photon pass into per-record (count, radius,
+// flux) statistics and drops the pass's BounceStore. One pass must therefore be
+// the one-shot gather, the radius must follow the SPPM update, and several small
+// passes must converge on the brightness of one big pass while holding only one
+// small pass's deposits.
+
+namespace
+{
+struct FlatFixture
+{
+    std::shared_ptr<MaterialLibrary> materials = std::make_shared<MaterialLibrary>();
+    std::size_t matIndex = 0;
+    std::shared_ptr<Camera> camera;
+    ProbeGather::GatherPointStore points{24};
+
+    FlatFixture()
+    {
+        materials->add(std::make_shared<LambertianMaterial>("diffuse", Color{0.8f, 0.8f, 0.8f}));
+        matIndex = materials->indexForName("diffuse");
+        camera = std::make_shared<Camera>(24, 16, 60.0);
+
+        RandomGenerator random(5u);
+        for (size_t y = 0; y < 16; ++y)
+        {
+            for (size_t x = 0; x < 24; ++x)
+            {
+                for (int sample = 0; sample < 4; ++sample)
+                {
+                    ProbeGather::GatherPoint gp;
+                    gp.pixel = {x, y};
+                    gp.position = Vector{x + random.value(1.0), y + random.value(1.0), 0.0};
+                    gp.normal = Vector{0.0, 0.0, 1.0};
+                    gp.viewDir = Vector{0.0, 0.0, 1.0};
+                    gp.materialIndex = matIndex;
+                    gp.footprintRadius = 0.75;
+                    gp.sampleWeight = 0.25f;
+                    points.push_back(gp);
+                }
+            }
+        }
+    }
+};
+
+void fillStore(BounceStore& store, std::uint32_t seed, int count)
+{
+    RandomGenerator random(seed);
+    for (int i = 0; i < count; ++i)
+    {
+        store.append(RawBounce{Vector{random.value(24.0), random.value(16.0), 0.0},
+                               Vector{0.0, 0.0, -1.0}, Vector{0.0, 0.0, 1.0},
+                               RawBounce::kTimelessDeposit, Color{0.6f, 0.4f, 0.2f}});
+    }
+    store.buildIndex(1.0);
+}
+
+std::string progressiveScene(int passes, int photonsPerLight)
+{
+    return R"JSON({
+  "$materials": { "Matte": { "$type": "Diffuse", "$color": [0.7] } },
+  "$workerConfiguration": { "$workerCount": 1, "$fetchSize": 20000, "$photonQueueSize": 2000000 },
+  "$renderConfiguration": {
+    "$width": 32, "$height": 32, "$photonsPerLight": )JSON" +
+           std::to_string(photonsPerLight) + R"JSON(,
+    "$bounceThreshold": 2, "$terminationThreshold": 0.01,
+    "$deterministic": true, "$seed": 7, "$progressivePasses": )JSON" +
+           std::to_string(passes) + R"JSON(
+  },
+  "$scene": {
+    "Camera": { "$type": "Camera", "$verticalFieldOfView": 60.0,
+      "$position": [0.0, 0.0, -200.0],
+      "$rotation": { "$type": "PitchYawRollDegrees", "$value": [0.0, 0.0, 0.0] } },
+    "Light": { "$type": "OmniLight", "$position": [0.0, 80.0, -60.0],
+      "$color": [1.0, 1.0, 1.0], "$brightness": 50000 },
+    "Sphere": { "$type": "SphereVolume", "$material": "Matte",
+      "$center": [0.0, 0.0, 20.0], "$radius": 40.0 },
+    "BackWall": { "$type": "SphereVolume", "$material": "Matte",
+      "$center": [0.0, 0.0, 400.0], "$radius": 300.0 }
+  }
+})JSON";
+}
+}  // namespace
+
+TEST_CASE("Progressive gather: one pass reproduces the one-shot gather",
+          "[ProbeGather][progressive]")
+{
+    FlatFixture f;
+    BounceStore store(20000);
+    fillStore(store, 11u, 20000);
+
+    Buffer oneShot(24, 16);
+    Buffer progressive(24, 16);
+    ProbeGather::run(f.camera, f.points, store, *f.materials, 3, 0.0, oneShot);
+
+    ProbeGather::ProgressiveState state = ProbeGather::beginProgressive(f.points, 0.0);
+    ProbeGather::accumulateProgressive(f.points, store, *f.materials, 3, 0.0, 0.0f, 0.7, state);
+    ProbeGather::resolveProgressive(f.camera, f.points, state, progressive);
+
+    const double mean = rt_test::meanLuminance(oneShot, 24, 16);
+    REQUIRE(mean > 0.0);
+    const double error = rt_test::rmse(oneShot, progressive, 24, 16);
+    INFO("mean=" << mean << " rmse=" << error);
+    REQUIRE(error <= mean * 1e-5);
+}
+
+TEST_CASE("Progressive gather: radius and count follow the SPPM update",
+          "[ProbeGather][progressive]")
+{
+    FlatFixture f;
+    constexpr double kAlpha = 0.7;
+    ProbeGather::ProgressiveState state = ProbeGather::beginProgressive(f.points, 0.0);
+    REQUIRE(state.radius[0] == Catch::Approx(0.75));
+    REQUIRE(state.memoryBytes() >= f.points.size() * 20);
+
+    double expectedCount = 0.0;
+    double expectedRadius = 0.75;
+    for (std::uint32_t pass = 0; pass < 3; ++pass)
+    {
+        BounceStore store(20000);
+        fillStore(store, 100u + pass, 20000);
+
+        // The deposits record 0 sees this pass, at its current radius.
+        Hit hit;
+        hit.position = f.points[0].position;
+        hit.normal = f.points[0].normal;
+        hit.material = f.matIndex;
+        std::size_t found = 0;
+        ProbeGather::testing::gatherRadiance(store, *f.materials, hit,
+                                             f.materials->fetchByIndex(f.matIndex),
+                                             f.points[0].viewDir, expectedRadius, 0.0, 0.0f,
+                                             0.0f, found);
+        REQUIRE(found > 0);
+
+        ProbeGather::accumulateProgressive(f.points, store, *f.materials, 2, 0.0, 0.0f, kAlpha,
+                                           state);
+        const double m = static_cast<double>(found);
+        const double next = expectedCount + kAlpha * m;
+        expectedRadius *= std::sqrt(next / (expectedCount + m));
+        expectedCount = next;
+
+        REQUIRE(state.passes == pass + 1);
+        REQUIRE(state.count[0] == Catch::Approx(expectedCount).epsilon(1e-5));
+        REQUIRE(state.radius[0] == Catch::Approx(expectedRadius).epsilon(1e-5));
+    }
+    REQUIRE(expectedRadius < 0.75);
+}
+
+TEST_CASE("Progressive render: passes converge on one big pass with one pass's memory",
+          "[ProbeGather][progressive]")
+{
+    rt_test::RenderScene oneShot{progressiveScene(1, 200000)};
+    rt_test::RenderScene progressive{progressiveScene(4, 50000)};
+
+    REQUIRE(progressive.result.bounceStore);
+    REQUIRE(oneShot.result.bounceStore);
+    const std::size_t passDeposits = progressive.result.bounceStore->size();
+    const std::size_t allDeposits = oneShot.result.bounceStore->size();
+    INFO("progressive store=" << passDeposits << " one-shot store=" << allDeposits);
+    REQUIRE(passDeposits * 3 < allDeposits);
+
+    // Same photon total, so the same brightness up to noise on the sphere's face.
+    // (Near silhouettes the progressive image is BRIGHTER: its shrinking disc stops
+    // overhanging the edge, so it loses less energy than the one-shot disc.)
+    const double a = rt_test::regionMean(oneShot.buffer(), 12, 12, 19, 19);
+    const double b = rt_test::regionMean(progressive.buffer(), 12, 12, 19, 19);
+    INFO("one-shot centre=" << a << " progressive centre=" << b);
+    REQUIRE(a > 0.0);
+    REQUIRE(std::abs(b - a) <= 0.05 * a);
+    REQUIRE(progressive.meanLuminance() >= 0.95 * oneShot.meanLuminance());
+}
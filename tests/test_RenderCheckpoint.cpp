@@ -0,0 +1,150 @@
+#include <catch2/catch_all.hpp>
+
+#include "RenderCheckpoint.h"
+#include "RenderFixture.h"
+#include "Renderer.h"
+#include "SceneLoader.h"
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+// ============================================================================
+// Render checkpoint
+// ============================================================================
+//
+// A progressive frame checkpointed between passes must resume to the image the
+// uninterrupted frame renders — bit for bit in deterministic mode — and must
+// refuse a checkpoint that belongs to another render.
+
+namespace
+{
+std::string checkpointScene()
+{
+    return R"JSON({
+  "$materials": { "Matte": { "$type": "Diffuse", "$color": [0.7] } },
+  "$workerConfiguration": { "$workerCount": 1, "$fetchSize": 20000, "$photonQueueSize": 2000000 },
+  "$renderConfiguration": {
+    "$width": 32, "$height": 32, "$photonsPerLight": 20000,
+    "$bounceThreshold": 2, "$terminationThreshold": 0.01,
+    "$deterministic": true, "$seed": 7, "$progressivePasses": 4, "$checkpointPasses": 2
+  },
+  "$scene": {
+    "Camera": { "$type": "Camera", "$verticalFieldOfView": 60.0,
+      "$position": [0.0, 0.0, -200.0],
+      "$rotation": { "$type": "PitchYawRollDegrees", "$value": [0.0, 0.0, 0.0] } },
+    "Light": { "$type": "OmniLight", "$position": [0.0, 80.0, -60.0],
+      "$color": [1.0, 1.0, 1.0], "$brightness": 50000 },
+    "Sphere": { "$type": "SphereVolume", "$material": "Matte",
+      "$center": [0.0, 0.0, 20.0], "$radius": 40.0 },
+    "BackWall": { "$type": "SphereVolume", "$material": "Matte",
+      "$center": [0.0, 0.0, 400.0], "$radius": 300.0 }
+  }
+})JSON";
+}
+
+LoadedScene loadScene(const std::string& json)
+{
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "rt_render_checkpoint_scene.json";
+    {
+        std::ofstream out(path);
+        out << json;
+    }
+    LoadedScene scene = SceneLoader::loadFromFile(path.string(), /*logToStdout=*/false);
+    std::filesystem::remove(path);
+    return scene;
+}
+}  // namespace
+
+TEST_CASE("Render checkpoint render: a resumed frame ends on the uninterrupted image",
+          "[checkpoint][progressive][render]")
+{
+    LoadedScene scene = loadScene(checkpointScene());
+    REQUIRE(scene.settings.checkpointPasses == 2);
+    const RenderResult reference = Renderer::renderFrame(scene);  // no path: no checkpoint
+
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "rt_render_checkpoint.checkpoint";
+    std::filesystem::remove(path);
+    scene.settings.checkpointPath = path;
+
+    // Checkpointing does not change the frame; it leaves the state after pass 2
+    // of 4 (not after the last pass: the frame is done then).
+    const RenderResult checkpointed = Renderer::renderFrame(scene);
+    REQUIRE(rt_test::buffersBitwiseEqual(*checkpointed.buffer, *reference.buffer, 32, 32));
+    REQUIRE(std::filesystem::exists(path));
+    const RenderCheckpoint saved = RenderCheckpoint::read(path);
+    REQUIRE(saved.passesDone == 2);
+    REQUIRE(saved.photonsEmitted == 2 * 20000);
+    REQUIRE(saved.views.size() == 1);
+    REQUIRE(saved.views[0].state.radius.size() == saved.views[0].records);
+
+    // Resumed, the frame runs passes 3 and 4 only.
+    scene.settings.resumeFromCheckpoint = true;
+    const RenderResult resumed = Renderer::renderFrame(scene);
+    REQUIRE(resumed.resumedPasses == 2);
+    REQUIRE(resumed.photonsEmitted == reference.photonsEmitted);
+    REQUIRE(rt_test::buffersBitwiseEqual(*resumed.buffer, *reference.buffer, 32, 32));
+
+    // Another seed traces other records and photons: its checkpoint does not apply.
+    scene.settings.seed = 8;
+    REQUIRE_THROWS_AS(Renderer::renderFrame(scene), std::runtime_error);
+    std::filesystem::remove(path);
+
+    // Without a seed the probe records are not reproducible, so nothing to resume.
+    scene.settings.seed = RenderSettings::kUnseeded;
+    scene.settings.deterministic = false;
+    REQUIRE_THROWS_AS(Renderer::renderFrame(scene), std::runtime_error);
+}
+
+TEST_CASE("Render checkpoint: a checkpoint round-trips and junk is refused", "[checkpoint]")
+{
+    RenderCheckpoint checkpoint;
+    checkpoint.frameTime = 0.5;
+    checkpoint.photonsPerLight = 1000;
+    checkpoint.progressivePasses = 8;
+    checkpoint.progressiveAlpha = 0.7;
+    checkpoint.seed = 3;
+    checkpoint.passesDone = 5;
+    checkpoint.photonsEmitted = 5000;
+    checkpoint.droppedDeposits = 2;
+    checkpoint.attemptedDeposits = 900;
+    RenderCheckpoint::View view;
+    view.records = 2;
+    view.deposits = 40;
+    view.state.radius = {1.5f, 2.5f};
+    view.state.count = {3.0f, 4.0f};
+    view.state.flux = {Color{0.1f, 0.2f, 0.3f}, Color{0.4f, 0.5f, 0.6f}};
+    checkpoint.views.push_back(view);
+
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "rt_render_checkpoint_roundtrip.checkpoint";
+    checkpoint.write(path);
+    const RenderCheckpoint back = RenderCheckpoint::read(path);
+    REQUIRE(back.sameRender(checkpoint));
+    REQUIRE(back.passesDone == 5);
+    REQUIRE(back.photonsEmitted == 5000);
+    REQUIRE(back.droppedDeposits == 2);
+    REQUIRE(back.attemptedDeposits == 900);
+    REQUIRE(back.views[0].deposits == 40);
+    REQUIRE(back.views[0].state.passes == 5);
+    REQUIRE(back.views[0].state.radius == view.state.radius);
+    REQUIRE(back.views[0].state.count == view.state.count);
+    REQUIRE(back.views[0].state.flux[1].green == 0.5f);
+
+    RenderCheckpoint otherFrame = checkpoint;
+    otherFrame.frameTime = 1.0;
+    REQUIRE_FALSE(back.sameRender(otherFrame));
+    RenderCheckpoint otherRecords = checkpoint;
+    otherRecords.views[0].records = 3;
+    REQUIRE_FALSE(back.sameRender(otherRecords));
+
+    {
+        std::ofstream out(path, std::ios::trunc);
+        out << "not a checkpoint";
+    }
+    REQUIRE_THROWS_AS(RenderCheckpoint::read(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,174 @@
+#include <catch2/catch_all.hpp>
+
+#include "BounceStore.h"
+#include "Color.h"
+#include "LightQueue.h"
+#include "Photon.h"
+#include "RenderFixture.h"
+#include "Renderer.h"
+#include "SceneLoader.h"
+#include "Vector.h"
+#include "WorkQueue.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// Render context
+// ============================================================================
+//
+// A RenderContext carries a frame's photon queue, light queue, bounce store and
+// splat buffers over to the next frame, which resets them in place. A reset must
+// leave each one as good as new — the frames render bit for bit as with fresh
+// allocations — and a frame must never reuse an allocation an earlier frame's
+// result still holds.
+
+namespace
+{
+std::string contextScene()
+{
+    return R"JSON({
+  "$materials": { "Matte": { "$type": "Diffuse", "$color": [0.7] } },
+  "$workerConfiguration": { "$workerCount": 2, "$fetchSize": 20000, "$photonQueueSize": 2000000 },
+  "$renderConfiguration": {
+    "$width": 40, "$height": 40, "$photonsPerLight": 100000,
+    "$bounceThreshold": 2, "$terminationThreshold": 0.01,
+    "$deterministic": true, "$seed": 5
+  },
+  "$scene": {
+    "Camera": { "$type": "Camera", "$verticalFieldOfView": 60.0,
+      "$position": [0.0, 0.0, -200.0],
+      "$rotation": { "$type": "PitchYawRollDegrees", "$value": [0.0, 0.0, 0.0] } },
+    "Light": { "$type": "OmniLight", "$position": [0.0, 0.0, -130.0],
+      "$color": [1.0, 1.0, 1.0], "$brightness": 300000 },
+    "Mover": { "$type": "SphereVolume", "$material": "Matte",
+      "$center": [-30.0, 0.0, -30.0], "$radius": 26.0,
+      "$animation": { "$position": [
+        { "t": 0.0, "value": [-30.0, 0.0, -30.0] },
+        { "t": 1.0, "value": [ 30.0, 0.0, -30.0] } ] } },
+    "BackWall": { "$type": "SphereVolume", "$material": "Matte",
+      "$center": [0.0, 0.0, 500.0], "$radius": 380.0 }
+  }
+})JSON";
+}
+
+LoadedScene loadScene(const std::string& json)
+{
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "rt_render_context_scene.json";
+    {
+        std::ofstream out(path);
+        out << json;
+    }
+    LoadedScene scene = SceneLoader::loadFromFile(path.string(), /*logToStdout=*/false);
+    std::filesystem::remove(path);
+    return scene;
+}
+}  // namespace
+
+TEST_CASE("Render context: a reset bounce store starts over in its committed segments",
+          "[BounceStore][context]")
+{
+    BounceStore store(BounceStore::kSegmentRecords * 2);
+    const Color power{1.0f, 1.0f, 1.0f};
+    for (std::size_t i = 0; i < BounceStore::kSegmentRecords + 10; ++i)
+    {
+        store.append(RawBounce{Vector{static_cast<double>(i % 7), 0.0, 0.0}, Vector{0.0, 0.0, 1.0},
+                               Vector{0.0, 0.0, -1.0}, RawBounce::kTimelessDeposit, power});
+    }
+    store.buildIndex(/*cellSize=*/1.0, /*timeSlices=*/2);
+    REQUIRE(store.committedSegments() == 2);
+
+    store.reset();
+    REQUIRE(store.size() == 0);
+    REQUIRE(store.attemptedCount() == 0);
+    REQUIRE(store.timeBins() == 1);
+    REQUIRE(store.committedSegments() == 2);  // kept, not freed
+    REQUIRE(store.radiusSearch(Vector{0.0, 0.0, 0.0}, 10.0).empty());
+
+    store.append(RawBounce{Vector{0.5, 0.5, 0.5}, Vector{0.0, 0.0, 1.0}, Vector{0.0, 0.0, -1.0},
+                           RawBounce::kTimelessDeposit, power});
+    store.buildIndex(/*cellSize=*/1.0);
+    REQUIRE(store.size() == 1);
+    REQUIRE(store.radiusSearch(Vector{0.0, 0.0, 0.0}, 1.0).size() == 1);
+    REQUIRE(store.committedSegments() == 2);
+}
+
+TEST_CASE("Render context: reset queues start empty", "[context]")
+{
+    WorkQueue<Photon> queue(100);
+    queue.ready(queue.initialize(40));
+    queue.fetch(10);  // fetched and never released, as by an aborted pass
+    queue.reset();
+    REQUIRE(queue.allocated() == 0);
+    REQUIRE(queue.available() == 0);
+    REQUIRE(queue.largestAllocated() == 0);
+    REQUIRE(queue.initialize(100).size() == 100);
+
+    LightQueue lights;
+    lights.registerLight("a", 50, 1.0);
+    lights.reset();
+    REQUIRE(lights.remainingPhotons() == 0);
+    REQUIRE(lights.fetchPhotons("a", 10) == 0);
+}
+
+TEST_CASE("Render context render: reused allocations render the same frames",
+          "[context][render]")
+{
+    LoadedScene scene = loadScene(contextScene());
+    const std::vector<double> times{0.0, 0.25, 0.5};
+
+    std::vector<RenderResult> reference;
+    for (const double time : times)
+    {
+        scene.settings.frameTime = time;
+        reference.push_back(Renderer::renderFrame(scene));
+    }
+    REQUIRE(reference.front().bounceStore);
+
+    // Results dropped between frames: after the first frame every allocation (light
+    // queue, photon queue, splat buffer, bounce store) is reused.
+    {
+        RenderContext context;
+        for (std::size_t i = 0; i < times.size(); ++i)
+        {
+            scene.settings.frameTime = times[i];
+            const RenderResult result = Renderer::renderFrame(scene, nullptr, nullptr, nullptr, &context);
+            INFO("frame " << i);
+            REQUIRE(rt_test::buffersBitwiseEqual(*result.buffer, *reference[i].buffer, 40, 40));
+        }
+        REQUIRE(context.allocated == 4);
+        REQUIRE(context.reused == 8);
+        REQUIRE(context.bounceStores.size() == 1);
+    }
+
+    // Results kept: each frame's buffer and store stay with its result, so later
+    // frames allocate their own and the kept images are untouched.
+    {
+        RenderContext context;
+        std::vector<RenderResult> kept;
+        for (const double time : times)
+        {
+            scene.settings.frameTime = time;
+            kept.push_back(Renderer::renderFrame(scene, nullptr, nullptr, nullptr, &context));
+        }
+        REQUIRE(context.allocated == 8);
+        REQUIRE(context.reused == 4);
+        for (std::size_t i = 0; i < times.size(); ++i)
+        {
+            INFO("frame " << i);
+            REQUIRE(rt_test::buffersBitwiseEqual(*kept[i].buffer, *reference[i].buffer, 40, 40));
+        }
+
+        // Once they are released the pool shrinks back to one of each.
+        kept.clear();
+        scene.settings.frameTime = times.front();
+        const RenderResult again = Renderer::renderFrame(scene, nullptr, nullptr, nullptr, &context);
+        REQUIRE(rt_test::buffersBitwiseEqual(*again.buffer, *reference.front().buffer, 40, 40));
+        REQUIRE(context.allocated == 8);
+        REQUIRE(context.bounceStores.size() == 1);
+        REQUIRE(context.splatBuffers.front().size() == 1);
+    }
+}
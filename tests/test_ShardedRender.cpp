@@ -0,0 +1,157 @@
+#include <catch2/catch_all.hpp>
+
+#include "PartialFrame.h"
+#include "RenderFixture.h"
+#include "Renderer.h"
+#include "SceneLoader.h"
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// Sharded render
+// ============================================================================
+//
+// Shard i of N emits its own range of each light's photons at the whole frame's
+// per-photon flux, so the shards' pre-tonemap buffers sum to one render of all
+// the photons. The merged image must match the unsharded render as closely as
+// another seed of it does, and a partial frame must survive the disk round trip
+// and refuse to merge with the wrong company.
+
+namespace
+{
+std::string shardScene()
+{
+    return R"JSON({
+  "$materials": { "Matte": { "$type": "Diffuse", "$color": [0.7] } },
+  "$workerConfiguration": { "$workerCount": 2, "$fetchSize": 20000, "$photonQueueSize": 2000000 },
+  "$renderConfiguration": {
+    "$width": 40, "$height": 40, "$photonsPerLight": 120000,
+    "$bounceThreshold": 2, "$terminationThreshold": 0.01,
+    "$deterministic": true, "$seed": 11
+  },
+  "$scene": {
+    "Camera": { "$type": "Camera", "$verticalFieldOfView": 60.0,
+      "$position": [0.0, 0.0, -200.0],
+      "$rotation": { "$type": "PitchYawRollDegrees", "$value": [0.0, 0.0, 0.0] } },
+    "Light": { "$type": "OmniLight", "$position": [0.0, 0.0, -130.0],
+      "$color": [1.0, 1.0, 1.0], "$brightness": 300000 },
+    "Ball": { "$type": "SphereVolume", "$material": "Matte",
+      "$center": [0.0, 0.0, -30.0], "$radius": 30.0 },
+    "BackWall": { "$type": "SphereVolume", "$material": "Matte",
+      "$center": [0.0, 0.0, 500.0], "$radius": 380.0 }
+  }
+})JSON";
+}
+
+LoadedScene loadScene(const std::string& json)
+{
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "rt_sharded_render_scene.json";
+    {
+        std::ofstream out(path);
+        out << json;
+    }
+    LoadedScene scene = SceneLoader::loadFromFile(path.string(), /*logToStdout=*/false);
+    std::filesystem::remove(path);
+    return scene;
+}
+
+PartialFrame renderShard(LoadedScene& scene, size_t index, size_t count)
+{
+    scene.settings.shardIndex = index;
+    scene.settings.shardCount = count;
+    const RenderResult result = Renderer::renderFrame(scene);
+    return PartialFrame::fromRender(result, scene.settings, /*frame=*/0);
+}
+}  // namespace
+
+TEST_CASE("Sharded render: merged shards match the unsharded render", "[shard][render]")
+{
+    LoadedScene scene = loadScene(shardScene());
+    const RenderResult full = Renderer::renderFrame(scene);
+    REQUIRE(full.photonsEmitted == 120000);
+
+    // One shard of one is the unsharded render itself.
+    const PartialFrame single = renderShard(scene, 0, 1);
+    REQUIRE(rt_test::buffersBitwiseEqual(*single.buffer(0), *full.buffer, 40, 40));
+
+    std::vector<PartialFrame> shards;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        shards.push_back(renderShard(scene, i, 3));
+    }
+    REQUIRE(shards[0].photonsEmitted + shards[1].photonsEmitted + shards[2].photonsEmitted ==
+            full.photonsEmitted);
+    const PartialFrame merged = PartialFrame::merge(shards);
+    REQUIRE(merged.photonsEmitted == full.photonsEmitted);
+    const std::shared_ptr<Buffer> mergedBuffer = merged.buffer(0);
+
+    // The noise floor: the same render with another seed.
+    scene.settings.shardIndex = 0;
+    scene.settings.shardCount = 1;
+    scene.settings.seed = 12;
+    const RenderResult reseeded = Renderer::renderFrame(scene);
+
+    const double fullMean = rt_test::meanLuminance(*full.buffer, 40, 40);
+    REQUIRE(fullMean > 0.0);
+    REQUIRE(rt_test::meanLuminance(*mergedBuffer, 40, 40) == Catch::Approx(fullMean).epsilon(0.05));
+    const double seedNoise = rt_test::rmse(*full.buffer, *reseeded.buffer, 40, 40);
+    REQUIRE(rt_test::rmse(*mergedBuffer, *full.buffer, 40, 40) <= 2.0 * seedNoise);
+}
+
+TEST_CASE("Sharded render: partial frames round-trip and merge only a complete set",
+          "[shard]")
+{
+    PartialFrame part;
+    part.frame = 7;
+    part.shardIndex = 1;
+    part.shardCount = 2;
+    part.photonsPerLight = 1000;
+    part.photonsEmitted = 500;
+    part.views.push_back(PartialFrame::View{"main", 2, 1, 4.0, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f}});
+
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "rt_sharded_render.rtpart";
+    part.write(path);
+    const PartialFrame back = PartialFrame::read(path);
+    std::filesystem::remove(path);
+    REQUIRE(back.frame == 7);
+    REQUIRE(back.shardIndex == 1);
+    REQUIRE(back.shardCount == 2);
+    REQUIRE(back.photonsPerLight == 1000);
+    REQUIRE(back.photonsEmitted == 500);
+    REQUIRE(back.views.size() == 1);
+    REQUIRE(back.views[0].name == "main");
+    REQUIRE(back.views[0].saturationLuminance == 4.0);
+    REQUIRE(back.views[0].radiance == part.views[0].radiance);
+
+    PartialFrame other = part;
+    other.shardIndex = 0;
+    const PartialFrame whole = PartialFrame::merge({part, other});
+    REQUIRE(whole.shardCount == 1);
+    REQUIRE(whole.photonsEmitted == 1000);
+    REQUIRE(whole.views[0].radiance == std::vector<float>{2.f, 4.f, 6.f, 8.f, 10.f, 12.f});
+
+    REQUIRE_THROWS_AS(PartialFrame::merge({part}), std::runtime_error);        // shard 0 missing
+    REQUIRE_THROWS_AS(PartialFrame::merge({part, part}), std::runtime_error);  // shard 1 twice
+    PartialFrame otherFrame = other;
+    otherFrame.frame = 8;
+    REQUIRE_THROWS_AS(PartialFrame::merge({part, otherFrame}), std::runtime_error);
+    PartialFrame otherSize = other;
+    otherSize.views[0].width = 1;
+    otherSize.views[0].height = 2;
+    REQUIRE_THROWS_AS(PartialFrame::merge({part, otherSize}), std::runtime_error);
+
+    const std::filesystem::path junk =
+        std::filesystem::temp_directory_path() / "rt_sharded_render_junk.rtpart";
+    {
+        std::ofstream out(junk);
+        out << "not a partial frame";
+    }
+    REQUIRE_THROWS_AS(PartialFrame::read(junk), std::runtime_error);
+    std::filesystem::remove(junk);
+}
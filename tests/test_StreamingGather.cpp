@@ -0,0 +1,204 @@
+#include <catch2/catch_all.hpp>
+
+#include "BounceStore.h"
+#include "Buffer.h"
+#include "Camera.h"
+#include "LambertianMaterial.h"
+#include "MaterialLibrary.h"
+#include "MicrofacetMaterial.h"
+#include "ProbeGather.h"
+#include "ProbeIndex.h"
+#include "RandomGenerator.h"
+#include "RenderFixture.h"
+#include "StreamingGather.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// Streaming gather
+// ============================================================================
+//
+// On a matte view the photon pass can sum each record's deposits directly instead
+// of storing them for the gather. The sums must give the one-shot gather's image,
+// and a view the sums cannot represent (a record on a glossy surface, whose BRDF
+// depends on each deposit's direction) must fall back to the BounceStore. Mirrors
+// do not block it: the records lie past them, on whatever matte surface they show.
+
+namespace
+{
+struct MatteFixture
+{
+    std::shared_ptr<MaterialLibrary> materials = std::make_shared<MaterialLibrary>();
+    std::size_t matIndex = 0;
+    std::shared_ptr<Camera> camera;
+    ProbeGather::GatherPointStore points{24};
+
+    MatteFixture()
+    {
+        materials->add(std::make_shared<LambertianMaterial>("diffuse", Color{0.8f, 0.6f, 0.4f}));
+        matIndex = materials->indexForName("diffuse");
+        camera = std::make_shared<Camera>(24, 16, 60.0);
+
+        RandomGenerator random(9u);
+        for (size_t y = 0; y < 16; ++y)
+        {
+            for (size_t x = 0; x < 24; ++x)
+            {
+                for (int sample = 0; sample < 2; ++sample)
+                {
+                    // A floor and, past x = 16, a wall standing on it: the wall's
+                    // records see floor deposits in their sphere, which the normal
+                    // test must reject in both gathers.
+                    ProbeGather::GatherPoint gp;
+                    gp.pixel = {x, y};
+                    const double u = x + random.value(1.0);
+                    const double v = y + random.value(1.0);
+                    const bool wall = x >= 16;
+                    gp.position = wall ? Vector{16.0, v, u - 16.0} : Vector{u, v, 0.0};
+                    gp.normal = wall ? Vector{-1.0, 0.0, 0.0} : Vector{0.0, 0.0, 1.0};
+                    gp.viewDir = wall ? Vector{-0.6, 0.0, 0.8} : Vector{0.0, 0.6, 0.8};
+                    gp.materialIndex = matIndex;
+                    gp.footprintRadius = 0.5 + 0.5 * random.value(1.0);
+                    gp.specularThroughput = Color{1.0f, 0.9f, 0.8f};
+                    gp.sampleWeight = 0.5f;
+                    points.push_back(gp);
+                }
+            }
+        }
+    }
+};
+
+std::vector<RawBounce> randomDeposits(std::uint32_t seed, int count)
+{
+    std::vector<RawBounce> deposits;
+    RandomGenerator random(seed);
+    for (int i = 0; i < count; ++i)
+    {
+        const bool wall = (i % 4 == 0);
+        const Vector position = wall ? Vector{16.0, random.value(16.0), random.value(8.0)}
+                                     : Vector{random.value(24.0), random.value(16.0), 0.0};
+        const Vector normal = wall ? Vector{-1.0, 0.0, 0.0} : Vector{0.0, 0.0, 1.0};
+        // Mostly downward-travelling photons; a few arrive from below the floor.
+        const Vector incoming =
+            wall ? Vector{0.7, 0.0, -0.7}
+                 : Vector{random.value(0.4) - 0.2, random.value(0.4) - 0.2, (i % 10 == 0) ? 1.0 : -1.0};
+        deposits.emplace_back(position, incoming, normal, RawBounce::kTimelessDeposit,
+                              Color{0.6f, 0.4f, 0.2f});
+    }
+    return deposits;
+}
+
+std::string matteScene(bool streaming, bool glossy)
+{
+    return R"JSON({
+  "$materials": {
+    "Matte": { "$type": "Diffuse", "$color": [0.7] },
+    "Glossy": { "$type": "Microfacet", "$color": [0.7], "$roughness": 0.3 }
+  },
+  "$workerConfiguration": { "$workerCount": 1, "$fetchSize": 20000, "$photonQueueSize": 2000000 },
+  "$renderConfiguration": {
+    "$width": 32, "$height": 32, "$photonsPerLight": 100000,
+    "$bounceThreshold": 2, "$terminationThreshold": 0.01,
+    "$deterministic": true, "$seed": 7, "$streamingGather": )JSON" +
+           std::string(streaming ? "true" : "false") + R"JSON(
+  },
+  "$scene": {
+    "Camera": { "$type": "Camera", "$verticalFieldOfView": 60.0,
+      "$position": [0.0, 0.0, -200.0],
+      "$rotation": { "$type": "PitchYawRollDegrees", "$value": [0.0, 0.0, 0.0] } },
+    "Light": { "$type": "OmniLight", "$position": [0.0, 80.0, -60.0],
+      "$color": [1.0, 1.0, 1.0], "$brightness": 50000 },
+    "Sphere": { "$type": "SphereVolume", "$material": ")JSON" +
+           std::string(glossy ? "Glossy" : "Matte") + R"JSON(",
+      "$center": [0.0, 0.0, 20.0], "$radius": 40.0 },
+    "BackWall": { "$type": "SphereVolume", "$material": "Matte",
+      "$center": [0.0, 0.0, 400.0], "$radius": 300.0 }
+  }
+})JSON";
+}
+}  // namespace
+
+TEST_CASE("Streaming gather: record sums reproduce the one-shot gather",
+          "[ProbeGather][streaming]")
+{
+    MatteFixture f;
+    REQUIRE(StreamingGather::supports(f.points, *f.materials));
+
+    const std::vector<RawBounce> deposits = randomDeposits(21u, 30000);
+    BounceStore store(deposits.size());
+    for (const RawBounce& deposit : deposits)
+    {
+        store.append(deposit);
+    }
+    store.buildIndex(1.0);
+    Buffer oneShot(24, 16);
+    ProbeGather::run(f.camera, f.points, store, *f.materials, 2, 0.6, oneShot);
+
+    // Two sources over the one camera's records, as the frame cache splits them.
+    const std::size_t half = f.points.size() / 2;
+    ProbeIndex index({f.points.positions(0, half), f.points.positions(half, f.points.size())},
+                     1.0, 1.0);
+    StreamingGather streaming({&f.points}, {{&f.points, 0, 0}, {&f.points, half, 0}}, index,
+                              0.6, 0.0f);
+    std::vector<ProbeIndex::ProbeRef> scratch;
+    for (const RawBounce& deposit : deposits)
+    {
+        streaming.deposit(deposit, scratch);
+    }
+    REQUIRE(streaming.depositCount() > 0);
+    Buffer streamed(24, 16);
+    const ProbeGather::Result result = streaming.resolve(0, f.camera, *f.materials, streamed);
+    REQUIRE(result.pixelsGathered > 0);
+
+    const double mean = rt_test::meanLuminance(oneShot, 24, 16);
+    REQUIRE(mean > 0.0);
+    const double error = rt_test::rmse(oneShot, streamed, 24, 16);
+    INFO("mean=" << mean << " rmse=" << error);
+    REQUIRE(error <= mean * 1e-4);
+}
+
+TEST_CASE("Streaming gather: a non-Lambertian record is not supported",
+          "[ProbeGather][streaming]")
+{
+    MatteFixture f;
+    f.materials->add(std::make_shared<MicrofacetMaterial>("glossy"));
+    ProbeGather::GatherPoint gp = f.points[0];
+    gp.materialIndex = f.materials->indexForName("glossy");
+    f.points.push_back(gp);
+    REQUIRE_FALSE(StreamingGather::supports(f.points, *f.materials));
+
+    // Emitter faces gather with f = 1 and stream like matte records.
+    ProbeGather::GatherPointStore emitters(24);
+    gp.materialIndex = ProbeGather::testing::kEmitterMaterial;
+    emitters.push_back(gp);
+    REQUIRE(StreamingGather::supports(emitters, *f.materials));
+}
+
+TEST_CASE("Streaming render: matches the BounceStore render without a store",
+          "[ProbeGather][streaming]")
+{
+    rt_test::RenderScene stored{matteScene(false, false)};
+    rt_test::RenderScene streamed{matteScene(true, false)};
+
+    REQUIRE_FALSE(stored.result.streamedGather);
+    REQUIRE(streamed.result.streamedGather);
+    REQUIRE_FALSE(streamed.result.bounceStore);
+    REQUIRE(streamed.result.streamingGatherBytes > 0);
+
+    const double mean = stored.meanLuminance();
+    REQUIRE(mean > 0.0);
+    const double error = rt_test::rmse(stored.buffer(), streamed.buffer(), 32, 32);
+    INFO("mean=" << mean << " rmse=" << error);
+    REQUIRE(error <= mean * 1e-4);
+}
+
+TEST_CASE("Streaming render: a glossy surface in view falls back to the BounceStore",
+          "[ProbeGather][streaming]")
+{
+    rt_test::RenderScene render{matteScene(true, true)};
+    REQUIRE_FALSE(render.result.streamedGather);
+    REQUIRE(render.result.bounceStore);
+    REQUIRE(render.meanLuminance() > 0.0);
+}
@@ -0,0 +1,144 @@
+#include <catch2/catch_all.hpp>
+
+#include "Buffer.h"
+#include "Color.h"
+#include "Image.h"
+#include "Renderer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+// ============================================================================
+// Tonemap
+// ============================================================================
+//
+// The tonemap settles each channel's 16-bit code against a threshold table
+// instead of calling powf. The image must still be the one the powf formula
+// gives, code for code — most of all right at the steps, where a rounding slip
+// would show — and must not depend on how many threads split the rows.
+
+namespace
+{
+// The formula the tonemap stood on: min(int(powf(v, 1/gamma) * 65535), 65535),
+// with v <= 0 (and NaN) at 0 and v >= 1 at full scale.
+int powCode(float exposed)
+{
+    if (!(exposed > 0.0f))
+    {
+        return 0;
+    }
+    if (exposed >= 1.0f)
+    {
+        return 65535;
+    }
+    const float encoded = std::pow(exposed, 1.0f / Color::gamma);
+    return std::min(static_cast<int>(encoded * 65535), 65535);
+}
+
+// Fill `buffer` with `values`, three to a pixel, in row-major order.
+void fill(Buffer& buffer, const std::vector<float>& values)
+{
+    for (std::size_t i = 0; i + 2 < values.size(); i += 3)
+    {
+        const std::size_t pixel = i / 3;
+        buffer.addColor({pixel % buffer.width(), pixel / buffer.width()},
+                        Color{values[i], values[i + 1], values[i + 2]});
+    }
+}
+
+// Channel `c` of the image pixel holding buffer pixel (x, y).
+int imageCode(Image& image, std::size_t x, std::size_t y, std::size_t c)
+{
+    return image.getPixel(image.width() - 1 - x, image.height() - 1 - y)[c];
+}
+}  // namespace
+
+TEST_CASE("Tonemap: every code matches the powf curve, at and around its steps", "[tonemap]")
+{
+    // Around each of the 65536 steps: the value nearest (k / 65535)^gamma and
+    // the floats two either side of it. Then a log sweep and the edge cases.
+    std::vector<float> values;
+    for (int k = 0; k <= 65535; ++k)
+    {
+        float v = static_cast<float>(std::pow(k / 65535.0, static_cast<double>(Color::gamma)));
+        v = std::nextafter(std::nextafter(v, 0.0f), 0.0f);
+        for (int step = 0; step < 5; ++step)
+        {
+            values.push_back(v);
+            v = std::nextafter(v, 2.0f);
+        }
+    }
+    for (double v = 1e-14; v < 4.0; v *= 1.0001)
+    {
+        values.push_back(static_cast<float>(v));
+    }
+    for (const float v : {0.0f, -0.0f, -1.0f, 1.0f, 1.5f, 3e12f, std::numeric_limits<float>::min(),
+                          std::numeric_limits<float>::denorm_min(),
+                          std::nextafter(1.0f, 0.0f), std::numeric_limits<float>::infinity(),
+                          std::numeric_limits<float>::quiet_NaN()})
+    {
+        values.push_back(v);
+    }
+    while (values.size() % 3 != 0)
+    {
+        values.push_back(0.5f);
+    }
+
+    const std::size_t width = 512;
+    const std::size_t height = (values.size() / 3 + width - 1) / width;
+    Buffer buffer(width, height);
+    fill(buffer, values);
+    Image image(width, height);
+    // L_max = 1: the exposed value is the buffer value.
+    Renderer::tonemapBufferToImage(buffer, image, 1.0, 1.0, 4);
+
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        const std::size_t pixel = i / 3;
+        const int got = imageCode(image, pixel % width, pixel / width, i % 3);
+        if (got != powCode(values[i]))
+        {
+            UNSCOPED_INFO("value " << values[i] << " code " << got << " expected "
+                                   << powCode(values[i]));
+            ++mismatches;
+        }
+    }
+    REQUIRE(mismatches == 0);
+}
+
+TEST_CASE("Tonemap: the image does not depend on the thread count", "[tonemap]")
+{
+    const std::size_t width = 97;
+    const std::size_t height = 203;
+    Buffer buffer(width, height);
+    for (std::size_t y = 0; y < height; ++y)
+    {
+        for (std::size_t x = 0; x < width; ++x)
+        {
+            const float v = static_cast<float>(x * x + 3 * y) * 0.37f;
+            buffer.addColor({x, y}, Color{v, 2000.0f - v, v * 0.01f});
+        }
+    }
+
+    Image serial(width, height);
+    Renderer::tonemapBufferToImage(buffer, serial, 1.0, 1500.0, 1);
+    for (const std::size_t workers : {2, 3, 8, 64})
+    {
+        Image parallel(width, height);
+        Renderer::tonemapBufferToImage(buffer, parallel, 1.0, 1500.0, workers);
+        for (std::size_t y = 0; y < height; ++y)
+        {
+            for (std::size_t x = 0; x < width; ++x)
+            {
+                for (std::size_t c = 0; c < 3; ++c)
+                {
+                    REQUIRE(parallel.getPixel(x, y)[c] == serial.getPixel(x, y)[c]);
+                }
+            }
+        }
+    }
+}